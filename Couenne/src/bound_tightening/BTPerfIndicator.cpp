@@ -17,7 +17,7 @@
 using namespace Couenne;
 
 /// 
-void CouenneBTPerfIndicator::update (const CouNumber *lb, const CouNumber *ub, int depth) const {
+void CouenneBTPerfIndicator::update (const CouNumber *lb, const CouNumber *ub, int depth, bool infeasible) const {
 
   assert (oldLB_ != NULL && 
 	  oldUB_ != NULL);
@@ -38,6 +38,11 @@ void CouenneBTPerfIndicator::update (const CouNumber *lb, const CouNumber *ub, i
 
   CouNumber *optimum = problem_ -> bestSol ();
 
+  if (infeasible)
+    nPrInf = 1;
+
+  else
+
   for (int i=0; i<problem_ -> nVars (); ++i) {
 
     CouNumber 
@@ -135,6 +140,9 @@ void CouenneBTPerfIndicator::update (const CouNumber *lb, const CouNumber *ub, i
 
   weightSum_ = newWS;
 
+  lastDepth_ = depth;
+  lastGain_  = nPrInf ? (double) problem_ -> nVars () : nFixed + nShr + nShrDbl + ratio;
+
   delete [] oldLB_;
   delete [] oldUB_;
 
@@ -16,7 +16,7 @@
 using namespace Couenne;
 
 ///
-CouenneBTPerfIndicator::CouenneBTPerfIndicator (CouenneProblem *p, const std::string &name):
+CouenneBTPerfIndicator::CouenneBTPerfIndicator (CouenneProblem *p, const std::string &name, bool quiet):
 
   name_            (name),
   nFixed_          (0.),
@@ -32,7 +32,19 @@ CouenneBTPerfIndicator::CouenneBTPerfIndicator (CouenneProblem *p, const std::st
   problem_         (p),
   stats_           ((p             != NULL) && 
 		    (GetRawPtr (p -> Jnlst ()) != NULL) && 
-		    (p -> Jnlst () -> ProduceOutput (Ipopt::J_ERROR, J_COUENNE))) {}
+		    (p -> Jnlst () -> ProduceOutput (Ipopt::J_ERROR, J_COUENNE))),
+  quiet_           (quiet &&
+		    !(stats_ && p -> Jnlst () -> ProduceOutput (Ipopt::J_ITERSUMMARY, J_BOUNDTIGHTENING))),
+  adaptive_        (false),
+  minRate_         (0.),
+  rate_            (1.),
+  credit_          (0.),
+  lastGain_        (0.),
+  lastDepth_       (0),
+  rootYield_       (0.),
+  nRootRuns_       (0),
+  treeYield_       (-1.),
+  nSkipped_        (0) {}
 
 
 ///
@@ -42,13 +54,17 @@ CouenneBTPerfIndicator::~CouenneBTPerfIndicator () {
       nRuns_ && 
       problem_)
 
-    if (stats_)
+    if (stats_ && (adaptive_ || !quiet_)) {
       printf ("Performance of %30s:\t %10gs, %8d runs. fix: %10g shrnk: %10g ubd: %10g 2ubd: %10g infeas: %10g\n", 
 	      name_.c_str (),
 	      totalTime_, 
 	      nRuns_,
 	      nFixed_, boundRatio_, shrunkInf_, shrunkDoubleInf_, nProvedInfeas_);
 
+      if (adaptive_)
+	printf ("               %30s \t %8d skipped, final rate %g\n", "", nSkipped_, rate_);
+    }
+
   //weightSum_ * nFixed_, weightSum_ * boundRatio_, weightSum_ * shrunkInf_, weightSum_ * shrunkDoubleInf_, weightSum_ * nProvedInfeas_);
 
   if (oldLB_) delete [] oldLB_;
@@ -66,18 +82,35 @@ CouenneBTPerfIndicator::CouenneBTPerfIndicator (const CouenneBTPerfIndicator &rh
   shrunkDoubleInf_ (rhs.shrunkDoubleInf_),
   nProvedInfeas_   (rhs.nProvedInfeas_),
   weightSum_       (rhs.weightSum_),
-  oldLB_           (!rhs.problem_ || rhs.oldLB_ ? NULL : CoinCopyOfArray (rhs.oldLB_, rhs.problem_ -> nVars ())),
-  oldUB_           (!rhs.problem_ || rhs.oldUB_ ? NULL : CoinCopyOfArray (rhs.oldUB_, rhs.problem_ -> nVars ())),
+  oldLB_           (!rhs.problem_ || !rhs.oldLB_ ? NULL : CoinCopyOfArray (rhs.oldLB_, rhs.problem_ -> nVars ())),
+  oldUB_           (!rhs.problem_ || !rhs.oldUB_ ? NULL : CoinCopyOfArray (rhs.oldUB_, rhs.problem_ -> nVars ())),
   totalTime_       (rhs.totalTime_),
   nRuns_           (rhs.nRuns_),
   problem_         (rhs.problem_),
-  stats_           (rhs.stats_) {}
+  stats_           (rhs.stats_),
+  quiet_           (rhs.quiet_),
+  adaptive_        (rhs.adaptive_),
+  minRate_         (rhs.minRate_),
+  rate_            (rhs.rate_),
+  credit_          (rhs.credit_),
+  lastGain_        (rhs.lastGain_),
+  lastDepth_       (rhs.lastDepth_),
+  rootYield_       (rhs.rootYield_),
+  nRootRuns_       (rhs.nRootRuns_),
+  treeYield_       (rhs.treeYield_),
+  nSkipped_        (rhs.nSkipped_) {}
 
 
 ///
 CouenneBTPerfIndicator &CouenneBTPerfIndicator::operator= (const CouenneBTPerfIndicator &rhs) {
 
-  name_            = rhs.name_;
+  if (this == &rhs)
+    return *this;
+
+  if (oldLB_) delete [] oldLB_;
+  if (oldUB_) delete [] oldUB_;
+
+  name_             = rhs.name_;
   nFixed_          = rhs.nFixed_;
   boundRatio_      = rhs.boundRatio_;
   shrunkInf_       = rhs.shrunkInf_;
@@ -90,6 +123,17 @@ CouenneBTPerfIndicator &CouenneBTPerfIndicator::operator= (const CouenneBTPerfIn
   nRuns_           = rhs.nRuns_;
   problem_         = rhs.problem_;
   stats_           = rhs.stats_;
+  quiet_           = rhs.quiet_;
+  adaptive_        = rhs.adaptive_;
+  minRate_         = rhs.minRate_;
+  rate_            = rhs.rate_;
+  credit_          = rhs.credit_;
+  lastGain_        = rhs.lastGain_;
+  lastDepth_       = rhs.lastDepth_;
+  rootYield_       = rhs.rootYield_;
+  nRootRuns_       = rhs.nRootRuns_;
+  treeYield_       = rhs.treeYield_;
+  nSkipped_        = rhs.nSkipped_;
 
   return *this;
 }
@@ -111,6 +155,61 @@ void CouenneBTPerfIndicator::setOldBounds (const CouNumber *lb, const CouNumber
 }
 
 
-/// add to timer
-void CouenneBTPerfIndicator::addToTimer (double time) const 
-{totalTime_ += time;}
+/// add to timer and, if adaptive, update rate
+void CouenneBTPerfIndicator::addToTimer (double time) const {
+
+  totalTime_ += time;
+
+  if (!adaptive_)
+    return;
+
+  double yield = lastGain_ / CoinMax (time, 1e-4);
+
+  if (lastDepth_ <= 0) {
+
+    rootYield_ = (rootYield_ * nRootRuns_ + yield) / (nRootRuns_ + 1);
+    ++nRootRuns_;
+    return;
+  }
+
+  // smoothed yield in the tree, starting from that of the root
+
+  if (treeYield_ < 0.)
+    treeYield_ = rootYield_;
+
+  treeYield_ = 0.7 * treeYield_ + 0.3 * yield;
+
+  if      (rootYield_ > 0.) rate_ = treeYield_ / rootYield_;
+  else if (treeYield_ > 0.) rate_ = 1.;  // useless at the root, not in the tree
+  else                      rate_ *= 0.5;
+
+  rate_ = CoinMax (minRate_, CoinMin (1., rate_));
+}
+
+
+/// Turn adaptive schedule on or off
+void CouenneBTPerfIndicator::setAdaptive (bool adaptive, double minRate) {
+
+  adaptive_ = adaptive;
+  minRate_  = minRate;
+}
+
+
+/// Should the tightener run at this depth?
+bool CouenneBTPerfIndicator::run (int depth, bool dflt) const {
+
+  if (!adaptive_ || (depth <= 0))
+    return dflt;
+
+  // deterministic: run once every 1/rate_ calls
+
+  credit_ += rate_;
+
+  if (credit_ >= 1.) {
+    credit_ -= 1.;
+    return true;
+  }
+
+  ++nSkipped_;
+  return false;
+}
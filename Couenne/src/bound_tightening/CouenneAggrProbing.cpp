@@ -33,7 +33,7 @@ CouenneAggrProbing::CouenneAggrProbing(CouenneSetup *setup,
   maxNodes_ = 1000;
   initCutoff_ = COUENNE_INFINITY;
   restoreCutoff_ = false;
-
+  warmStart_ = NULL;
 }
 
 CouenneAggrProbing::CouenneAggrProbing(const CouenneAggrProbing &rhs){
@@ -44,9 +44,11 @@ CouenneAggrProbing::CouenneAggrProbing(const CouenneAggrProbing &rhs){
   maxNodes_ = rhs.maxNodes_;
   initCutoff_ = rhs.initCutoff_;
   restoreCutoff_ = rhs.restoreCutoff_;
+  warmStart_ = rhs.warmStart_ ? new CouenneBab::WarmStart(*rhs.warmStart_) : NULL;
 }
 
 CouenneAggrProbing::~CouenneAggrProbing(){
+  delete warmStart_;
 }
 
 void CouenneAggrProbing::registerOptions(Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
@@ -85,6 +87,41 @@ void CouenneAggrProbing::setRestoreCutoff(bool value){
   restoreCutoff_ = value;
 }
 
+void CouenneAggrProbing::setWarmStart(const CouenneBab::WarmStart &ws){
+  delete warmStart_;
+  warmStart_ = new CouenneBab::WarmStart(ws);
+}
+
+void CouenneAggrProbing::setupWarmStart(int nNodes){
+
+  int initMaxNodes = couenne_->getIntParameter(Bonmin::BabSetupBase::MaxNodes);
+  couenne_->setIntParameter(Bonmin::BabSetupBase::MaxNodes, nNodes);
+
+  CouenneBab bb;
+  bb.setProblem(couenne_->couennePtr()->Problem());
+  bb.setRecordWarmStart(true);
+  bb(couenne_);
+
+  couenne_->setIntParameter(Bonmin::BabSetupBase::MaxNodes, initMaxNodes);
+
+  setWarmStart(bb.learned());
+}
+
+/// Prepare a probing subtree: start it from the warm start, if any,
+/// and record its pseudocosts for the next probe
+static void setupProbe(CouenneBab &bb, const CouenneBab::WarmStart *ws){
+  bb.setWarmStart(ws);
+  bb.setRecordWarmStart(ws != NULL);
+}
+
+/// After a probing subtree: keep the pseudocosts it has updated
+static void updateWarmStart(const CouenneBab &bb, CouenneBab::WarmStart *ws){
+  if (ws && bb.learned().hasPseudoCosts_){
+    ws->pseudoCosts_ = bb.learned().pseudoCosts_;
+    ws->hasPseudoCosts_ = true;
+  }
+}
+
 double CouenneAggrProbing::probeVariable(int index, bool probeLower){
 
   // Useful objects for easy access
@@ -199,8 +236,10 @@ double CouenneAggrProbing::probeVariable(int index, bool probeLower){
     // bb.setUsingCouenne(true);
 
     CouenneBab bb;
+    setupProbe(bb, warmStart_);
 
     bb(couenne_);
+    updateWarmStart(bb, warmStart_);
     if (bb.model().isProvenInfeasible()){
       /// Problem is infeasible; therefore, probing was successful.
       currentBound = tryBound;
@@ -295,7 +334,9 @@ double CouenneAggrProbing::probeVariable(int index, bool probeLower){
     // bb.setUsingCouenne(true);
 
     CouenneBab bb;
+    setupProbe(bb, warmStart_);
     bb(couenne_);
+    updateWarmStart(bb, warmStart_);
 
     problem->domain()->pop();
 
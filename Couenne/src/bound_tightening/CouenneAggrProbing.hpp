@@ -20,6 +20,7 @@
 #include "OsiSolverInterface.hpp"
 #include "CouenneProblem.hpp"
 #include "BonCouenneSetup.hpp"
+#include "CouenneBab.hpp"
 
 namespace Couenne {
 
@@ -31,6 +32,12 @@ namespace Couenne {
   /// Couenne. However, it can also be used in the standard way; in
   /// that case, it chooses automatically the variables to probe (in a
   /// very naive way, for the moment).
+  ///
+  /// Each probe solves a subtree with the bounds of the probed
+  /// variable restricted. If a warm start is set (see setupWarmStart),
+  /// every subtree starts from the root bounds, cuts and pseudocosts
+  /// of a short main run instead of from scratch, and passes its own
+  /// pseudocosts to the next probe.
   /// TODO: Implement some way to automatically choose the variables
   /// TODO: Implement the generateCuts method, for use in Branch-and-Bound
 
@@ -92,6 +99,15 @@ namespace Couenne {
     void setRestoreCutoff(bool value);
     bool getRestoreCutoff() const;
 
+    /// Run a branch-and-bound of at most nNodes nodes on the main
+    /// problem and keep its root bounds, cuts and pseudocosts as the
+    /// warm start of all subsequent probes
+    void setupWarmStart(int nNodes);
+
+    /// Set the warm start of all subsequent probes (e.g. recorded by
+    /// the main run, see CouenneBab::setRecordWarmStart)
+    void setWarmStart(const CouenneBab::WarmStart &ws);
+
   protected:    
 
     /// Pointer to the CouenneProblem representation
@@ -115,6 +131,9 @@ namespace Couenne {
     /// Initial cutoff
     double initCutoff_;
 
+    /// Warm start of the probing subtrees (NULL if none)
+    CouenneBab::WarmStart *warmStart_;
+
   };
 }
 
@@ -20,6 +20,23 @@ namespace Couenne {
 
   class CouenneProblem;
 
+  /// Measures the performance of a bound tightener: for every run,
+  /// the bounds before (setOldBounds ()) and after (update ()) are
+  /// compared and the time is recorded (addToTimer ()).
+  ///
+  /// If adaptive (see setAdaptive ()), it also decides whether the
+  /// tightener should run at a node (run ()). The gain of a run is
+  /// the number of fixed variables plus the number of bounds that
+  /// became finite plus the total number of halvings of the bound
+  /// intervals; a proof of infeasibility counts as all variables
+  /// fixed. At the root, the tightener runs whenever its own rule
+  /// says so, and its average gain per second there is the
+  /// reference. In the tree, it runs at a rate equal to its recent
+  /// (exponentially smoothed) gain per second divided by the root's,
+  /// capped at one and never below a minimum rate, so that it is
+  /// called less often as it becomes less useful, and more often
+  /// (also deeper than its static depth rules) when it pays off.
+
   class CouenneBTPerfIndicator {
 
   protected:
@@ -45,11 +62,26 @@ namespace Couenne {
 
     bool stats_;                      /// Should stats be printed at the end? Copied from problem_ -> Jnlst () -> ProduceOutput (ERROR, BOUNDTIGHTENING)
 
+    bool quiet_;                      /// Print stats only if adaptive (false if problem_ -> Jnlst () -> ProduceOutput (ITERSUMMARY, BOUNDTIGHTENING))
+
+    bool   adaptive_;                 /// true if run () uses the adaptive schedule
+    double minRate_;                  /// minimum rate at which the tightener is run in the tree
+
+    mutable double rate_;             /// current rate at which the tightener is run in the tree
+    mutable double credit_;           /// accumulated rate; the tightener is run when it reaches one
+    mutable double lastGain_;         /// gain of the last run (set by update ())
+    mutable int    lastDepth_;        /// depth of the last run
+    mutable double rootYield_;        /// average gain per second at the root
+    mutable int    nRootRuns_;        /// number of runs at the root
+    mutable double treeYield_;        /// smoothed gain per second in the tree (negative before the first run there)
+    mutable int    nSkipped_;         /// number of calls in the tree where the tightener was not run
+
   public:
 
 
-    ///
-    CouenneBTPerfIndicator (CouenneProblem *p, const std::string &name);
+    /// If quiet, statistics are only printed with an adaptive
+    /// schedule or with bound tightening output at J_ITERSUMMARY
+    CouenneBTPerfIndicator (CouenneProblem *p, const std::string &name, bool quiet = false);
 
     ///
     ~CouenneBTPerfIndicator ();
@@ -63,11 +95,26 @@ namespace Couenne {
     ///
     void setOldBounds (const CouNumber *lb, const CouNumber *ub) const;
 
-    /// add to timer
+    /// add to timer. If adaptive, also update the rate with the gain
+    /// of the last call to update ()
     void addToTimer (double time) const;
 
-    /// 
-    void update (const CouNumber *lb, const CouNumber *ub, int depth) const;
+    /// compare new bounds with those passed to setOldBounds (); if
+    /// infeasible, the run has proven the node infeasible
+    void update (const CouNumber *lb, const CouNumber *ub, int depth, bool infeasible = false) const;
+
+    /// Print statistics at the end or not (e.g. not for copies of a
+    /// problem, whose original prints its own)
+    void setStats (bool value)
+    {stats_ = value;}
+
+    /// Turn adaptive schedule on or off, with minimum rate in the tree
+    void setAdaptive (bool adaptive, double minRate);
+
+    /// Should the tightener run at a node of this depth? dflt is the
+    /// decision of its own (static) rule, returned if the schedule
+    /// is not adaptive or at the root
+    bool run (int depth, bool dflt) const;
   };
 }
 
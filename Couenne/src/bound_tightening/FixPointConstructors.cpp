@@ -25,6 +25,11 @@ CouenneFixPoint::CouenneFixPoint (CouenneProblem *p,
   std::string s;
   options -> GetStringValue ("fixpoint_bt_model", s, "couenne."); 
   extendedModel_ = (s == "extended");
+
+  double minRate;
+  options -> GetStringValue  ("adaptive_bt",          s,       "couenne.");
+  options -> GetNumericValue ("adaptive_bt_min_rate", minRate, "couenne.");
+  perfIndicator_.setAdaptive (s == "yes", minRate);
 }
 
 
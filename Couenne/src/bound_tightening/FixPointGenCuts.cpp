@@ -19,6 +19,7 @@
 #include "CouennePrecisions.hpp"
 #include "CouenneExprVar.hpp"
 #include "CouenneInfeasCut.hpp"
+#include "CouenneProfile.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -56,8 +57,13 @@ void CouenneFixPoint::generateCuts (const OsiSolverInterface &si,
       treeInfo.pass > 1)
     return;
 
+  if (!(perfIndicator_. run (treeInfo.level, true)))
+    return;
+
   double startTime = CoinCpuTime ();
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_FIXPOINT);
+
   int nInitTightened = nTightened_;
 
   if (treeInfo.inTree && 
@@ -346,6 +352,7 @@ void CouenneFixPoint::generateCuts (const OsiSolverInterface &si,
       problem_ -> Jnlst () -> Printf (J_ERROR, J_COUENNE, " FPLP infeasible or unbounded.\n");
 
     WipeMakeInfeas (cs);
+    timer.pruned ();
 
     newLB = infeasBounds;
     newUB = infeasBounds + 1;
@@ -356,6 +363,8 @@ void CouenneFixPoint::generateCuts (const OsiSolverInterface &si,
   perfIndicator_. update (newLB, newUB, treeInfo.level);
   perfIndicator_. addToTimer (CoinCpuTime () - startTime);
 
+  timer.bounds (nTightened_ - nInitTightened);
+
   problem_ -> domain () -> pop ();
 
   delete [] oldLB;
@@ -20,6 +20,8 @@
 #include "CouenneProblem.hpp"
 #include "CouenneExprVar.hpp"
 #include "CouenneProblemElem.hpp"
+#include "CouenneProfile.hpp"
+#include "CouenneBTPerfIndicator.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -64,6 +66,8 @@ bool CouenneProblem::aggressiveBT (Bonmin::OsiTMINLPInterface *nlp,
 				   const CglTreeInfo &info,
 				   Bonmin::BabInfo * babInfo) const {
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_ABT);
+
   if (info.level <= 0 && !(info.inTree))  {
     jnlst_ -> Printf (J_ERROR, J_COUENNE, "Probing: ");
     fflush (stdout);
@@ -75,6 +79,10 @@ bool CouenneProblem::aggressiveBT (Bonmin::OsiTMINLPInterface *nlp,
   int  ncols  = nVars ();
   bool retval = false;
 
+  double startTime = CoinCpuTime ();
+
+  abtPerfIndicator_ -> setOldBounds (Lb (), Ub ());
+
   CouNumber
     *olb = CoinCopyOfArray (Lb (), ncols),
     *oub = CoinCopyOfArray (Ub (), ncols);
@@ -313,11 +321,19 @@ bool CouenneProblem::aggressiveBT (Bonmin::OsiTMINLPInterface *nlp,
   delete [] olb;
   delete [] oub;
 
+  abtPerfIndicator_ -> update     (Lb (), Ub (), info.level, !retval);
+  abtPerfIndicator_ -> addToTimer (CoinCpuTime () - startTime);
+
   if (info.level <= 0 && !(info.inTree))  {
     if (!retval) jnlst_ -> Printf (J_ERROR, J_COUENNE, "infeasible\n");
     else         jnlst_ -> Printf (J_ERROR, J_COUENNE, "%d improved bounds\n", nTotImproved);
   }
 
+  timer.bounds (nTotImproved);
+
+  if (!retval)
+    timer.pruned ();
+
   return retval; // && btCore (psi, cs, chg_bds, babInfo, true); // !!!
   //return retval && btCore (psi, cs, chg_bds, babInfo, true);
 }
@@ -13,6 +13,8 @@
 #include "CouenneExprVar.hpp"
 #include "CouenneProblemElem.hpp"
 #include "CouenneBTPerfIndicator.hpp"
+#include "CouenneTrace.hpp"
+#include "CouenneProfile.hpp"
 #include "BonBabInfos.hpp"
 #include "BonCbc.hpp"
 
@@ -25,6 +27,8 @@ using namespace Couenne;
 
 bool CouenneProblem::btCore (t_chg_bounds *chg_bds) const {
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_FBBT);
+
   fbbtReachedIterLimit_ = false;
 
   if (!chg_bds) {
@@ -87,11 +91,18 @@ bool CouenneProblem::btCore (t_chg_bounds *chg_bds) const {
     if (first)
       first = false;
 
+    CouenneTrace::event (CouenneTrace::TRACE_BTPASS,
+			 ((ntightened < 0) || (nbwtightened < 0)) ? -1 : ntightened + nbwtightened,
+			 (double) niter);
+
     if ((ntightened < 0) || (nbwtightened < 0)) {
       Jnlst () -> Printf (Ipopt::J_ITERSUMMARY, J_BOUNDTIGHTENING, "infeasible BT\n");
+      timer.pruned ();
       return false;
     }
 
+    timer.bounds (ntightened + nbwtightened);
+
     // continue if EITHER procedures gave (positive) results, as
     // expression structure is not a tree.
 
@@ -150,6 +161,7 @@ bool CouenneProblem::btCore (t_chg_bounds *chg_bds) const {
 	  (Lb (i) >   MAX_BOUND)) {
 
 	Jnlst () -> Printf (Ipopt::J_ITERSUMMARY, J_BOUNDTIGHTENING, "final test: infeasible BT\n");
+	timer.pruned ();
 	return false;
       }
 
@@ -12,6 +12,7 @@
 
 #include "CouenneProblem.hpp"
 #include "CouenneExprVar.hpp"
+#include "CouenneTrace.hpp"
 
 using namespace Couenne;
 
@@ -38,7 +39,7 @@ int CouenneProblem::impliedBounds (t_chg_bounds *chg_bds) const {
       knownOptimum -= nVars ();
   }
 
-  if (Jnlst()->ProduceOutput(Ipopt::J_DETAILED, J_BOUNDTIGHTENING)) {  
+  if (COUENNE_TRACE (Jnlst (), Ipopt::J_DETAILED, J_BOUNDTIGHTENING)) {  
     Jnlst()->Printf(Ipopt::J_DETAILED, J_BOUNDTIGHTENING,"  backward =====================\n  ");
     int j=0;
     for (int i=0; i < nVars (); i++) 
@@ -94,7 +95,7 @@ int CouenneProblem::impliedBounds (t_chg_bounds *chg_bds) const {
 	  Ub (i) = floor (Ub (i) + COUENNE_EPS);
 	  }*/
 
-	if (Jnlst()->ProduceOutput(Ipopt::J_VECTOR, J_BOUNDTIGHTENING)) {
+	if (COUENNE_TRACE (Jnlst (), Ipopt::J_VECTOR, J_BOUNDTIGHTENING)) {
 	  // todo: send all output through journalist
 	  Jnlst()->Printf(Ipopt::J_VECTOR, J_BOUNDTIGHTENING,
 			  "  impli %2d [%15.8g, %15.8g] -> [%15.8g, %15.8g]: ",
@@ -102,7 +103,7 @@ int CouenneProblem::impliedBounds (t_chg_bounds *chg_bds) const {
 
 	  variables_ [i] -> print (std::cout);
 
-	  if (Jnlst()->ProduceOutput(Ipopt::J_MOREVECTOR, J_BOUNDTIGHTENING)) {
+	  if (COUENNE_TRACE (Jnlst (), Ipopt::J_MOREVECTOR, J_BOUNDTIGHTENING)) {
 	    Jnlst()->Printf(Ipopt::J_MOREVECTOR, J_BOUNDTIGHTENING," := ");
 	    variables_ [i] -> Image () -> print (std::cout);
 	  }
@@ -17,6 +17,8 @@
 #include "CouenneCutGenerator.hpp"
 #include "CouenneProblem.hpp"
 #include "CouenneInfeasCut.hpp"
+#include "CouenneProfile.hpp"
+#include "CouenneBTPerfIndicator.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -195,13 +197,15 @@ int CouenneProblem::obbt (const CouenneCutGenerator *cg,
 
   // Do OBBT if:
   if (doOBBT_ &&                        // flag is checked, AND
-      ((logObbtLev_ != 0) ||               // (parameter is nonzero OR
-       (info.level == 0)) &&               //  we are at root node), AND
       (info.pass == 0) &&               // at first round of cuts, AND 
-      ((logObbtLev_ < 0) ||               // (logObbtLev = -1, OR
-       (info.level <= logObbtLev_) ||     //  depth is lower than COU_OBBT_CUTOFF_LEVEL, OR
-                                          //  probability inversely proportional to the level)
-       (CoinDrand48 () < pow (2., (double) logObbtLev_ - (info.level + 1))))) {
+      obbtPerfIndicator_ -> run         // the adaptive schedule (if any) says so, or
+      (info.level,
+       ((logObbtLev_ != 0) ||               // (parameter is nonzero OR
+	(info.level == 0)) &&               //  we are at root node), AND
+       ((logObbtLev_ < 0) ||               // (logObbtLev = -1, OR
+	(info.level <= logObbtLev_) ||     //  depth is lower than COU_OBBT_CUTOFF_LEVEL, OR
+                                           //  probability inversely proportional to the level)
+	(CoinDrand48 () < pow (2., (double) logObbtLev_ - (info.level + 1)))))) {
 
     if ((info.level <= 0 && !(info.inTree)) || 
     	jnlst_ -> ProduceOutput (J_STRONGWARNING, J_COUENNE))  {
@@ -213,6 +217,12 @@ int CouenneProblem::obbt (const CouenneCutGenerator *cg,
 
     jnlst_ -> Printf (J_ITERSUMMARY, J_BOUNDTIGHTENING, "----- OBBT\n");
 
+    CouenneProfile::Timer timer (CouenneProfile::PROF_OBBT);
+
+    double startTime = CoinCpuTime ();
+
+    obbtPerfIndicator_ -> setOldBounds (Lb (), Ub ());
+
     // TODO: why check info.pass==0? Why not more than one pass? It
     // should be anyway checked that info.level be >= 0 as <0 means
     // first call at root node
@@ -271,8 +281,14 @@ int CouenneProblem::obbt (const CouenneCutGenerator *cg,
     	jnlst_ -> ProduceOutput (J_STRONGWARNING, J_COUENNE))
       jnlst_ -> Printf (J_ERROR, J_COUENNE, "%d improved bounds\n", nTotImproved);
 
+    timer.bounds (nTotImproved);
+
+    obbtPerfIndicator_ -> update     (Lb (), Ub (), info.level, nImprov < 0);
+    obbtPerfIndicator_ -> addToTimer (CoinCpuTime () - startTime);
+
     if (nImprov < 0) {
       jnlst_->Printf(J_ITERSUMMARY, J_BOUNDTIGHTENING, "  Couenne: infeasible node after OBBT\n");
+      timer.pruned ();
       return -1;
     }
   }
@@ -9,8 +9,6 @@
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
-#include <set>
-
 #include "CouenneExprQuad.hpp"
 #include "CouenneConfig.h"
 #include "CoinFinite.hpp"
@@ -18,19 +16,6 @@
 
 using namespace Couenne;
 
-// struct compExpr;
-
-/** Structure for comparing variables
- *
- *  Used below to store sorted set of variables
- */
-
-struct compVar {
-  inline bool operator () (exprVar* e0, exprVar* e1) const
-  {return (e0 -> Index () < e1 -> Index ());}
-};
-
-
 /// implied bound processing for quadratic form upon change in lower-
 /// and/or upper bound of w, whose index is wind
 
@@ -53,21 +38,12 @@ bool exprQuad::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds
 
   // Nevermind about the nonlinear part stored in arglist_...
 
-  //std::set <int> indexSet;
-  std::set <exprVar *, compVar> indexSet;
-
-  // insert indices of linear part
-  for (lincoeff::iterator el = lcoeff_.begin (); el != lcoeff_.end (); ++el)
-    indexSet.insert (el -> first);
+  // variables of the linear and quadratic part, sorted by index, are
+  // the slots qbVar_ of the incremental bounds, and terms are in
+  // qbI_, qbJ_, qbCoe_
 
-  // insert indices of quadratic part
-  for (sparseQ::iterator row = matrix_.begin (); row != matrix_.end (); ++row) {
-
-    indexSet.insert (row -> first);
-
-    for (sparseQcol::iterator col = row -> second.begin (); col != row -> second.end (); ++col)
-      indexSet.insert (col -> first);
-  }
+  if (qbAdjStart_.empty ())
+    initQBounds ();
 
   // CAUTION: this relies on the first version of bound expressions
   // for quadratic form, i.e. the sum of bounds of independent terms
@@ -92,9 +68,8 @@ bool exprQuad::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds
   
 #ifdef DEBUG
   printf ("1st phase... inf=(%d,%d) q=[%g,%g].\n", indInfLo, indInfUp, qMin, qMax);
-  for (std::set <int>:: iterator iter = indexSet.begin ();
-       iter != indexSet.end (); ++iter) 
-    printf ("%4d [%+6g %+6g]\n", *iter, l [iter -> Index ()], u [iter -> Index ()]);
+  for (int k=0; k < (int) qbVar_.size (); k++)
+    printf ("%4d [%+6g %+6g]\n", qbVar_ [k] -> Index (), l [qbVar_ [k] -> Index ()], u [qbVar_ [k] -> Index ()]);
 #endif
 
   // compute bound on expression using only finite variable bounds
@@ -121,11 +96,11 @@ bool exprQuad::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds
   //
   // now fill in b_i (constant term in both linear coefficient vectors)
 
-  // prepare data structure for scanning all variables
+  // prepare data structure for scanning all variables (one per slot)
   int
-    minindex = (*(indexSet.begin  ())) -> Index (), // minimum index
-    maxindex = (*(indexSet.rbegin ())) -> Index (), // maximum index
-    nvars = maxindex - minindex + 1;           // upper bound on # variables involved
+    nvars = (int) qbVar_.size (),
+    nlin  = (int) lcoeff_.size (),
+    nterm = (int) qbI_.size ();
 
   CouNumber 
     *linCoeMin = new CouNumber [nvars], // min coeff of var x_i
@@ -142,17 +117,14 @@ bool exprQuad::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds
   CoinFillN (bCutUb,    nvars, 0.);
 
   // assume all coefficients are finite
-  for (lincoeff::iterator el = lcoeff_.begin (); el != lcoeff_.end (); ++el) {
-    //  for (int i=0; i<nlterms_; i++) {
+  for (int t=0; t<nlin; t++) {
 
-    int ind = el -> first -> Index ();//index_ [i];
+    int ind = qbI_ [t];
 
     CouNumber
-      coe = el -> second, //coeff_ [i], 
-      li  = l [ind], 
-      ui  = u [ind];
-
-    ind -= minindex;
+      coe = qbCoe_ [t],
+      li  = l [qbVar_ [ind] -> Index ()],
+      ui  = u [qbVar_ [ind] -> Index ()];
 
     linCoeMin [ind] += coe;
     linCoeMax [ind] += coe;
@@ -167,116 +139,101 @@ bool exprQuad::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds
   }
 
 #ifdef DEBUG
-  printf ("linear filling (%d,%d): -----------------------\n", minindex, maxindex);
-  for (std::set <int>:: iterator iter = indexSet.begin ();
-       iter != indexSet.end (); ++iter) 
-    printf ("%4d [%+6g %+6g] [%+6g %+6g]\n", iter -> Index (), 
-	    linCoeMin [iter -> Index () - minindex], linCoeMax [iter -> Index () - minindex],
-	    bCutLb    [iter -> Index () - minindex], bCutUb    [iter -> Index () - minindex]);
+  printf ("linear filling: -----------------------\n");
+  for (int k=0; k<nvars; k++)
+    printf ("%4d [%+6g %+6g] [%+6g %+6g]\n", qbVar_ [k] -> Index (),
+	    linCoeMin [k], linCoeMax [k], bCutLb [k], bCutUb [k]);
 #endif
 
   // fill in remaining linear coefficients and quadratic ones
-  for (sparseQ::iterator row = matrix_.begin (); row != matrix_.end (); ++row) {
-
-    for (sparseQcol::iterator col = row -> second.begin (); col != row -> second.end (); ++col) {
+  for (int t=nlin; t<nterm; t++) {
 
-      int
-	qi = row -> first -> Index (),
-        qj = col -> first -> Index (); //qindexJ_ [i];
+    int
+      qi = qbI_ [t],
+      qj = qbJ_ [t],
+      xi = qbVar_ [qi] -> Index (),
+      xj = qbVar_ [qj] -> Index ();
 
-      CouNumber coe = col -> second, //qcoeff_ [i],
-	li = l [qi], lj = l [qj], 
-	ui = u [qi], uj = u [qj];
+    CouNumber coe = qbCoe_ [t],
+      li = l [xi], lj = l [xj],
+      ui = u [xi], uj = u [xj];
 
-      if (qi == qj) { // quadratic term
+    if (qi == qj) { // quadratic term
 
-	qi -= minindex;
+      qii [qi] = coe; // quadratic term
 
-	qii [qi] = coe; // quadratic term
+      CouNumber
+	maxbUb = CoinMax (fabs (li), fabs (ui)),
+	maxbLb = (li >= 0) ? (li) : (ui <= 0) ? (ui) : 0;
 
-	CouNumber
-	  maxbUb = CoinMax (fabs (li), fabs (ui)),
-	  maxbLb = (li >= 0) ? (li) : (ui <= 0) ? (ui) : 0;
+      if (maxbUb > COUENNE_INFINITY) maxbUb = 0;
 
-	if (maxbUb > COUENNE_INFINITY) maxbUb = 0;
+      maxbUb *= maxbUb * coe;
+      maxbLb *= maxbLb * coe;
 
-	maxbUb *= maxbUb * coe;
-	maxbLb *= maxbLb * coe;
-
-	if (coe > 0) {
-	  bCutUb [qi] += maxbUb;
-	  bCutLb [qi] += maxbLb;
-	} else {
-	  bCutUb [qi] += maxbLb;
-	  bCutLb [qi] += maxbUb;
-	}
-      } else { // product term
-
-	coe *= 2;
-
-	CouNumber *b1, *b2;
+      if (coe > 0) {
+	bCutUb [qi] += maxbUb;
+	bCutLb [qi] += maxbLb;
+      } else {
+	bCutUb [qi] += maxbLb;
+	bCutLb [qi] += maxbUb;
+      }
+    } else { // product term
 
-	if (coe > 0) {b1 = l; b2 = u;} 
-	else         {b1 = u; b2 = l;}
+      coe *= 2;
 
-	b1 += minindex;
-	b2 += minindex;
+      CouNumber *b1, *b2;
 
-	qi -= minindex;
-	qj -= minindex;
+      if (coe > 0) {b1 = l; b2 = u;} 
+      else         {b1 = u; b2 = l;}
 
-	linCoeMin [qi] += coe * b1 [qj];
-	linCoeMin [qj] += coe * b1 [qi];
+      linCoeMin [qi] += coe * b1 [xj];
+      linCoeMin [qj] += coe * b1 [xi];
 
-	linCoeMax [qi] += coe * b2 [qj];
-	linCoeMax [qj] += coe * b2 [qi];
+      linCoeMax [qi] += coe * b2 [xj];
+      linCoeMax [qj] += coe * b2 [xi];
 
-	CouNumber
-	  addLo = CoinMin (CoinMin (li*lj, ui*uj),
-			   CoinMin (ui*lj, li*uj)),
-	  addUp = CoinMax (CoinMax (li*lj, ui*uj), 
-			   CoinMax (ui*lj, li*uj));
+      CouNumber
+	addLo = CoinMin (CoinMin (li*lj, ui*uj),
+			 CoinMin (ui*lj, li*uj)),
+	addUp = CoinMax (CoinMax (li*lj, ui*uj), 
+			 CoinMax (ui*lj, li*uj));
 
-	if (addLo < -COUENNE_INFINITY) addLo = 0;
-	if (addUp >  COUENNE_INFINITY) addUp = 0;
+      if (addLo < -COUENNE_INFINITY) addLo = 0;
+      if (addUp >  COUENNE_INFINITY) addUp = 0;
 
-	addLo *= coe;
-	addUp *= coe;
+      addLo *= coe;
+      addUp *= coe;
 
-	if (coe > 0) {
-	  bCutLb [qi] += addLo; bCutUb [qi] += addUp;
-	  bCutLb [qj] += addLo; bCutUb [qj] += addUp;
-	} else {
-	  bCutLb [qi] += addUp; bCutUb [qi] += addLo;
-	  bCutLb [qj] += addUp; bCutUb [qj] += addLo;
-	}
+      if (coe > 0) {
+	bCutLb [qi] += addLo; bCutUb [qi] += addUp;
+	bCutLb [qj] += addLo; bCutUb [qj] += addUp;
+      } else {
+	bCutLb [qi] += addUp; bCutUb [qi] += addLo;
+	bCutLb [qj] += addUp; bCutUb [qj] += addLo;
       }
     }
   }
 
 #ifdef DEBUG
   printf ("quad filling: -----------------------\n");
-  for (std::set <int>:: iterator iter = indexSet.begin ();
-       iter != indexSet.end (); ++iter) 
-    printf ("%4d [%+6g %+6g] [%+6g %+6g]\n", *iter, 
-	    linCoeMin [iter -> Index () - minindex], linCoeMax [iter -> Index () - minindex],
-	    bCutLb    [iter -> Index () - minindex], bCutUb    [iter -> Index () - minindex]);
+  for (int k=0; k<nvars; k++)
+    printf ("%4d [%+6g %+6g] [%+6g %+6g]\n", qbVar_ [k] -> Index (),
+	    linCoeMin [k], linCoeMax [k], bCutLb [k], bCutUb [k]);
 #endif
 
   // Done filling vectors /////////////////////////////////////////////////////////////
-  // Now improve each independent variable in the set indexSet
+  // Now improve each independent variable, i.e., each slot
 
   bool one_updated = false;
 
-  for (std::set <exprVar *, compVar>:: iterator iter = indexSet.begin ();
-       iter != indexSet.end (); ++iter) {
+  for (int indn = 0; indn < nvars; indn++) {
 
     bool
       updatedL = false,
       updatedU = false;
 
-    int ind  = (*iter) -> Index (), 
-        indn = ind - minindex;
+    int ind = qbVar_ [indn] -> Index ();
 
     CouNumber 
       al = linCoeMin [indn],
@@ -475,14 +432,14 @@ bool exprQuad::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds
     if (updatedL) {
       one_updated = true;
       chg [ind].setLower(t_chg_bounds::CHANGED);
-      if ((*iter) -> isInteger ())
+      if (qbVar_ [indn] -> isInteger ())
 	l [ind] = ceil (l [ind] - COUENNE_EPS);
     }
 
     if (updatedU) {
       one_updated = true;
       chg [ind].setUpper(t_chg_bounds::CHANGED);
-      if ((*iter) -> isInteger ())
+      if (qbVar_ [indn] -> isInteger ())
 	u [ind] = floor (u [ind] + COUENNE_EPS);
     }
   }
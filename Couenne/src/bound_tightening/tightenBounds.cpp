@@ -12,6 +12,7 @@
 #include "CouenneCutGenerator.hpp"
 #include "CouenneProblem.hpp"
 #include "CouenneExprVar.hpp"
+#include "CouenneTrace.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -46,7 +47,7 @@ int CouenneProblem::tightenBounds (t_chg_bounds *chg_bds) const {
       knownOptimum -= nVars ();
   }
 
-  bool dbgOutput = Jnlst () -> ProduceOutput (J_DETAILED, J_BOUNDTIGHTENING);
+  bool dbgOutput = COUENNE_TRACE (Jnlst (), J_DETAILED, J_BOUNDTIGHTENING);
 
   if (dbgOutput) {
     // ToDo: Pipe all output through journalist
@@ -83,7 +84,7 @@ int CouenneProblem::tightenBounds (t_chg_bounds *chg_bds) const {
 	// (upper_i < - MAX_BOUND) ||
 	// (lower_i >   MAX_BOUND)) {
 
-      if (Jnlst()->ProduceOutput(J_ITERSUMMARY, J_BOUNDTIGHTENING)) {
+      if (COUENNE_TRACE (Jnlst (), J_ITERSUMMARY, J_BOUNDTIGHTENING)) {
 
 	Jnlst()->Printf(J_ITERSUMMARY, J_BOUNDTIGHTENING,
 			"pre-check: w_%d has infeasible bounds [%.10e,%.10e]. ", i, lower_i, upper_i);
@@ -168,7 +169,7 @@ int CouenneProblem::tightenBounds (t_chg_bounds *chg_bds) const {
 			i, lower_i, upper_i, ll, uu, lower_i - ll);
 	var -> print (std::cout);
 
-	if (Jnlst()->ProduceOutput(J_MOREDETAILED, J_BOUNDTIGHTENING)) {
+	if (COUENNE_TRACE (Jnlst (), J_MOREDETAILED, J_BOUNDTIGHTENING)) {
 	  Jnlst()->Printf(J_MOREDETAILED, J_BOUNDTIGHTENING," := ");
 	  var -> Image () -> print (std::cout);
 	}
@@ -221,7 +222,7 @@ int CouenneProblem::tightenBounds (t_chg_bounds *chg_bds) const {
 			i, lower_i, upper_i, ll, uu, upper_i - uu);
 	var -> print (std::cout);
 
-	if (Jnlst()->ProduceOutput(J_VECTOR, J_BOUNDTIGHTENING)) {
+	if (COUENNE_TRACE (Jnlst (), J_VECTOR, J_BOUNDTIGHTENING)) {
 	  Jnlst()->Printf(J_VECTOR, J_BOUNDTIGHTENING," := ");
 	  var -> Image () -> print (std::cout);
 	}
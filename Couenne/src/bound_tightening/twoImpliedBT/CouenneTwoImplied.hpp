@@ -15,8 +15,10 @@
 
 #include "CglConfig.h"
 #include "CglCutGenerator.hpp"
+#include "CoinHelperFunctions.hpp"
 #include "OsiRowCut.hpp"
 #include "CouenneJournalist.hpp"
+#include "CouenneBTPerfIndicator.hpp"
 
 namespace Ipopt {
   template <class T> class SmartPtr;
@@ -227,6 +229,23 @@ namespace Couenne {
 
     /// Depth of the BB tree where stop separation
     int depthStopSeparate_;
+
+    /// Maximum number of pairs generated from a single column (0: all)
+    int maxColPairs_;
+
+    /// Maximum number of pairs processed at every call, best first (0: all)
+    int maxPairs_;
+
+    /// Performance indicator (and adaptive schedule)
+    CouenneBTPerfIndicator perfIndicator_;
+
+    /// Random numbers for the depth-dependent schedule, seeded from
+    /// the node (each clone has its own, as separators may run in
+    /// parallel threads)
+    mutable CoinThreadRandom randomGen_;
+
+    /// Number of warnings on wrong indices in the row matrix
+    mutable int nBadColMatWarnings_;
   };
 }
 
@@ -28,11 +28,21 @@ CouenneTwoImplied::CouenneTwoImplied (CouenneProblem *p,
   jnlst_     (jnlst),
   totalTime_ (0.),
   totalInitTime_ (0.),
-  firstCall_ (true) {
+  firstCall_ (true),
+  perfIndicator_ (p, "Two-implied bounds", true),
+  nBadColMatWarnings_ (0) {
 
   options -> GetIntegerValue ("two_implied_max_trials", nMaxTrials_,        "couenne.");
   options -> GetIntegerValue ("twoimpl_depth_level",    depthLevelling_,    "couenne.");
   options -> GetIntegerValue ("twoimpl_depth_stop",     depthStopSeparate_, "couenne.");
+  options -> GetIntegerValue ("twoimpl_col_pairs",      maxColPairs_,       "couenne.");
+  options -> GetIntegerValue ("twoimpl_max_pairs",      maxPairs_,          "couenne.");
+
+  std::string s;
+  double minRate;
+  options -> GetStringValue  ("adaptive_bt",          s,       "couenne.");
+  options -> GetNumericValue ("adaptive_bt_min_rate", minRate, "couenne.");
+  perfIndicator_.setAdaptive (s == "yes", minRate);
 }
 
 
@@ -47,7 +57,12 @@ CouenneTwoImplied::CouenneTwoImplied (const CouenneTwoImplied &src):
   totalInitTime_     (src.totalInitTime_),
   firstCall_         (src.firstCall_),
   depthLevelling_    (src.depthLevelling_),
-  depthStopSeparate_ (src.depthStopSeparate_) {}
+  depthStopSeparate_ (src.depthStopSeparate_),
+  maxColPairs_       (src.maxColPairs_),
+  maxPairs_          (src.maxPairs_),
+  perfIndicator_     (src.perfIndicator_),
+  randomGen_         (src.randomGen_),
+  nBadColMatWarnings_ (src.nBadColMatWarnings_) {}
 
 
 /// destructor
@@ -87,4 +102,16 @@ successful it can be repeated at every n nodes, otherwise it is stopped altogeth
     ("twoimpl_depth_stop",
      "Depth of the B&B tree where separation is stopped.",
      -1, 20, "A value of -1 means that generation can be done at all nodes");
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("twoimpl_col_pairs",
+     "Maximum number of pairs of inequalities generated from a single column.",
+     0, 1000, "If a variable appears in more inequalities than allowed for all their pairs, "
+     "each inequality is only paired with a few of the others. A value of 0 means that all pairs are generated.");
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("twoimpl_max_pairs",
+     "Maximum number of pairs of inequalities combined at every call.",
+     0, 0, "Pairs are ranked by the number of variables in common and with changed bounds, "
+     "and only the best ones are combined. A value of 0 (default) means that all pairs are combined.");
 }
@@ -8,7 +8,8 @@
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
-#include <set>
+#include <vector>
+#include <algorithm>
 #include <stdlib.h>
 
 #include "BonCbc.hpp"
@@ -26,6 +27,7 @@
 #include "CouenneProblem.hpp"
 #include "CouenneInfeasCut.hpp"
 #include "CouenneJournalist.hpp"
+#include "CouenneProfile.hpp"
 
 using namespace Ipopt;
 
@@ -55,6 +57,25 @@ int combine (CouenneProblem *p,
 	     bool *isInteger,
 	     int sign); // invert second constraint? -1: yes, +1: no
 
+/// candidate pair of inequalities, with its score
+struct twoImplPair {
+
+  int    h, k;   ///< indices of the two inequalities (h < k)
+  bool   check;  ///< true if the pair can be skipped when no bound has changed
+  double score;  ///< estimate of the bound gain
+};
+
+// sort pairs by decreasing score, pairs that cannot be skipped first
+
+static bool betterPair (const twoImplPair &p1,
+			const twoImplPair &p2) {
+
+  if (p1.check != p2.check) return p2.check;
+  if (p1.score != p2.score) return p1.score > p2.score;
+  if (p1.h     != p2.h)     return p1.h     < p2.h;
+  return                           p1.k     < p2.k;
+}
+
 /// the main CglCutGenerator
 void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si, 
 				      OsiCuts &cs, 
@@ -73,16 +94,39 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
 
   double now = CoinCpuTime ();
 
+  // below depthLevelling_, run with decreasing probability. Draw from
+  // this generator's own random numbers, seeded from the node, so
+  // that the choice does not depend on other separator threads
+
+  bool luckyDraw = true;
+
+  if (depthLevelling_ >= 0 &&
+      info.level >= depthLevelling_) {
+
+    int nNodes = 0;
+
+    Bonmin::BabInfo *babInfo = dynamic_cast <Bonmin::BabInfo *> (si.getAuxiliaryInfo ());
+
+    if (babInfo && babInfo -> babPtr ())
+      nNodes = babInfo -> babPtr () -> model (). getNodeCount ();
+
+    randomGen_.setSeed ((int) ((2654435761U * (unsigned int) (1 + nNodes)) >> 1));
+
+    luckyDraw = (randomGen_.randomDouble () <= 1. / (2. + info.level - depthLevelling_));
+  }
+
   // a more elaborate scheme to avoid heavy use of this heavy procedure
 
-  if ((depthStopSeparate_ >= 0 &&           // if -1, there is no limit on depth
-       info.level > depthStopSeparate_)     // otherwise, check if too deep for adding these cuts
-      ||
-      (depthLevelling_ >= 0 &&              // chance to run this procedure
-       info.level >= depthLevelling_ &&
-       CoinDrand48 () > 1. / (2. + info.level - depthLevelling_)))
+  if (!(perfIndicator_. run             // with an adaptive schedule, the depth rules are ignored
+	(info.level,
+	 !((depthStopSeparate_ >= 0 &&           // if -1, there is no limit on depth
+	    info.level > depthStopSeparate_)     // otherwise, check if too deep for adding these cuts
+	   ||
+	   !luckyDraw))))                        // chance to run this procedure
     return;
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_TWOIMPLIED);
+
   if (info.level <= 0)
     jnlst_ -> Printf (J_ERROR, J_COUENNE, "TwoImpl-BT: "); fflush (stdout);
 
@@ -97,9 +141,9 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
   // cs's OsiColCuts
   problem_ -> domain () -> push (&si, &cs);
 
-  static int nBadColMatWarnings = 0;
+  // candidate pairs, possibly repeated (once per useful shared column)
 
-  std::set <std::pair <int, int> > pairs;
+  std::vector <std::pair <int, int> > pairs;
 
   /// In principle, "si. getMatrixByCol ()" should be sufficient.
   /// However, there seems to be a bug (not sure where... Osi? Clp?
@@ -302,15 +346,44 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
   CoinFillN (sa1, n, 0.);
   CoinFillN (sa2, n, 0.);
 
+  // For every column, pair all rows with nonzero coefficient. If
+  // there are more than maxColPairs_ such pairs, pair each row only
+  // with the next few in the column (cyclically) so that the work on
+  // a column is bounded.
+
+  bool timeOut = false;
+
   for (int i=0; i<n; i++, sta++) {
 
     //printf ("x%d:\n", i);
 
-    for   (int jj = *(sta+1) - *sta, j = *sta; jj--; j++)
-      for (int kk = jj,              k = j+1;  kk--; k++) {
+    if (timeOut ||
+	(!(i & 63) && (CoinCpuTime () > problem_ -> getMaxCpuTime ()))) {
+
+      timeOut = true;
+      continue; // sta must still get to the end
+    }
+
+    int
+      len   = *(sta+1) - *sta,
+      width = ((maxColPairs_ <= 0) || (0.5 * len * (len - 1) <= maxColPairs_)) ?
+               len - 1 : CoinMax (1, maxColPairs_ / len);
 
-	if (CoinCpuTime () > problem_ -> getMaxCpuTime ())
-	  break;
+    bool allPairs = (width == len - 1);
+
+    for   (int jj = 0; jj < len;    jj++)
+      for (int kk = 1; kk <= width; kk++) {
+
+	int
+	  j = *sta + jj,
+	  k = jj + kk;
+
+	if (k >= len) {
+	  if (allPairs) break;
+	  k -= len;
+	}
+
+	k += *sta;
 
 	register int 
 	  indj = ind [j],
@@ -322,7 +395,7 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
  	if ((indj >= m + nCuts) || (indj < 0) ||
  	    (indk >= m + nCuts) || (indk < 0)) {
 
-	  if (nBadColMatWarnings++ < 1)
+	  if (nBadColMatWarnings_++ < 1)
 	    //	    jnlst_ -> Printf (J_STRONGWARNING, J_BOUNDTIGHTENING, " 
 	    printf ("\
   Couenne: warning, matrix by row has nonsense indices.\n\
@@ -387,7 +460,9 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
 
 	  continue;
 
-	pairs.insert (std::pair <int, int> (indj, indk));
+	pairs.push_back ((indj < indk) ?
+			 std::pair <int, int> (indj, indk) :
+			 std::pair <int, int> (indk, indj));
       }
   }
 
@@ -439,6 +514,70 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
 
   updateBranchInfo (si, problem_, chg_bds, info);
 
+  // Score the pairs with sparse counts. A pair generated from s
+  // columns has s variables that can cancel out in the combination;
+  // variables with bounds changed since the parent node are those
+  // that can give new implied bounds. The score is the fraction of
+  // such variables on the total length of the two rows.
+
+  std::vector <twoImplPair> ranked;
+
+  {
+    int nRows = m + nCuts;
+
+    std::vector <int>
+      rowLen (nRows),
+      rowChg (nRows, 0);
+
+    for (int r=0; r<nRows; r++) {
+
+      const int *rowInd;
+
+      if (r < m) {
+	rowLen [r] = rSta [r+1] - rSta [r];
+	rowInd     = rInd + rSta [r];
+      } else {
+	const CoinPackedVector &rowCoe = cs. rowCutPtr (r-m) -> row ();
+	rowLen [r] = rowCoe. getNumElements ();
+	rowInd     = rowCoe. getIndices ();
+      }
+
+      for (int i = rowLen [r]; i--;) {
+
+	t_chg_bounds &chg = chg_bds [rowInd [i]];
+
+	if ((chg. lower () != t_chg_bounds::UNCHANGED) ||
+	    (chg. upper () != t_chg_bounds::UNCHANGED))
+	  ++ (rowChg [r]);
+      }
+    }
+
+    std::sort (pairs.begin (), pairs.end ());
+
+    for (int i=0, j, nPairs = (int) pairs.size (); i < nPairs; i = j) {
+
+      for (j = i+1; (j < nPairs) && (pairs [j] == pairs [i]); j++);
+
+      twoImplPair pair;
+
+      pair.h     = pairs [i]. first;
+      pair.k     = pairs [i]. second;
+      pair.check = (pair.h < m) && (pair.k < m) && !firstCall_ && !(rowChg [pair.h] + rowChg [pair.k]);
+      pair.score = (double) (j - i + rowChg [pair.h] + rowChg [pair.k]) / (rowLen [pair.h] + rowLen [pair.k]);
+
+      ranked.push_back (pair);
+    }
+
+    std::vector <std::pair <int, int> > ().swap (pairs);
+
+    if ((maxPairs_ > 0) && ((int) ranked.size () > maxPairs_)) {
+
+      std::partial_sort (ranked.begin (), ranked.begin () + maxPairs_, ranked.end (), betterPair);
+      ranked.resize (maxPairs_);
+
+    } else std::sort (ranked.begin (), ranked.end (), betterPair);
+  }
+
   // Comparing all pairs of inequalities is overkill if the comparison
   // has been done in a previous iteration: a pair of inequalities of
   // the old LP relaxation should be skipped unless some bounds have
@@ -455,9 +594,13 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
     nCurTightened = 0;
 
     // scan all pairs. All are potential pairs of inequalities that
-    // can give a better (combined) implied bound
+    // can give a better (combined) implied bound. Pairs are scanned in
+    // order of score and one at a time: each combination works on the
+    // bounds tightened by the previous ones, best pairs first. This
+    // generator may itself run in a separator thread (sepa_threads),
+    // on its own clone of the problem
 
-    for (std::set <std::pair <int, int> >:: iterator p = pairs.begin (); p != pairs.end (); ++p) {
+    for (std::vector <twoImplPair>::iterator p = ranked.begin (); p != ranked.end (); ++p) {
 
       if (CoinCpuTime () > problem_ -> getMaxCpuTime ())
 	break;
@@ -465,8 +608,8 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
       // indices of the two inequalities
 
       int 
-	h = p -> first,
-	k = p -> second,
+	h = p -> h,
+	k = p -> k,
 	n1, n2;
 
       double l1, u1, l2, u2;
@@ -750,8 +893,14 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
 
   else 
 
-    if (result < 0)
+    if (result < 0) {
       WipeMakeInfeas (cs);
+      timer.pruned ();
+    }
+
+  perfIndicator_. setOldBounds (oldLB, oldUB);
+  perfIndicator_. update       (clb, cub, info.level, result < 0);
+  perfIndicator_. addToTimer   (CoinCpuTime () - now);
 
   delete [] clb;
   delete [] cub;
@@ -776,6 +925,8 @@ void CouenneTwoImplied::generateCuts (const OsiSolverInterface &si,
 
   totalTime_ += CoinCpuTime () - now;
 
+  timer.bounds (ntightened);
+
   if (info.level <= 0)
     jnlst_ -> Printf (J_ERROR, J_COUENNE, "%d improved bounds\n", ntightened);
 }
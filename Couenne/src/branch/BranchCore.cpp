@@ -22,6 +22,32 @@ int CouenneBranchingObject::nSGcomputations = 0;
 
 #define OB_WEIGHT 0.6
 
+#ifdef COIN_HAS_NTY
+
+/// orbit of variable indVar at the current node: with orbital fixing,
+/// from the generators of the root group that preserve the bounds of
+/// the node, otherwise from the last symmetry computation
+
+static std::vector <int> *branchOrbit (CouenneProblem *problem, OsiSolverInterface *solver, int indVar) {
+
+  if (!(problem -> orbitalFixing ()))
+    return problem -> Find_Orbit (indVar);
+
+  std::vector <int> orbit;
+
+  problem -> symOrbits (solver -> getColLower (), solver -> getColUpper (), orbit);
+
+  std::vector <int> *branch_orbit = new std::vector <int>;
+
+  for (int i=0; i < (int) orbit.size (); i++)
+    if (orbit [i] == orbit [indVar])
+      branch_orbit -> push_back (i);
+
+  return branch_orbit;
+}
+
+#endif
+
 /** \brief Execute the core of the branch --- need to separate code
     because of include conflicts with other packages' config_*.h
  */
@@ -53,7 +79,7 @@ void CouenneBranchingObject::branchCore (OsiSolverInterface *solver, int indVar,
 
       // DOWN BRANCH: xi <= brpt
 
-      std::vector< int > *branch_orbit = problem_ -> Find_Orbit (indVar);
+      std::vector< int > *branch_orbit = branchOrbit (problem_, solver, indVar);
 
       double
 	lb = solver -> getColLower () [indVar],
@@ -93,7 +119,9 @@ void CouenneBranchingObject::branchCore (OsiSolverInterface *solver, int indVar,
 
       solver -> setColUpper (indVar, integer ? floor (brpt) : brpt); // down branch, x [indVar] <= brpt
 
-      if (!simulate_ && (problem_ -> orbitalBranching ())){
+      delete branch_orbit;
+
+      if (!simulate_ && (problem_ -> orbitalBranching ()) && !(problem_ -> orbitalFixing ())){
 
 	//printf ("LEFT BRANCH: x10 in [%g,%g]\n", solver -> getColLower() [10], solver -> getColUpper() [10]);
 
@@ -118,7 +146,7 @@ void CouenneBranchingObject::branchCore (OsiSolverInterface *solver, int indVar,
       
       // UP BRANCH: xi >= brpt for all i in symmetry group
 
-      if (!simulate_ && (problem_ -> orbitalBranching ())){
+      if (!simulate_ && (problem_ -> orbitalBranching ()) && !(problem_ -> orbitalFixing ())){
 
 	problem_ -> ChangeBounds (solver -> getColLower (),  
 				  solver -> getColUpper (),  
@@ -128,7 +156,7 @@ void CouenneBranchingObject::branchCore (OsiSolverInterface *solver, int indVar,
 	//problem_ -> Print_Orbits ();
       }
 
-      std::vector< int > *branch_orbit = problem_ -> Find_Orbit (indVar);
+      std::vector< int > *branch_orbit = branchOrbit (problem_, solver, indVar);
 
       jnlst_ -> Printf (J_ERROR, J_BRANCHING, "Branch Symm (%d vars):", branch_orbit -> size ());
 
@@ -61,6 +61,8 @@ const CouNumber estProdEps = 1e-6;
 
     setTrustStrongForSolution (s == "yes");
     setTrustStrongForBound    (s == "yes");
+
+    b.options () -> GetIntegerValue ("strong_fbbt_candidates", fbbtCandidates_, "couenne.");
   }
 
   /// copy constructor
@@ -70,7 +72,8 @@ const CouNumber estProdEps = 1e-6;
     pseudoUpdateLP_   (rhs.pseudoUpdateLP_),
     estimateProduct_  (rhs.estimateProduct_),
     jnlst_            (rhs.jnlst_),
-    branchtime_       (rhs.branchtime_)
+    branchtime_       (rhs.branchtime_),
+    fbbtCandidates_   (rhs.fbbtCandidates_)
   {}
 
   /// destructor
@@ -93,6 +96,7 @@ const CouNumber estProdEps = 1e-6;
       estimateProduct_ = rhs.estimateProduct_;
       jnlst_           = rhs.jnlst_;
       branchtime_      = rhs.branchtime_;
+      fbbtCandidates_  = rhs.fbbtCandidates_;
     }
     return *this;
   }
@@ -348,6 +352,11 @@ Note: Must not return 4 for a non variable object
 
       int numberFixed=0;
 
+      // if too many, screen candidates with FBBT before solving LPs
+
+      if ((fbbtCandidates_ > 0) && ((int) results_.size () > fbbtCandidates_))
+	rankFBBT (info, indForPseudo, cardIndForPseudo);
+
       if (results_.size() > 0) {
 
 	//
@@ -882,6 +891,16 @@ void eliminateIntegerObjects (CbcModel           *model);
        "yes",
        "yes", "",
        "no",  "");
+
+    roptions -> AddLowerBoundedIntegerOption
+      ("strong_fbbt_candidates",
+       "Number of candidates evaluated with strong branching after ranking them with bound tightening",
+       0, 0,
+       "If positive and there are more candidates without reliable pseudocosts, "
+       "both branches of each candidate are simulated with FBBT only, "
+       "and only the candidates with the largest improvement of the bounds are evaluated by solving LPs "
+       "(the others are evaluated with pseudocosts if available, otherwise they are discarded). "
+       "If zero (default), all such candidates are evaluated with strong branching.");
   }
 
 
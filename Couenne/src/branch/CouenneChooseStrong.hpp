@@ -11,8 +11,13 @@
 #ifndef COUENNECHOOSESTRONG_HPP
 #define COUENNECHOOSESTRONG_HPP
 
+#include <vector>
+
 #include "BonChooseVariable.hpp"
 #include "CouenneJournalist.hpp"
+#include "CouenneTypes.hpp"
+
+class CoinWarmStart;
 
 namespace Couenne {
 
@@ -107,13 +112,25 @@ private:
 
 protected:
 
-  /// does one side of the branching
+  /// does one side of the branching. If the branching object is not
+  /// a bound change (it adds rows to the LP), the hot start must not
+  /// be marked: the LP is resolved starting from nodeBasis and the
+  /// rows are removed afterwards, while bounds are left to the caller
   int simulateBranch (OsiObject *Object,
 		      OsiBranchingInformation *info,
 		      OsiBranchingObject *branch,
 		      OsiSolverInterface *solver,
 		      Bonmin::HotInfo * result,
-		      int direction);
+		      int direction,
+		      const CoinWarmStart *nodeBasis = NULL);
+
+  /// Cheap screening of the candidates for strong branching: rank
+  /// them by the effect of FBBT on their two branches and only keep
+  /// the best fbbtCandidates_ in results_. Discarded candidates with
+  /// pseudocosts in both directions are appended to indForPseudo
+  void rankFBBT (OsiBranchingInformation *info,
+		 int *indForPseudo,
+		 int &cardIndForPseudo);
 
   /// Pointer to the associated MINLP problem
   CouenneProblem *problem_;
@@ -139,6 +156,31 @@ protected:
 
   /// total time spent in strong branching
   double branchtime_;
+
+  /// maximum number of candidates evaluated with strong branching
+  /// after ranking them with FBBT (0: no ranking, all untrusted
+  /// candidates are evaluated)
+  int fbbtCandidates_;
+
+  /** \name Scratch arrays of strong branching
+   *
+   *  Kept (and resized if needed) across calls to doStrongBranching,
+   *  so that nothing is allocated for each candidate. Not copied.
+   */
+  /** @{ */
+
+  std::vector <double> sbSaveLower_;  ///< intersection of the bounds of all branches
+  std::vector <double> sbSaveUpper_;
+  std::vector <double> sbUnionLower_; ///< union of the bounds of both branches of one object
+  std::vector <double> sbUnionUpper_;
+  std::vector <double> sbLower0_;     ///< initial bounds (only for output)
+  std::vector <double> sbUpper0_;
+
+  std::vector <t_chg_bounds> sbChgBds_; ///< changed bounds for FBBT
+
+  std::vector <int> sbRows_;          ///< rows added by a branching object, to be deleted
+
+  /** @} */
 };
 
 }
@@ -540,6 +540,18 @@ void CouenneChooseVariable::registerOptions (Ipopt::SmartPtr <Bonmin::Registered
      "yes", "",
      "no", "");
 
+  roptions -> AddStringOption2 
+    ("orbital_fixing",
+     "use the symmetry group of the root node to tighten bounds at all nodes",
+     "no",
+     "yes", "",
+     "no", "",
+     "The symmetry group is computed only once, at the root node. At each node, its generators that map the "
+     "current bounds onto themselves generate a group of symmetries of the node, whose orbits are computed "
+     "without calling Nauty again. After bound tightening, all variables of an orbit get the tightest bounds "
+     "of the orbit: in particular, if a binary variable is fixed, so are all variables in its orbit. "
+     "With orbital_branching, these orbits are also used for branching. Requires Nauty.");
+
   roptions -> AddLowerBoundedIntegerOption
     ("orbital_branching_depth",
      "Maximum depth at which the symmetry group is computed",
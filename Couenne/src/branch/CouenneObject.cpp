@@ -13,6 +13,7 @@
 #include "CouenneProblemElem.hpp"
 #include "CouenneObject.hpp"
 #include "CouenneBranchingObject.hpp"
+#include "CouenneTrace.hpp"
 
 #include "CoinHelperFunctions.hpp"
 
@@ -69,7 +70,7 @@ CouenneObject::CouenneObject (CouenneCutGenerator *cutgen,
 
   if (reference_ &&
       (reference_ -> Type () == AUX) && 
-      jnlst_ -> ProduceOutput (J_SUMMARY, J_BRANCHING)) {
+      COUENNE_TRACE (jnlst_, J_SUMMARY, J_BRANCHING)) {
 
     printf ("created Expression Object: "); reference_ -> print (); 
     if (reference_ -> Image ()) {
@@ -160,7 +161,7 @@ OsiBranchingObject *CouenneObject::createBranch (OsiSolverInterface *si,
   // the purpose, and save the output parameter into the branching
   // point that should be used later in createBranch.
 
-  if (jnlst_ -> ProduceOutput (J_ITERSUMMARY, J_BRANCHING)) {
+  if (COUENNE_TRACE (jnlst_, J_ITERSUMMARY, J_BRANCHING)) {
     printf ("CouObj::createBranch on ");
     reference_ -> print (); printf ("\n");
   }
@@ -225,7 +226,7 @@ OsiBranchingObject *CouenneObject::createBranch (OsiSolverInterface *si,
   } else setEstimates (info, NULL, brPts);
 
   /// Debug output 
-  if (jnlst_ -> ProduceOutput (J_MOREMATRIX, J_BRANCHING)) {
+  if (COUENNE_TRACE (jnlst_, J_MOREMATRIX, J_BRANCHING)) {
     printf ("brpts for "); reference_ -> print (); 
     if (reference_ -> Image ()) {printf (" := "); reference_ -> Image () -> print ();}
     printf (" is on "); brVar -> print ();
@@ -448,7 +449,7 @@ double CouenneObject::checkInfeasibility (const OsiBranchingInformation *info) c
     retval = 0.;
 
   if (//(retval > 0.) &&
-      (jnlst_ -> ProduceOutput (J_DETAILED, J_BRANCHING))) {
+      (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING))) {
 
     printf ("  infeas %g: ", retval); 
     reference_             -> print (); 
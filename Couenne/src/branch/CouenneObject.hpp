@@ -47,6 +47,9 @@ class CouenneCutGenerator;
 CouNumber minMaxDelta (funtriplet *ft, CouNumber lb, CouNumber ub);
 CouNumber maxHeight   (funtriplet *ft, CouNumber lb, CouNumber ub);
 
+/// Branching point for a variable with LP value x0 and bounds [lb,ub]
+CouNumber boxBranchPoint (CouNumber x0, CouNumber lb, CouNumber ub);
+
 
 /// OsiObject for auxiliary variables $w=f(x)$. 
 ///
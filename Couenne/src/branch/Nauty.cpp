@@ -21,6 +21,7 @@
 
 int Nauty::nautyCalls_ = 0;
 double Nauty::nautyTime_ = 0.0;
+Nauty *Nauty::current_ = NULL;
 
 Nauty::Nauty(int vertices)
 {
@@ -68,7 +69,7 @@ Nauty::Nauty(int vertices)
   options_->linelength = 78;
   options_->outfile = NULL;
   options_->userrefproc = NULL;
-  options_->userautomproc = NULL;
+  options_->userautomproc = storeGenerator;
   options_->userlevelproc = NULL;
   options_->usernodeproc = NULL;
   //  options_->usertcellproc = NULL;
@@ -165,11 +166,16 @@ Nauty::computeAuto()
   // Now the constraints if needed
 
   // Compute Partition
-    
+
+  generators_.clear();
+  current_ = this;
+
   nauty(G_, lab_, ptn_, active_, orbits_, options_, 
         stats_, workspace_, worksize_, m_, n_, canonG_);
   autoComputed_ = true;
 
+  current_ = NULL;
+
   double endCPU = CoinCpuTime ();
 
   nautyCalls_++;
@@ -178,6 +184,14 @@ Nauty::computeAuto()
   if (afp_) fflush(afp_);   
 }
 
+void
+Nauty::storeGenerator(int count, int *perm, int *orbits,
+                      int numorbits, int stabvertex, int n)
+{
+  if (current_)
+    current_->generators_.push_back(std::vector<int>(perm, perm + n));
+}
+
 void
 Nauty::deleteElement(int ix, int jx)
 {
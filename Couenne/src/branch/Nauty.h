@@ -48,6 +48,10 @@ public:
   /// Returns the orbits in a "convenient" form
   std::vector<std::vector<int> > *getOrbits() const;
 
+  /// Generators found by the last call to computeAuto(), each as a
+  /// permutation of the n_ vertices
+  const std::vector<std::vector<int> > &getGenerators() const { return generators_; }
+
   void getVstat(double *v, int nv);
 
   /**
@@ -97,6 +101,16 @@ private:
   // File pointer for automorphism group
   FILE *afp_;
 
+  // Generators of the automorphism group
+  std::vector<std::vector<int> > generators_;
+
+  // Called by nauty for each generator found
+  static void storeGenerator(int count, int *perm, int *orbits,
+                             int numorbits, int stabvertex, int n);
+
+  // Object whose computeAuto() is running, for storeGenerator()
+  static Nauty *current_;
+
 };
 
 #endif
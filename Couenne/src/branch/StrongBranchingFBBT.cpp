@@ -0,0 +1,190 @@
+/* $Id$
+ *
+ * Name:    StrongBranchingFBBT.cpp
+ * Author:  Pietro Belotti
+ * Purpose: rank candidates for strong branching by the effect of
+ *          FBBT on their branches, before solving any LP
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <algorithm>
+
+#include "OsiBranchingObject.hpp"
+#include "BonChooseVariable.hpp"
+
+#include "CouenneChooseStrong.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneProblemElem.hpp"
+#include "CouenneBranchingObject.hpp"
+
+using namespace Ipopt;
+using namespace Couenne;
+
+const CouNumber estProdEps = 1e-6;
+
+/// Simulate one branch of variable index (way = 0: x <= brpt, way =
+/// 1: x >= brpt) with FBBT only. Return COIN_DBL_MAX if FBBT proves
+/// the branch infeasible, otherwise the increase in the lower bound
+/// of the objective plus a small multiple of the average relative
+/// shrinkage of all variable bounds (which breaks ties when the
+/// objective bound does not change)
+
+static double probeFBBT (CouenneProblem *problem,
+			 OsiBranchingInformation *info,
+			 t_chg_bounds *chg_bds,
+			 int index, int way, CouNumber brpt, bool integer) {
+
+  int
+    nVars  = problem -> nVars (),
+    objInd = problem -> Obj (0) -> Body () -> Index ();
+
+  problem -> domain () -> push (nVars, info -> solution_, info -> lower_, info -> upper_);
+
+  for (int i=0; i<nVars; i++) {
+    chg_bds [i].setLower (t_chg_bounds::UNCHANGED);
+    chg_bds [i].setUpper (t_chg_bounds::UNCHANGED);
+  }
+
+  CouNumber
+    &lb = problem -> Lb (index),
+    &ub = problem -> Ub (index);
+
+  // same bounds as in the branching object, up to the special cases
+  // of an integer branching point
+
+  if (way) {lb = CoinMax (lb, integer ? floor (brpt) + 1. : brpt); chg_bds [index].setLower (t_chg_bounds::CHANGED);}
+  else     {ub = CoinMin (ub, integer ? floor (brpt)      : brpt); chg_bds [index].setUpper (t_chg_bounds::CHANGED);}
+
+  double score = COIN_DBL_MAX;
+
+  if ((lb <= ub + COUENNE_EPS) &&
+      problem -> btCore (chg_bds)) {
+
+    CouNumber
+      objLb0  = (objInd >= 0) ? info -> lower_ [objInd] : -COIN_DBL_MAX,
+      objGain = ((objInd >= 0) && (objLb0 > -COUENNE_INFINITY)) ?
+                 CoinMax (0., problem -> Lb (objInd) - objLb0) : 0.,
+      shrink  = 0.;
+
+    for (int i=0; i<nVars; i++) {
+
+      CouNumber width0 = info -> upper_ [i] - info -> lower_ [i];
+
+      if (width0 < COUENNE_EPS)
+	continue;
+
+      CouNumber width = problem -> Ub (i) - problem -> Lb (i);
+
+      shrink += (width0 > COUENNE_INFINITY) ?
+	((width < COUENNE_INFINITY) ? 1. : 0.) :
+	CoinMax (0., (width0 - width) / width0);
+    }
+
+    score = objGain + 1e-3 * (1. + ((objLb0 > -COUENNE_INFINITY) ? fabs (objLb0) : 0.)) * shrink / nVars;
+  }
+
+  problem -> domain () -> pop ();
+
+  return score;
+}
+
+
+/// Rank candidates for strong branching (results_) by simulating
+/// their two branches with FBBT, and only keep the best
+/// fbbtCandidates_. Of the others, those with pseudocosts in both
+/// directions are evaluated with pseudocosts (appended to
+/// indForPseudo), the remaining ones are dropped. Candidates
+/// required by min_number_strong_branch and those whose branching
+/// object is not a simple variable bound are always kept.
+
+void CouenneChooseStrong::rankFBBT (OsiBranchingInformation *info,
+				    int *indForPseudo,
+				    int &cardIndForPseudo) {
+
+  int
+    nRes  = (int) results_.size (),
+    nVars = problem_ -> nVars ();
+
+  if ((fbbtCandidates_ <= 0) ||
+      (nRes <= fbbtCandidates_) ||
+      !(problem_ -> doFBBT ()))
+    return;
+
+  if ((int) sbChgBds_.size () < nVars)
+    sbChgBds_.resize (nVars);
+
+  problem_ -> installCutOff ();
+
+  // (-score, position) so that sorting puts best candidates first and
+  // keeps the original order among equal ones
+
+  std::vector <std::pair <double, int> > score (nRes);
+
+  int nInfeas = 0;
+
+  for (int i=0; i<nRes; i++) {
+
+    OsiBranchingObject *branch = results_ [i]. branchingObject ();
+
+    CouenneBranchingObject *cb = dynamic_cast <CouenneBranchingObject *> (branch);
+
+    int index = -1;
+
+    if (cb && cb -> variable ())
+      index = cb -> variable () -> Index ();
+    else if (dynamic_cast <OsiIntegerBranchingObject *> (branch))
+      index = solver_ -> objects () [results_ [i]. whichObject ()] -> columnNumber ();
+
+    double value = COIN_DBL_MAX;
+
+    if ((i >= minNumberStrongBranch_) &&
+	(index >= 0) &&
+	branch -> boundBranch ()) {
+
+      bool integer = problem_ -> Var (index) -> isInteger ();
+
+      double
+	down = probeFBBT (problem_, info, &(sbChgBds_ [0]), index, 0, branch -> value (), integer),
+	up   = probeFBBT (problem_, info, &(sbChgBds_ [0]), index, 1, branch -> value (), integer);
+
+      if ((down == COIN_DBL_MAX) ||
+	  (up   == COIN_DBL_MAX)) ++nInfeas; // LP strong branching will fix it
+      else value = (estProdEps + CoinMin (down, up)) * (estProdEps + CoinMax (down, up));
+    }
+
+    score [i] = std::pair <double, int> (-value, i);
+  }
+
+  std::sort (score.begin (), score.end ());
+
+  std::vector <bool> keep (nRes, false);
+
+  for (int i=0; i < fbbtCandidates_ || (i < nRes && score [i].first == -COIN_DBL_MAX); i++)
+    keep [score [i].second] = true;
+
+  const int
+    *upNumber   = pseudoCosts_.upNumber   (),
+    *downNumber = pseudoCosts_.downNumber ();
+
+  int nKept = 0;
+
+  for (int i=0; i<nRes; i++)
+
+    if (keep [i])
+      results_ [nKept++] = results_ [i];
+
+    else {
+
+      int iObject = results_ [i]. whichObject ();
+
+      if (upNumber [iObject] && downNumber [iObject])
+	indForPseudo [cardIndForPseudo++] = iObject;
+    }
+
+  results_.resize (nKept);
+
+  jnlst_ -> Printf (J_ITERSUMMARY, J_BRANCHING,
+		    "FBBT ranking: %d of %d candidates kept for strong branching (%d with an infeasible branch)\n",
+		    nKept, nRes, nInfeas);
+}
@@ -233,7 +233,9 @@ inline bool compStrongPri (struct objStrongPri *one, struct objStrongPri *two)
 
       //problem_ -> Print_Orbits ();
 
-      std::vector<std::vector<int> > *orbits = problem_ -> getNtyInfo () -> getOrbits ();
+      std::vector<std::vector<int> > *orbits = problem_ -> orbitalFixing () ?
+	problem_ -> nodeOrbits (info -> lower_, info -> upper_) :
+	problem_ -> getNtyInfo () -> getOrbits ();
 
       // bail out if there are only trivial (size 1) orbits
 
@@ -10,11 +10,14 @@
  */
 
 #include "CoinTime.hpp"
+#include "CoinWarmStart.hpp"
 #include "BonChooseVariable.hpp"
 #include "CouenneChooseStrong.hpp"
 #include "CouenneProblem.hpp"
 #include "CouenneObject.hpp"
 #include "CouenneBranchingObject.hpp"
+#include "CouenneTrace.hpp"
+#include "CouenneProfile.hpp"
 
 //#define TRACE_STRONG
 //#define TRACE_STRONG2
@@ -84,39 +87,76 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
     }
 #endif
 
+    CouenneProfile::Timer timer (CouenneProfile::PROF_STRONGBRANCH);
+
     jnlst_ -> Printf (J_ITERSUMMARY, J_BRANCHING, 
 		      "\n-\n------- CCS: trying %d objects:\n", numberToDo);
 
     //solver -> doingResolve () = false; // turns off setCutoff and restoreUnused
 
-    int numberColumns = solver -> getNumCols ();
+    int
+      numberColumns = solver -> getNumCols (),
+      iDo;
+
+    // Branching objects that add rows (e.g. convexification cuts)
+    // are applied to this solver rather than to a clone, but outside
+    // of the hot start: the LP is resolved from the basis of this
+    // node, and the rows are removed afterwards. The hot start is
+    // marked (and unmarked) only when switching between the two
+    // kinds of objects, which are usually all of the same kind
+
+    CoinWarmStart *nodeBasis = NULL;
+
+    for (iDo = 0; iDo < numberToDo; iDo++)
+      if (!(results_ () [iDo]. branchingObject () -> boundBranch ())) {
+	nodeBasis = solver -> getWarmStart ();
+	break;
+      }
 
-    solver -> markHotStart (); // save current LP point
+    bool
+      hotStart = false, // is hot start marked?
+      lpChanged = false; // has LP been resolved with rows of a branching object?
 
     // save initial bounds
     const double
       *initLower = info -> lower_,
       *initUpper = info -> upper_;
 
+    // scratch arrays are kept across calls
+
+    if ((int) sbSaveLower_.size () < numberColumns) {
+
+      sbSaveLower_.  resize (numberColumns);
+      sbSaveUpper_.  resize (numberColumns);
+      sbUnionLower_. resize (numberColumns);
+      sbUnionUpper_. resize (numberColumns);
+      sbChgBds_.     resize (numberColumns);
+    }
+
     // save intersection of bounds obtained by branching on all objects
     double 
-      *saveLower = CoinCopyOfArray (info -> lower_, numberColumns),
-      *saveUpper = CoinCopyOfArray (info -> upper_, numberColumns),
+      *saveLower = &(sbSaveLower_ [0]),
+      *saveUpper = &(sbSaveUpper_ [0]),
 
       *Lower0 = NULL,
       *Upper0 = NULL,
 
       // save union of bounds on both branches of one object;
       // reset to (current) saveLower when branching on a new object
-      *unionLower  = new double [numberColumns],
-      *unionUpper  = new double [numberColumns],
+      *unionLower  = &(sbUnionLower_ [0]),
+      *unionUpper  = &(sbUnionUpper_ [0]),
 
       *lpSol     = NULL, 
        timeStart = CoinCpuTime ();
 
-    if (jnlst_ -> ProduceOutput (J_DETAILED, J_BRANCHING)) {
-      Lower0 = CoinCopyOfArray (info -> lower_, numberColumns); // delete afterwards
-      Upper0 = CoinCopyOfArray (info -> upper_, numberColumns);
+    CoinCopyN (info -> lower_, numberColumns, saveLower);
+    CoinCopyN (info -> upper_, numberColumns, saveUpper);
+
+    if (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING)) {
+      sbLower0_.assign (info -> lower_, info -> lower_ + numberColumns);
+      sbUpper0_.assign (info -> upper_, info -> upper_ + numberColumns);
+      Lower0 = &(sbLower0_ [0]);
+      Upper0 = &(sbUpper0_ [0]);
     }
 
     // LP solution for distance
@@ -132,7 +172,7 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
 
     //Bonmin::HotInfo * results = results_ ();
 
-    int returnCode = 0, iDo = 0;
+    int returnCode = 0;
 
     for (iDo = 0; iDo < numberToDo; iDo++) {
 
@@ -153,6 +193,29 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
       OsiBranchingObject * branch = result -> branchingObject ();
       assert (branch->numberBranches()==2);
 
+      bool boundBranch = branch -> boundBranch ();
+
+      if (boundBranch && !hotStart) {
+
+	if (lpChanged) { // go back to the LP of this node
+	  solver -> setWarmStart (nodeBasis);
+	  solver -> resolve ();
+	  lpChanged = false;
+	}
+
+	solver -> markHotStart (); // save current LP point
+	hotStart = true;
+
+      } else if (!boundBranch) {
+
+	if (hotStart) {
+	  solver -> unmarkHotStart ();
+	  hotStart = false;
+	}
+
+	lpChanged = true;
+      }
+
       CouenneBranchingObject *cb = dynamic_cast <CouenneBranchingObject *> (branch);
 
       if (cb) cb -> setSimulate (true);
@@ -198,7 +261,7 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
       }
 
       // Left branch
-      status0 = simulateBranch (Object, info, branch, solver, result, -1);
+      status0 = simulateBranch (Object, info, branch, solver, result, -1, nodeBasis);
 
       if(isInf0) {
 	status0 = 1; // branch was known to be infeasible
@@ -228,7 +291,7 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
 
       /* second direction */
 
-      status1 = simulateBranch (Object, info, branch, solver, result, +1);
+      status1 = simulateBranch (Object, info, branch, solver, result, +1, nodeBasis);
 
       if(isInf1) {
 	status1 = 1; // branch was known to be infeasible
@@ -253,7 +316,12 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
 
       bool tightened = false;
 
-      t_chg_bounds *chg_bds = new t_chg_bounds [numberColumns];
+      t_chg_bounds *chg_bds = &(sbChgBds_ [0]);
+
+      for (int j=0; j<numberColumns; j++) {
+	chg_bds [j].setLower (t_chg_bounds::UNCHANGED);
+	chg_bds [j].setUpper (t_chg_bounds::UNCHANGED);
+      }
 
       const double *sLb = solver->getColLower();
       const double *sUb = solver->getColUpper();
@@ -317,8 +385,6 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
 
 	status0 = status1 = 1;	           // if returns false, problem is infeasible
 
-      delete [] chg_bds;
-
       if ((status0 != 1) || (status1 != 1)) {
 
 	// set new bounding box as the possibly tightened one (a subset
@@ -352,6 +418,7 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
 
 #ifdef COIN_HAS_NTY
 	if (problem_ -> orbitalBranching () && 
+	    !(problem_ -> orbitalFixing ()) && // orbits are computed from the bounds
 	    (Object -> columnNumber () >= 0) &&
 	    (problem_ -> Find_Orbit (Object -> columnNumber ()) -> size () > 1)) {
 
@@ -379,7 +446,7 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
       }
     } // end loop /***********************************/
 
-    if (jnlst_ -> ProduceOutput (J_DETAILED, J_BRANCHING)) {
+    if (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING)) {
       printf ("strong branching: tightened bounds. ");
       // create union of bounding box from both branching directions
       for (int j=0; j<numberColumns; j++) {
@@ -387,9 +454,6 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
 	if (problem_ -> Lb (j) > Lower0 [j]) printf ("l%d (%g-->%g) ", j,Lower0[j], problem_->Lb (j));
 	if (problem_ -> Ub (j) < Upper0 [j]) printf ("u%d (%g-->%g) ", j,Upper0[j], problem_->Ub (j));
       }
-
-      delete [] Lower0;
-      delete [] Upper0;
     }
 
     //problem_ -> domain () -> pop (); // discard current point/bounds from problem
@@ -415,19 +479,24 @@ double distance (const double *p1, const double *p2, int size, double k=2.) {
     assert (iDo <= (int) results_.size());
     results_.resize (iDo);
 
-    delete [] unionLower;
-    delete [] unionUpper;
+    if (hotStart)
+      solver -> unmarkHotStart ();     // Delete the snapshot
 
-    delete [] saveLower;
-    delete [] saveUpper;
+    if (lpChanged) {                   // go back to the LP of this node
+      solver -> setWarmStart (nodeBasis);
+      solver -> resolve ();
+    }
 
-    solver -> unmarkHotStart ();     // Delete the snapshot
+    delete nodeBasis;
 
     //solver -> doingResolve () = true;
     branchtime_ += CoinCpuTime () - timeStart;
 
     jnlst_ -> Printf (J_DETAILED, J_BRANCHING, "Done doStrongBranching\n");
 
+    if (returnCode < 0)
+      timer.pruned ();
+
     return returnCode;
   }
 
@@ -438,23 +507,35 @@ int CouenneChooseStrong::simulateBranch (OsiObject *Object,
 					 OsiBranchingObject *branch,
 					 OsiSolverInterface *solver,
 					 Bonmin::HotInfo * result,
-					 int direction) {
+					 int direction,
+					 const CoinWarmStart *nodeBasis) {
 
   bool boundBranch = branch -> boundBranch ();
 
-  int status = -1;
+  int
+    status = -1,
+    nRows  = solver -> getNumRows (),
+    maxIter = 0;
+
+  // If the branching object adds rows, the hot start is not marked
+  // (see doStrongBranching): start from the LP point and basis of
+  // the node, as the rows are generated at the current point, then
+  // solve with a resolve and remove the rows (see below)
+
+  if (!boundBranch) {
 
-  // TODO: avoid cloning solver all the time
+    solver -> setColSolution (info -> solution_);
 
-  OsiSolverInterface *thisSolver = 
-    boundBranch ? solver : solver -> clone ();
+    if (nodeBasis)
+      solver -> setWarmStart (nodeBasis);
+  }
 
   CouenneObject *CouObj = dynamic_cast <CouenneObject *> (Object);
 
-  if ((branch -> branch (thisSolver) > COUENNE_INFINITY) || // branch is infeasible
+  if ((branch -> branch (solver) > COUENNE_INFINITY) || // branch is infeasible
       // Bound tightening if not a CouenneObject -- explicit since
       // FBBT is done at ::branch() for CouenneObjects
-      (!CouObj && !BranchingFBBT (problem_, Object, thisSolver))) {
+      (!CouObj && !BranchingFBBT (problem_, Object, solver))) {
 
     status = 1;
 
@@ -465,21 +546,25 @@ int CouenneChooseStrong::simulateBranch (OsiObject *Object,
     
     if (boundBranch) // branching rule is a variable bound, can use hotstart
 
-      thisSolver -> solveFromHotStart ();
+      solver -> solveFromHotStart ();
 
     else { // branching rule is more complicated, need a resolve
 
       int limit;
-      thisSolver -> getIntParam (OsiMaxNumIterationHotStart, limit);
-      thisSolver -> setIntParam (OsiMaxNumIteration,         limit); 
+      solver -> getIntParam (OsiMaxNumIteration,         maxIter);
+      solver -> getIntParam (OsiMaxNumIterationHotStart, limit);
+      solver -> setIntParam (OsiMaxNumIteration,         limit); 
+
+      solver -> resolve ();
 
-      thisSolver -> resolve ();
+      solver -> setIntParam (OsiMaxNumIteration, maxIter);
 
-      CouObj -> setEstimate (COUENNE_EPS, direction < 0 ? 0 : 1);
+      if (CouObj)
+	CouObj -> setEstimate (COUENNE_EPS, direction < 0 ? 0 : 1);
     }
 
-    if (pseudoUpdateLP_ && CouObj && thisSolver -> isProvenOptimal ()) {
-      CouNumber dist = distance (info -> solution_, thisSolver -> getColSolution (), 
+    if (pseudoUpdateLP_ && CouObj && solver -> isProvenOptimal ()) {
+      CouNumber dist = distance (info -> solution_, solver -> getColSolution (), 
 				 problem_ -> nVars ());
 
       if (dist > COUENNE_EPS)
@@ -492,9 +577,9 @@ int CouenneChooseStrong::simulateBranch (OsiObject *Object,
 
   // only update information if this branch is feasible
   if (status < 0)
-    status = result -> updateInformation (thisSolver, info, this);
+    status = result -> updateInformation (solver, info, this);
   
-  numberStrongIterations_ += thisSolver -> getIterationCount ();
+  numberStrongIterations_ += solver -> getIterationCount ();
 
   if ((status == 3) && (trustStrongForSolution_)) {
     // new solution already saved
@@ -503,8 +588,24 @@ int CouenneChooseStrong::simulateBranch (OsiObject *Object,
     status = 0;
   }
 
-  if (solver != thisSolver)
-    delete thisSolver;
+  if (!boundBranch) {
+
+    // remove rows added by the branching object. Bounds are left as
+    // set by the branching object, as the caller uses them
+
+    int nAdded = solver -> getNumRows () - nRows;
+
+    if (nAdded > 0) {
+
+      if ((int) sbRows_.size () < nAdded)
+	sbRows_.resize (nAdded);
+
+      for (int i=0; i<nAdded; i++)
+	sbRows_ [i] = nRows + i;
+
+      solver -> deleteRows (nAdded, &(sbRows_ [0]));
+    }
+  }
 
   return status;
 }
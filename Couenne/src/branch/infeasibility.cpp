@@ -12,6 +12,7 @@
 
 #include "CouenneProblem.hpp"
 #include "CouenneVarObject.hpp"
+#include "CouenneTrace.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -56,7 +57,7 @@ double CouenneVarObject::infeasibility (const OsiBranchingInformation *info, int
   //////////////////////////////////////////////
 
   if (//(retval > CoinMin (COUENNE_EPS, feas_tolerance_)) &&
-      (jnlst_ -> ProduceOutput (J_DETAILED, J_BRANCHING))) {
+      (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING))) {
 
     const std::set <int> &dependence = problem_ -> Dependence () [index];
 
@@ -88,7 +89,7 @@ double CouenneVarObject::infeasibility (const OsiBranchingInformation *info, int
     if (pseudoMultType_ != PROJECTDIST)
       setEstimates (info, &retval, &brkPt);
 
-    if (jnlst_ -> ProduceOutput (J_DETAILED, J_BRANCHING)) {
+    if (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING)) {
       printf("index = %d up = %e down = %e bounds [%e,%e] brpt = %e inf = %e\n", 
   	     index, upEstimate_, downEstimate_, 
  	     info -> lower_ [index],
@@ -116,12 +117,13 @@ double CouenneVarObject::infeasibility (const OsiBranchingInformation *info, int
   //CoinMax (retval, intInfeasibility (info -> solution_ [reference_ -> Index ()])) :
   //retval);
 
-  jnlst_ -> Printf (J_DETAILED, J_BRANCHING, 
-  		    "infVar x%d ==> returning %e\n", reference_ -> Index (), (reference_ -> isInteger ()) ? 
-  		    CoinMax (retval, intInfeasibility (info -> solution_ [refInd],
-						       info -> lower_    [refInd],
-						       info -> upper_    [refInd])) :
-  		    retval);
+  if (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING))
+    jnlst_ -> Printf (J_DETAILED, J_BRANCHING, 
+		      "infVar x%d ==> returning %e\n", reference_ -> Index (), (reference_ -> isInteger ()) ? 
+		      CoinMax (retval, intInfeasibility (info -> solution_ [refInd],
+							 info -> lower_    [refInd],
+							 info -> upper_    [refInd])) :
+		      retval);
 
   return retval;
 
@@ -13,6 +13,7 @@
 #include "CouenneProblem.hpp"
 #include "CouenneProblemElem.hpp"
 #include "CouenneVTObject.hpp"
+#include "CouenneTrace.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -49,7 +50,7 @@ double CouenneVTObject::infeasibility (const OsiBranchingInformation *info, int
 
   // debug output ////////////////////////////////////////////////////////////////
 
-  if (jnlst_ -> ProduceOutput (J_DETAILED, J_BRANCHING)) {
+  if (COUENNE_TRACE (jnlst_, J_DETAILED, J_BRANCHING)) {
     printf ("VT infeas on ");
     reference_ -> print ();
     if (reference_ -> Image ()) { // if no list, print image
@@ -133,7 +134,7 @@ double CouenneVTObject::infeasibility (const OsiBranchingInformation *info, int
 	if (right > rFeas) rFeas = right;
       }
 
-      if (jnlst_ -> ProduceOutput (J_MATRIX, J_BRANCHING)) { // debug output
+      if (COUENNE_TRACE (jnlst_, J_MATRIX, J_BRANCHING)) { // debug output
 	expression *ref = obj -> Reference ();
 	jnlst_ -> Printf (J_MATRIX, J_BRANCHING, "[%g,%g] --> %g - %g = %g (diff = %g - %g = %g): ", 
 			  left, right, rFeas, lFeas, rFeas - lFeas,
@@ -199,14 +200,15 @@ double CouenneVTObject::infeasibility (const OsiBranchingInformation *info, int
     //       info -> pi_ [info -> row_ [indRow]] * 
     //       fabs (info -> elementByColumn_  [indRow]);
 
-    jnlst_ -> Printf (J_MATRIX, J_BRANCHING, "+ (pi[%d]=%g) * (el[%d]=%g) [=%g] --> vtd = %g\n",
-		      info -> row_ [indRow],
-		      info -> pi_ [info -> row_ [indRow]], 
-		      indRow,
-		      info -> elementByColumn_  [indRow],
-		      info -> pi_ [info -> row_ [indRow]] * 
-		      info -> elementByColumn_  [indRow],
-		      vt_delta);
+    if (COUENNE_TRACE (jnlst_, J_MATRIX, J_BRANCHING))
+      jnlst_ -> Printf (J_MATRIX, J_BRANCHING, "+ (pi[%d]=%g) * (el[%d]=%g) [=%g] --> vtd = %g\n",
+			info -> row_ [indRow],
+			info -> pi_ [info -> row_ [indRow]], 
+			indRow,
+			info -> elementByColumn_  [indRow],
+			info -> pi_ [info -> row_ [indRow]] * 
+			info -> elementByColumn_  [indRow],
+			vt_delta);
   }
 
   // weights for VT itself and width of interval
@@ -214,16 +216,17 @@ double CouenneVTObject::infeasibility (const OsiBranchingInformation *info, int
     alpha = 1.0,
     beta  = 0.0;
 
-  jnlst_ -> Printf (J_MATRIX, J_BRANCHING, "return %g * %g + %g * %g + %g * %g --> ", 
-		    alpha, fabs (retval * vt_delta), beta, retval,
-		    1-alpha-beta, leanLeft * (1-leanLeft));
+  if (COUENNE_TRACE (jnlst_, J_MATRIX, J_BRANCHING))
+    jnlst_ -> Printf (J_MATRIX, J_BRANCHING, "return %g * %g + %g * %g + %g * %g --> ", 
+		      alpha, fabs (retval * vt_delta), beta, retval,
+		      1-alpha-beta, leanLeft * (1-leanLeft));
 
   retval = 
     alpha          * fabs (retval*vt_delta) +  // violation transfer itself
     beta           * retval +                  // width of feasibility interval
     (1-alpha-beta) * leanLeft * (1-leanLeft);  // how in the middle of the interval x is
 
-  if (jnlst_ -> ProduceOutput (J_MATRIX, J_BRANCHING)) {
+  if (COUENNE_TRACE (jnlst_, J_MATRIX, J_BRANCHING)) {
     if (retval > tol) {
       printf ("vt-delta is %-10g [", retval); 
       reference_ -> print (); 
@@ -0,0 +1,138 @@
+/* $Id$
+ *
+ * Name:    branchExprMultiLin.cpp
+ * Author:  Pietro Belotti
+ * Purpose: return branch data for multilinear terms
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+
+#include "CoinHelperFunctions.hpp"
+
+#include "CouennePrecisions.hpp"
+#include "CouenneTypes.hpp"
+#include "CouenneObject.hpp"
+
+#include "CouenneExprMultiLin.hpp"
+
+using namespace Couenne;
+
+/// set up branching object by evaluating many branching points for
+/// each expression's arguments.
+///
+/// The gap between a multilinear term and its envelopes is zero on
+/// the vertices of the bounding box and is largest in its interior.
+/// Branch on the factor x_i with the largest (u_i - x_i) (x_i - l_i)
+/// times the largest absolute value of the product of the other
+/// factors, which bounds the contribution of x_i to the gap, or on
+/// an unbounded factor if there is one.
+
+CouNumber exprMultiLin::selectBranch (const CouenneObject *obj,
+				      const OsiBranchingInformation *info,
+				      expression *&var,
+				      double * &brpts,
+				      double * &brDist, // distance of current LP point
+				                        // to new convexifications
+				      int &way) {
+  var = NULL;
+
+  int
+    wi   = obj -> Reference () -> Index (),
+    best = -1;
+
+  assert (wi >= 0);
+
+  CouNumber
+    w0     = info -> solution_ [wi],
+    f0     = 1.,
+    maxGap = 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    f0 *= (ind < 0) ? arglist_ [i] -> Value () : info -> solution_ [ind];
+  }
+
+  CouNumber viol = fabs (w0 - f0);
+
+  if (viol < COUENNE_EPS)
+    return 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    if (ind < 0)
+      continue;
+
+    CouNumber
+      x0 = info -> solution_ [ind],
+      xl = info -> lower_    [ind],
+      xu = info -> upper_    [ind];
+
+    if (xu - xl < COUENNE_EPS)
+      continue;
+
+    // unbounded factors first
+
+    if ((xl < -COUENNE_INFINITY) ||
+	(xu >  COUENNE_INFINITY)) {
+
+      if (maxGap < COUENNE_INFINITY) {
+	maxGap = COUENNE_INFINITY;
+	best   = i;
+      }
+
+      continue;
+    }
+
+    CouNumber gap = (xu - x0) * (x0 - xl);
+
+    if (gap < COUENNE_EPS) // LP point on a bound: use interval width
+      gap = COUENNE_EPS * (xu - xl);
+
+    for (int j=0; j<nargs_; j++) {
+
+      if (j == i)
+	continue;
+
+      int indj = arglist_ [j] -> Index ();
+
+      gap *= (indj < 0) ?
+	fabs (arglist_ [j] -> Value ()) :
+	CoinMax (fabs (info -> lower_ [indj]),
+		 fabs (info -> upper_ [indj]));
+    }
+
+    if (gap > maxGap) {
+      maxGap = gap;
+      best   = i;
+    }
+  }
+
+  if (best < 0)
+    return 0.;
+
+  var = arglist_ [best];
+
+  int ind = var -> Index ();
+
+  CouNumber
+    x0 = info -> solution_ [ind],
+    xl = info -> lower_    [ind],
+    xu = info -> upper_    [ind];
+
+  brpts  = (double *) realloc (brpts,      sizeof (double));
+  brDist = (double *) realloc (brDist, 2 * sizeof (double));
+
+  *brpts = boxBranchPoint (x0, xl, xu);
+
+  way = TWO_RAND;
+
+  brDist [0] = brDist [1] = CoinMax (viol, COUENNE_EPS);
+
+  return viol;
+}
@@ -0,0 +1,124 @@
+/* $Id$
+ *
+ * Name:    branchExprNorm.cpp
+ * Author:  Pietro Belotti
+ * Purpose: return branch data for Euclidean norms
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+
+#include "CoinHelperFunctions.hpp"
+
+#include "CouennePrecisions.hpp"
+#include "CouenneTypes.hpp"
+#include "CouenneObject.hpp"
+
+#include "CouenneExprNorm.hpp"
+
+using namespace Couenne;
+
+/// set up branching object by evaluating many branching points for
+/// each expression's arguments.
+///
+/// Only the concave side w <= ||x|| needs branching, as the convex
+/// side is approximated arbitrarily well by tangents. The secant
+/// overestimator of each x_i^2 gets tighter as [l_i,u_i] shrinks,
+/// hence branch on the argument with the largest contribution (u_i -
+/// l_i)^2 to the gap between ||x|| and its overestimator
+
+CouNumber exprNorm::selectBranch (const CouenneObject *obj,
+				  const OsiBranchingInformation *info,
+				  expression *&var,
+				  double * &brpts,
+				  double * &brDist, // distance of current LP point
+				                    // to new convexifications
+				  int &way) {
+  var = NULL;
+
+  int
+    wi   = obj -> Reference () -> Index (),
+    best = -1;
+
+  assert (wi >= 0);
+
+  CouNumber
+    w0      = info -> solution_ [wi],
+    norm0   = 0.,
+    maxGap  = 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    if (ind < 0) {
+      CouNumber c = arglist_ [i] -> Value ();
+      norm0 += c*c;
+      continue;
+    }
+
+    CouNumber
+      x0 = info -> solution_ [ind],
+      xl = info -> lower_    [ind],
+      xu = info -> upper_    [ind];
+
+    norm0 += x0*x0;
+
+    if (xu - xl < COUENNE_EPS)
+      continue;
+
+    // unbounded arguments first: break their interval at zero or
+    // away from the finite bound
+
+    if ((xl < -COUENNE_INFINITY) ||
+	(xu >  COUENNE_INFINITY)) {
+
+      if (maxGap < COUENNE_INFINITY) {
+	maxGap = COUENNE_INFINITY;
+	best   = i;
+      }
+
+      continue;
+    }
+
+    CouNumber gap = (xu - x0) * (x0 - xl);  // error of secant of x_i^2 at x0
+
+    if (gap < COUENNE_EPS) // LP point on a bound: use interval width
+      gap = COUENNE_EPS * (xu - xl);
+
+    if (gap > maxGap) {
+      maxGap = gap;
+      best   = i;
+    }
+  }
+
+  norm0 = sqrt (norm0);
+
+  if (best < 0)
+    return 0.;
+
+  var = arglist_ [best];
+
+  int ind = var -> Index ();
+
+  CouNumber
+    x0 = info -> solution_ [ind],
+    xl = info -> lower_    [ind],
+    xu = info -> upper_    [ind];
+
+  brpts  = (double *) realloc (brpts,      sizeof (double));
+  brDist = (double *) realloc (brDist, 2 * sizeof (double));
+
+  *brpts = boxBranchPoint (x0, xl, xu);
+
+  way = TWO_RAND;
+
+  // the gap closed is at most the current violation of w <= ||x||
+
+  CouNumber viol = CoinMax (0., w0 - norm0);
+
+  brDist [0] = brDist [1] = CoinMax (viol, COUENNE_EPS);
+
+  return viol;
+}
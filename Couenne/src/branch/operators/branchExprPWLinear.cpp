@@ -0,0 +1,83 @@
+/* $Id$
+ *
+ * Name:    branchExprPWLinear.cpp
+ * Author:  Pietro Belotti
+ * Purpose: return branch data for piecewise linear functions
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+
+#include "CoinHelperFunctions.hpp"
+
+#include "CouennePrecisions.hpp"
+#include "CouenneTypes.hpp"
+#include "CouenneObject.hpp"
+
+#include "CouenneExprPWLinear.hpp"
+
+using namespace Couenne;
+
+/// set up branching object by evaluating many branching points for
+/// each expression's arguments.
+///
+/// Branching only happens on breakpoints in the interior of the
+/// bounding box of the argument, and on the median one: each branch
+/// rules out half of the pieces, and after at most log_2 K levels the
+/// function is linear in each node and its envelope is exact. This
+/// is the branching counterpart of a logarithmic SOS2 encoding, and
+/// needs no extra variables.
+
+CouNumber exprPWLinear::selectBranch (const CouenneObject *obj,
+				      const OsiBranchingInformation *info,
+				      expression *&var,
+				      double * &brpts,
+				      double * &brDist, // distance of current LP point
+				                        // to new convexifications
+				      int &way) {
+  var = NULL;
+
+  int
+    ind = arglist_ [0] -> Index (),
+    wi  = obj -> Reference () -> Index ();
+
+  if (ind < 0)
+    return 0.;
+
+  assert (wi >= 0);
+
+  CouNumber
+    x0 = info -> solution_ [ind],
+    w0 = info -> solution_ [wi],
+    l  = info -> lower_    [ind],
+    u  = info -> upper_    [ind];
+
+  // breakpoints in the interior of [l,u] (distinct abscissae)
+
+  std::vector <CouNumber> inner;
+
+  for (int k = 0, K = (int) x_.size (); k < K; k++)
+    if ((x_ [k] > l + COUENNE_EPS) &&
+	(x_ [k] < u - COUENNE_EPS) &&
+	(inner.empty () || (x_ [k] > inner.back ())))
+      inner.push_back (x_ [k]);
+
+  if (inner.empty ()) // f is linear on [l,u]
+    return 0.;
+
+  var = arglist_ [0];
+
+  brpts  = (double *) realloc (brpts,      sizeof (double));
+  brDist = (double *) realloc (brDist, 2 * sizeof (double));
+
+  *brpts = inner [inner.size () / 2];
+
+  way = (x0 < *brpts) ? TWO_LEFT : TWO_RIGHT;
+
+  CouNumber viol = fabs (w0 - eval (x0));
+
+  brDist [0] = brDist [1] = CoinMax (viol, COUENNE_EPS);
+
+  return viol;
+}
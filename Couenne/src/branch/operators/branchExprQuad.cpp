@@ -118,7 +118,7 @@ CouNumber exprQuad::selectBranch (const CouenneObject *obj,
 
     CouNumber max_span = -COUENNE_INFINITY;
 
-    for (std::map <exprVar *, std::pair <CouNumber, CouNumber> >::iterator i = bounds_. begin ();
+    for (std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > >::iterator i = bounds_. begin ();
 	 i != bounds_. end (); ++i) {
 
       CouNumber
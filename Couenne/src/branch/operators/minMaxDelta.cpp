@@ -95,4 +95,19 @@ CouNumber maxHeight (funtriplet *ft, CouNumber lb, CouNumber ub) {
   return (ft -> FpInv ((ft -> F (ub) - ft -> F (lb)) / (ub - lb)));
 }
 
+
+/// Branching point for a variable with LP value x0 and bounds
+/// [lb,ub]: zero or away from the finite bound if unbounded,
+/// otherwise the LP point, unless it is too close to a bound
+CouNumber boxBranchPoint (CouNumber x0, CouNumber lb, CouNumber ub) {
+
+  if ((lb < -COUENNE_INFINITY) && (ub > COUENNE_INFINITY)) return 0.;
+  if  (lb < -COUENNE_INFINITY) return (ub > 1.)  ? 0. : 2 * -fabs (ub) - 1.;
+  if  (ub >  COUENNE_INFINITY) return (lb < -1.) ? 0. : 2 *  fabs (lb) + 1.;
+
+  CouNumber margin = .1 * (ub - lb);
+
+  return CoinMax (lb + margin, CoinMin (ub - margin, x0));
+}
+
 }
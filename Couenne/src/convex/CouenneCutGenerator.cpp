@@ -8,7 +8,10 @@
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
+#include <algorithm>
+
 #include "CglCutGenerator.hpp"
+#include "OsiClpSolverInterface.hpp"
 
 #include "CouenneCutGenerator.hpp"
 
@@ -41,7 +44,9 @@ CouenneCutGenerator::CouenneCutGenerator (Bonmin::OsiTMINLPInterface *nlp,
   BabPtr_         (NULL),
   infeasNode_     (false),
   jnlst_          (base ? base -> journalist () : NULL),
-  rootTime_       (-1.) {
+  rootTime_       (-1.),
+  recordRoot_     (false),
+  multiLinLP_     (NULL) {
 
   if (base) {
 
@@ -63,6 +68,9 @@ CouenneCutGenerator::CouenneCutGenerator (Bonmin::OsiTMINLPInterface *nlp,
     base -> options () -> GetStringValue ("enable_lp_implied_bounds", s, "couenne.");
     enable_lp_implied_bounds_ = (s == "yes");
 
+    base -> options () -> GetStringValue ("node_presolve", s, "couenne.");
+    nodePresolve_ = (s == "yes");
+
   } else {
 
     nSamples_                 = 4;
@@ -70,6 +78,7 @@ CouenneCutGenerator::CouenneCutGenerator (Bonmin::OsiTMINLPInterface *nlp,
     addviolated_              = true;
     check_lp_                 = false;
     enable_lp_implied_bounds_ = false;
+    nodePresolve_             = false;
   }
 
   lastPrintLine = -1;
@@ -80,8 +89,13 @@ CouenneCutGenerator::CouenneCutGenerator (Bonmin::OsiTMINLPInterface *nlp,
 
 
 /// destructor
-CouenneCutGenerator::~CouenneCutGenerator ()
-{}//if (problem_) delete problem_;}
+CouenneCutGenerator::~CouenneCutGenerator () {
+
+  //if (problem_) delete problem_;
+
+  if (multiLinLP_)
+    delete multiLinLP_;
+}
 
 
 /// copy constructor
@@ -105,10 +119,30 @@ CouenneCutGenerator::CouenneCutGenerator (const CouenneCutGenerator &src):
   rootTime_    (src. rootTime_),
   check_lp_    (src. check_lp_),
   enable_lp_implied_bounds_ (src.enable_lp_implied_bounds_),
-  lastPrintLine(src.lastPrintLine)
+  lastPrintLine(src.lastPrintLine),
+  nodePresolve_ (src.nodePresolve_),
+  auxArgs_      (src.auxArgs_),
+  recordRoot_   (src.recordRoot_),
+  rootLb_       (src.rootLb_),
+  rootUb_       (src.rootUb_),
+  rootCuts_     (src.rootCuts_),
+  rootEfficacy_ (src.rootEfficacy_),
+  multiLinLP_   (NULL)
 {}
 
 
+/// LP for multilinear facet separation, created at first use
+OsiClpSolverInterface *CouenneCutGenerator::multiLinLP () const {
+
+  if (!multiLinLP_) {
+    multiLinLP_ = new OsiClpSolverInterface;
+    multiLinLP_ -> messageHandler () -> setLogLevel (0);
+  }
+
+  return multiLinLP_;
+}
+
+
 #define MAX_SLOPE 1e3
 
 /// add half-space through two points (x1,y1) and (x2,y2)
@@ -185,6 +219,15 @@ void CouenneCutGenerator::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOp
      "no","",
      "yes","");
 
+  roptions -> AddStringOption2 
+    ("node_presolve",
+     "Simplify the convexification of nodes where some variables are fixed",
+     "no",
+     "no","",
+     "yes","",
+     "In the branch-and-bound tree, fixed variables are replaced by their value in the cuts generated at the node, "
+     "and the linearization of an auxiliary variable whose arguments are all fixed is replaced by bounds on it.");
+
   roptions -> AddStringOption2 
     ("enable_lp_implied_bounds",
      "Enable OsiSolverInterface::tightenBounds () -- warning: it has caused "
@@ -235,3 +278,56 @@ void CouenneCutGenerator::printLineInfo() const {
   }
   ***/
 } /* printLineInfo */
+
+
+/// Store bounds and new row cuts of a cut round at the root
+/// node. Bounds at the root are globally valid, and so are the cuts
+/// generated with them
+void CouenneCutGenerator::recordRoot (const OsiSolverInterface &si, 
+				      const OsiCuts &cs, 
+				      int nInitCuts) const {
+
+  int nVars = problem_ -> nVars ();
+
+  if (rootLb_.empty ()) {
+
+    rootLb_.assign (problem_ -> Lb (), problem_ -> Lb () + nVars);
+    rootUb_.assign (problem_ -> Ub (), problem_ -> Ub () + nVars);
+
+  } else 
+
+    for (int i=0; i<nVars; i++) {
+
+      if (problem_ -> Lb (i) > rootLb_ [i]) rootLb_ [i] = problem_ -> Lb (i);
+      if (problem_ -> Ub (i) < rootUb_ [i]) rootUb_ [i] = problem_ -> Ub (i);
+    }
+
+  const double *x = si.getColSolution ();
+
+  for (int i = nInitCuts; i < cs.sizeRowCuts (); i++) {
+
+    const OsiRowCut *cut = cs.rowCutPtr (i);
+
+    double norm = cut -> row (). twoNorm ();
+
+    rootCuts_.insert (*cut);
+    rootEfficacy_.push_back ((norm > COUENNE_EPS) ? cut -> violated (x) / norm : 0.);
+  }
+}
+
+
+/// Insert in cs the (at most) n root cuts with largest efficacy
+void CouenneCutGenerator::bestRootCuts (int n, OsiCuts &cs) const {
+
+  int nCuts = rootCuts_.sizeRowCuts ();
+
+  std::vector <std::pair <double, int> > order (nCuts);
+
+  for (int i=0; i<nCuts; i++)
+    order [i] = std::pair <double, int> (-rootEfficacy_ [i], i);
+
+  std::sort (order.begin (), order.end ());
+
+  for (int i=0; i < n && i < nCuts; i++)
+    cs.insert (*(rootCuts_.rowCutPtr (order [i].second)));
+}
@@ -39,10 +39,13 @@ namespace Bonmin {
 
 struct ASL;
 
+class OsiClpSolverInterface;
+
 namespace Couenne {
 
 class CouenneProblem;
 class funtriplet;
+class exprVar;
 
 /// Cut Generator for linear convexifications
 
@@ -107,6 +110,40 @@ class CouenneCutGenerator: public CglCutGenerator {
   /// Running count of printed info lines
   mutable int lastPrintLine;
 
+  /// Node presolve: substitute fixed variables in the (local) cuts
+  /// generated at a node, and replace the envelope of an auxiliary
+  /// whose arguments are all fixed with bounds on the auxiliary
+  bool nodePresolve_;
+
+  /// arguments of each auxiliary (for node presolve), computed at the
+  /// first call
+  mutable std::vector <std::vector <int> > auxArgs_;
+
+  /// Node presolve for auxiliary w: if all its arguments are fixed,
+  /// fix w to (an interval around) the value of its image through a
+  /// column cut and return true, so that no envelope is generated
+  bool presolveFixedAux (OsiCuts &, exprVar *w, t_chg_bounds *) const;
+
+  /// Record bounds and cuts of the root node (used by CouenneBab
+  /// for a restart)
+  bool recordRoot_;
+
+  /// bounds at the end of the last cut round at the root node
+  mutable std::vector <CouNumber> rootLb_;
+  mutable std::vector <CouNumber> rootUb_;
+
+  /// row cuts generated at the root node, and their efficacy
+  /// (violation over norm) at the LP point they were generated for
+  mutable OsiCuts               rootCuts_;
+  mutable std::vector <double>  rootEfficacy_;
+
+  /// LP used to separate facets of multilinear envelopes, reloaded
+  /// at every call (created at first use)
+  mutable OsiClpSolverInterface *multiLinLP_;
+
+  /// Store bounds and new row cuts of a cut round at the root node
+  void recordRoot (const OsiSolverInterface &, const OsiCuts &, int nInitCuts) const;
+
  public:
 
   /// constructor
@@ -260,6 +297,28 @@ class CouenneCutGenerator: public CglCutGenerator {
   /// returns value of enable_lp_implied_bounds_
   bool enableLpImpliedBounds () const
   {return enable_lp_implied_bounds_;}
+
+  /// return node_presolve flag
+  bool nodePresolve () const
+  {return nodePresolve_;}
+
+  /// start (or stop) recording bounds and cuts of the root node
+  void setRecordRoot (bool value)
+  {recordRoot_ = value;}
+
+  /// LP for multilinear facet separation, owned by this generator
+  OsiClpSolverInterface *multiLinLP () const;
+
+  /// lower bounds at the root node (empty if not recorded)
+  const std::vector <CouNumber> &rootLb () const
+  {return rootLb_;}
+
+  /// upper bounds at the root node (empty if not recorded)
+  const std::vector <CouNumber> &rootUb () const
+  {return rootUb_;}
+
+  /// Insert in cs the (at most) n root cuts with largest efficacy
+  void bestRootCuts (int n, OsiCuts &cs) const;
 };
 
 
@@ -0,0 +1,326 @@
+/* $Id$
+ *
+ * Name:    CouenneSepaCoordinator.cpp
+ * Author:  Pietro Belotti
+ * Purpose: run separators concurrently on the same LP solution
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include "CouenneConfig.h"
+
+#include "CoinTime.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "BonCbc.hpp"
+#include "BonBabInfos.hpp"
+
+#include "IpOptionsList.hpp"
+
+#include "CouenneSepaCoordinator.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneInfeasCut.hpp"
+
+#ifdef COUENNE_HAS_PTHREAD
+#include <pthread.h>
+#endif
+
+using namespace Ipopt;
+using namespace Couenne;
+
+namespace {
+
+  /// Call to one separator: input, output, and outcome
+  struct SepaJob {
+
+    CouenneSepaCoordinator::Member *member_;
+    const OsiSolverInterface       *si_;
+    const CglTreeInfo              *info_;
+    OsiCuts                         cs_;     ///< copy of the cuts of this round, then new cuts are appended
+    bool                            failed_; ///< true if the separator threw an exception
+  };
+
+  /// Jobs assigned to one thread: jobs_ [first_], jobs_ [first_ + step_], ...
+  struct SepaThread {
+
+    std::vector <SepaJob> *jobs_;
+    int first_;
+    int step_;
+  };
+
+  /// run one separator
+  void runJob (SepaJob &job) {
+
+    double now = CoinWallclockTime ();
+
+    try {
+      job.member_ -> cgl_ -> generateCuts (*(job.si_), job.cs_, *(job.info_));
+    }
+
+    catch (...) {
+      job.failed_ = true;
+    }
+
+    job.member_ -> time_ += CoinWallclockTime () - now;
+    ++ (job.member_ -> nCalls_);
+  }
+
+  /// thread function: run all jobs assigned to this thread
+  void *runJobs (void *arg) {
+
+    SepaThread *t = (SepaThread *) arg;
+
+    for (int i = t -> first_; i < (int) t -> jobs_ -> size (); i += t -> step_)
+      runJob ((*(t -> jobs_)) [i]);
+
+    return NULL;
+  }
+}
+
+
+/// constructor
+CouenneSepaCoordinator::CouenneSepaCoordinator (CouenneProblem *p,
+						JnlstPtr jnlst,
+						const Ipopt::SmartPtr <Ipopt::OptionsList> options):
+  problem_  (p),
+  jnlst_    (jnlst),
+  members_  (new std::vector <Member>),
+  refCount_ (new int (1)) {
+
+  options -> GetIntegerValue ("sepa_threads", nThreads_, "couenne.");
+}
+
+
+/// copy constructor
+CouenneSepaCoordinator::CouenneSepaCoordinator (const CouenneSepaCoordinator &src):
+
+  CglCutGenerator (src),
+  problem_        (src.problem_),
+  jnlst_          (src.jnlst_),
+  nThreads_       (src.nThreads_),
+  members_        (src.members_),
+  refCount_       (src.refCount_) {
+
+  ++ (*refCount_);
+}
+
+
+/// destructor
+CouenneSepaCoordinator::~CouenneSepaCoordinator () {
+
+  if (-- (*refCount_))
+    return;
+
+  for (std::vector <Member>::iterator i = members_ -> begin (); i != members_ -> end (); ++i) {
+
+    if (i -> nCalls_)
+      jnlst_ -> Printf (J_ITERSUMMARY, J_COUENNE, "Separators: %-30s %6d calls, %8d cuts, %10.3f seconds\n",
+			i -> id_.c_str (), i -> nCalls_, i -> nCuts_, i -> time_);
+
+    delete i -> cgl_;
+
+    if (i -> problem_)
+      delete i -> problem_;
+  }
+
+  delete members_;
+  delete refCount_;
+}
+
+
+/// add a separator
+void CouenneSepaCoordinator::addMember (CglCutGenerator *cgl,
+					int frequency,
+					const char *id,
+					CouenneProblem *problem) {
+  Member m;
+
+  m.cgl_       = cgl;
+  m.problem_   = problem;
+  m.frequency_ = frequency;
+  m.id_        = id;
+  m.effective_ = false;
+  m.nCalls_    = 0;
+  m.nCuts_     = 0;
+  m.time_      = 0.;
+
+  members_ -> push_back (m);
+}
+
+
+/// the main CglCutGenerator
+void CouenneSepaCoordinator::generateCuts (const OsiSolverInterface &si,
+					   OsiCuts &cs,
+					   const CglTreeInfo info)
+#if CGL_VERSION_MAJOR == 0 && CGL_VERSION_MINOR <= 57
+  const
+#endif
+  {
+
+  if (isWiped (cs))
+    return;
+
+  // node count, for the frequencies in the tree
+
+  int nNodes = 0;
+
+  Bonmin::BabInfo *babInfo = dynamic_cast <Bonmin::BabInfo *> (si.getAuxiliaryInfo ());
+
+  if (babInfo && babInfo -> babPtr ())
+    nNodes = babInfo -> babPtr () -> model (). getNodeCount ();
+
+  bool isRoot = (info.level <= 0);
+
+  // select separators to be run
+
+  std::vector <SepaJob> jobs;
+
+  for (std::vector <Member>::iterator i = members_ -> begin (); i != members_ -> end (); ++i) {
+
+    int freq = i -> frequency_;
+
+    if (!freq)
+      continue;
+
+    if (!isRoot) {
+
+      if (freq < 0) {
+
+	if ((freq <= -99) || !(i -> effective_))
+	  continue;
+
+	freq = -freq;
+      }
+
+      if (nNodes % freq)
+	continue;
+    }
+
+    // copy the state that the separators read from the problem
+
+    if (i -> problem_) {
+
+      i -> problem_ -> setMaxCpuTime            (problem_ -> getMaxCpuTime ());
+      i -> problem_ -> setFbbtReachedIterLimit (problem_ -> fbbtReachedIterLimit ());
+    }
+
+    SepaJob job;
+
+    job.member_ = &(*i);
+    job.si_     = &si;
+    job.info_   = &info;
+    job.failed_ = false;
+
+    jobs.push_back (job);
+  }
+
+  if (jobs.empty ())
+    return;
+
+  // each separator starts from the cuts generated so far in this round
+
+  for (std::vector <SepaJob>::iterator j = jobs.begin (); j != jobs.end (); ++j)
+    j -> cs_ = cs;
+
+  int
+    nJobs   = (int) jobs.size (),
+    nThreads = CoinMin (nThreads_, nJobs);
+
+#ifdef COUENNE_HAS_PTHREAD
+
+  if (nThreads > 1) {
+
+    // compute now what the LP solver only computes when asked, so
+    // that threads do not write into it
+
+    si.getMatrixByRow ();
+    si.getMatrixByCol ();
+    si.getRowSense ();
+    si.getRightHandSide ();
+    si.getRowRange ();
+
+    std::vector <SepaThread> threadData (nThreads);
+    std::vector <pthread_t>  threads    (nThreads);
+    std::vector <bool>       started    (nThreads, false);
+
+    // the calling thread runs the jobs of thread 0
+
+    for (int t=0; t<nThreads; t++) {
+
+      threadData [t].jobs_  = &jobs;
+      threadData [t].first_ = t;
+      threadData [t].step_  = nThreads;
+
+      if (t)
+	started [t] = !pthread_create (&(threads [t]), NULL, runJobs, &(threadData [t]));
+    }
+
+    runJobs (&(threadData [0]));
+
+    for (int t=1; t<nThreads; t++)
+      if (started [t])
+	pthread_join (threads [t], NULL);
+      else
+	runJobs (&(threadData [t])); // could not start thread, run its jobs here
+
+  } else
+
+#endif
+
+    for (int j=0; j<nJobs; j++)
+      runJob (jobs [j]);
+
+  // merge cuts in the order of the separators
+
+  int
+    nRowCuts = cs.sizeRowCuts (),
+    nColCuts = cs.sizeColCuts (),
+    nNewCuts = 0;
+
+  for (std::vector <SepaJob>::iterator j = jobs.begin (); j != jobs.end (); ++j) {
+
+    Member &m = *(j -> member_);
+
+    if (j -> failed_) {
+      jnlst_ -> Printf (J_WARNING, J_COUENNE, "Separators: %s failed, its cuts are discarded\n", m.id_.c_str ());
+      continue;
+    }
+
+    if (isWiped (j -> cs_)) { // infeasible node, nothing else matters
+
+      WipeMakeInfeas (cs);
+      m.effective_ = true;
+      return;
+    }
+
+    int nCuts = 0;
+
+    for (int i = nRowCuts; i < j -> cs_.sizeRowCuts (); i++, nCuts++) cs.insert (*(j -> cs_.rowCutPtr (i)));
+    for (int i = nColCuts; i < j -> cs_.sizeColCuts (); i++, nCuts++) cs.insert (*(j -> cs_.colCutPtr (i)));
+
+    m.nCuts_ += nCuts;
+    nNewCuts += nCuts;
+
+    if (isRoot && nCuts)
+      m.effective_ = true;
+  }
+
+  if (isRoot)
+    jnlst_ -> Printf (J_ITERSUMMARY, J_COUENNE, "Separators: %d run on %d threads, %d cuts\n",
+		      nJobs, nThreads, nNewCuts);
+}
+
+
+/// Add list of options to be read from file
+void CouenneSepaCoordinator::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("sepa_threads",
+     "Number of threads used to run separators concurrently.",
+     1, 1,
+     "If larger than 1, the fixed point, two-implied, SDP, and ellipsoidal separators "
+     "are run concurrently on the same LP solution, each on its own copy of the problem, "
+     "and their cuts are added to the cut round all at once. "
+     "The convexification and the disjunctive cuts are not affected. "
+     "Requires POSIX threads, otherwise the separators are run one after the other.");
+}
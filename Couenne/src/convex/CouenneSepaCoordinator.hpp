@@ -0,0 +1,137 @@
+/* $Id$
+ *
+ * Name:    CouenneSepaCoordinator.hpp
+ * Author:  Pietro Belotti
+ * Purpose: run separators concurrently on the same LP solution
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#ifndef COUENNESEPACOORDINATOR_HPP
+#define COUENNESEPACOORDINATOR_HPP
+
+#include <vector>
+#include <string>
+
+#include "BonRegisteredOptions.hpp"
+
+#include "CglConfig.h"
+#include "CglCutGenerator.hpp"
+#include "CouenneJournalist.hpp"
+
+namespace Ipopt {
+  template <class T> class SmartPtr;
+  class OptionsList;
+}
+
+namespace Couenne {
+
+  class CouenneProblem;
+
+  /// Cut generator that runs a set of separators concurrently, each
+  /// in its own thread, on the same LP solution. It replaces, in the
+  /// list of cut generators passed to Cbc, separators that only read
+  /// the LP solution and the bounds (fixed point FBBT, two-implied
+  /// bounds, SDP and ellipsoidal cuts). The convexification and the
+  /// disjunctive cuts, which modify the state of the problem, are
+  /// still called by Cbc directly.
+  ///
+  /// Each separator that uses a CouenneProblem has its own copy of
+  /// the problem, so that it can change bounds without interfering
+  /// with the others. All separators read the same LP solver (whose
+  /// lazily computed data is computed before the threads are started)
+  /// and a copy of the cuts generated so far in this round. Their cuts
+  /// are then added to the round in the order in which the separators
+  /// were added to the coordinator, so that the result does not depend
+  /// on the number of threads nor on which one finishes first.
+  ///
+  /// The frequency of each separator is interpreted as in Cbc: at the
+  /// root node, all separators with nonzero frequency are run; in the
+  /// tree, those with positive frequency k every k nodes, those with
+  /// negative frequency -k (k < 99) every k nodes if they generated
+  /// cuts or bounds at the root.
+  ///
+  /// Without POSIX threads, separators are run one after the other,
+  /// with the same result.
+
+  class CouenneSepaCoordinator: public CglCutGenerator {
+
+  public:
+
+    /// constructor
+    CouenneSepaCoordinator (CouenneProblem *,
+			    JnlstPtr,
+			    const Ipopt::SmartPtr <Ipopt::OptionsList>);
+
+    /// copy constructor. Separators are shared with the copy
+    CouenneSepaCoordinator  (const CouenneSepaCoordinator &);
+
+    /// destructor
+    ~CouenneSepaCoordinator ();
+
+    /// clone method (necessary for the abstract CglCutGenerator class)
+    CouenneSepaCoordinator *clone () const
+    {return new CouenneSepaCoordinator (*this);}
+
+    /// Add a separator with its frequency. If the separator uses a
+    /// CouenneProblem, this must be a copy of the main problem not
+    /// used by anything else. The coordinator becomes the owner of
+    /// both
+    void addMember (CglCutGenerator *cgl,
+		    int frequency,
+		    const char *id,
+		    CouenneProblem *problem = NULL);
+
+    /// number of separators
+    int nMembers () const
+    {return (int) members_ -> size ();}
+
+    /// number of threads
+    int nThreads () const
+    {return nThreads_;}
+
+    /// the main CglCutGenerator
+    void generateCuts (const OsiSolverInterface &,
+		       OsiCuts &,
+		       const CglTreeInfo = CglTreeInfo ())
+#if CGL_VERSION_MAJOR == 0 && CGL_VERSION_MINOR <= 57
+    const
+#endif
+    ;
+
+    /// Add list of options to be read from file
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+    /// A separator with its own copy of the problem
+    struct Member {
+
+      CglCutGenerator *cgl_;       ///< separator
+      CouenneProblem  *problem_;   ///< its copy of the problem (NULL if none)
+      int              frequency_; ///< frequency, as in Cbc
+      std::string      id_;        ///< name
+      bool             effective_; ///< true if it produced cuts or bounds at the root
+      int              nCalls_;    ///< number of calls
+      int              nCuts_;     ///< number of cuts (row and column) generated
+      double           time_;      ///< wallclock time spent
+    };
+
+  protected:
+
+    /// main problem, whose state is copied to the separators' problems
+    CouenneProblem *problem_;
+
+    /// Journalist
+    JnlstPtr jnlst_;
+
+    /// number of threads
+    int nThreads_;
+
+    /// separators, shared among copies of this object
+    std::vector <Member> *members_;
+
+    /// number of copies sharing members_
+    int *refCount_;
+  };
+}
+
+#endif
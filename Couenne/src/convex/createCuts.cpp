@@ -61,6 +61,46 @@ int CouenneCutGenerator::createCut (OsiCuts &cs,
   if (!nterms) // nonsense cut
     return 0;
 
+  // node presolve: in a local cut, replace fixed variables with their
+  // value (they remain fixed in the subtree where the cut is valid)
+
+  if (nodePresolve_ && !firstcall_ && !is_global) {
+
+    int       ind [3] = {i1, i2, i3};
+    CouNumber coe [3] = {c1, c2, c3};
+
+    int nFixed = 0;
+    CouNumber shift = 0.;
+
+    for (int j=0; j<3; j++)
+      if ((ind [j] >= 0) &&
+	  (problem_ -> Lb (ind [j]) == problem_ -> Ub (ind [j]))) {
+
+	shift += coe [j] * problem_ -> Lb (ind [j]);
+	coe [j] = 0.;
+	++nFixed;
+      }
+
+    if (nFixed == nterms) { // constant cut
+
+      if ((shift > lb - COUENNE_EPS) &&
+	  (shift < ub + COUENNE_EPS))
+	return 0; // satisfied, drop it
+
+      // otherwise the node is infeasible: keep the cut as it is and
+      // let the LP find out
+
+    } else if (nFixed) {
+
+      if (lb > -COUENNE_INFINITY) lb -= shift;
+      if (ub <  COUENNE_INFINITY) ub -= shift;
+
+      // zero coefficients are dropped, and a single remaining term
+      // gives a column cut
+      return createCut (cs, lb, ub, ind [0], coe [0], ind [1], coe [1], ind [2], coe [2], is_global);
+    }
+  }
+
   // cut has large coefficients/rhs, bail out
   if (numerics
       //|| ((fabs (lb) < COU_MIN_COEFF) || 
@@ -8,7 +8,10 @@
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
+#include <set>
+
 #include "CglCutGenerator.hpp"
+#include "OsiColCut.hpp"
 #include "CouenneCutGenerator.hpp"
 #include "CouenneProblem.hpp"
 #include "CouenneExprVar.hpp"
@@ -90,8 +93,68 @@ void CouenneCutGenerator::genRowCuts (const OsiSolverInterface &si,
 	if (CoinCpuTime () > problem_ -> getMaxCpuTime ())
 	  break;
 
+	if (nodePresolve_ && presolveFixedAux (cs, var, chg))
+	  continue;
+
 	var -> generateCuts (cs, this, chg);
       }
     }
   }
 }
+
+
+/// Node presolve for an auxiliary whose arguments are all fixed: its
+/// envelope reduces to w = f(x) with x fixed, i.e., bounds on w
+bool CouenneCutGenerator::presolveFixedAux (OsiCuts &cs, exprVar *w, t_chg_bounds *chg) const {
+
+  int n = problem_ -> nVars ();
+
+  if ((int) auxArgs_.size () != n) {
+
+    auxArgs_.clear ();
+    auxArgs_.resize (n);
+
+    for (int i=0; i<n; i++) {
+
+      exprVar *v = problem_ -> Var (i);
+
+      if (v -> Type () != AUX)
+	continue;
+
+      std::set <int> deplist;
+      v -> Image () -> DepList (deplist, STOP_AT_AUX);
+      auxArgs_ [i].assign (deplist.begin (), deplist.end ());
+    }
+  }
+
+  int ind = w -> Index ();
+
+  const std::vector <int> &args = auxArgs_ [ind];
+
+  for (std::vector <int>::const_iterator i = args.begin (); i != args.end (); ++i)
+    if (problem_ -> Ub (*i) - problem_ -> Lb (*i) > COUENNE_EPS)
+      return false;
+
+  // all arguments fixed: bounds of the image are (nearly) its value
+
+  CouNumber
+    &lb = problem_ -> Lb (ind),
+    &ub = problem_ -> Ub (ind),
+    lImg, uImg;
+
+  w -> Image () -> getBounds (lImg, uImg);
+
+  if (uImg - lImg > COUENNE_EPS)
+    return false; // image bounds not tight enough, use envelope
+
+  OsiColCut cut;
+
+  if (lImg > lb + COUENNE_EPS) {cut.setLbs (1, &ind, &lImg); lb = lImg; if (chg) chg [ind].setLower (t_chg_bounds::CHANGED);}
+  if (uImg < ub - COUENNE_EPS) {cut.setUbs (1, &ind, &uImg); ub = uImg; if (chg) chg [ind].setUpper (t_chg_bounds::CHANGED);}
+
+  if (cut.lbs ().getNumElements () ||
+      cut.ubs ().getNumElements ())
+    cs.insert (cut);
+
+  return true;
+}
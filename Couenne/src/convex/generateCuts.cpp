@@ -19,6 +19,10 @@
 #include "CouenneInfeasCut.hpp"
 
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneTrace.hpp"
+#include "CouenneProfile.hpp"
+#include "CouenneBTPerfIndicator.hpp"
+#include "CouenneStatus.hpp"
 
 //#define FM_PRINT_INFO
 
@@ -119,6 +123,8 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
      (CoinCpuTime () > problem_ -> getMaxCpuTime ()))
     return;
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_CONVEXIFICATION);
+
 #ifdef FM_TRACE_OPTSOL
   double currCutOff = problem_->getCutOff();
   double bestVal = 1e50;
@@ -195,6 +201,9 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 		    "generateCuts: level = %d, pass = %d, intree = %d\n",
 		    info.level, info.pass, info.inTree);
 
+  if (info.pass == 0)
+    CouenneTrace::event (CouenneTrace::TRACE_NODE, info.level, si.getObjValue ());
+
   Bonmin::BabInfo * babInfo = dynamic_cast <Bonmin::BabInfo *> (si.getAuxiliaryInfo ());
 
   if (babInfo)
@@ -320,7 +329,7 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
       }
     }
 
-    if (jnlst_ -> ProduceOutput (J_ITERSUMMARY, J_CONVEXIFYING)) {
+    if (COUENNE_TRACE (jnlst_, J_ITERSUMMARY, J_CONVEXIFYING)) {
       if (cs.sizeRowCuts ()) {
 	jnlst_ -> Printf (J_ITERSUMMARY, J_CONVEXIFYING,"Couenne: %d constraint row cuts\n",
 			  cs.sizeRowCuts ());
@@ -412,6 +421,16 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 //     }
 // #endif
 
+    // Orbits of the symmetries of this node, from the generators of
+    // the root group that preserve the current bounds
+
+    std::vector <int> symOrbit;
+
+    if (problem_ -> orbitalFixing () &&
+	problem_ -> nSymGenerators () &&
+	!firstcall_)
+      problem_ -> symOrbits (problem_ -> Lb (), problem_ -> Ub (), symOrbit);
+
     // Bound tightening ////////////////////////////////////
 
     /*printf ("== BT ================\n");
@@ -444,7 +463,7 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
     if ((problem_ -> doFBBT () ||
 	 problem_ -> doOBBT () ||
 	 problem_ -> doABT  ()) &&
-	(jnlst_ -> ProduceOutput (J_VECTOR, J_CONVEXIFYING))) {
+	(COUENNE_TRACE (jnlst_, J_VECTOR, J_CONVEXIFYING))) {
 
       jnlst_ -> Printf(J_VECTOR, J_CONVEXIFYING,"== after bt =============\n");
       for (int i = 0; i < problem_ -> nVars (); i++)
@@ -456,12 +475,23 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 
     // Use orbit info to tighten bounds
 
+    if (symOrbit.size ()) {
+
+      int nTighter = problem_ -> orbitalFixing (symOrbit, chg_bds);
+
+      if ((nTighter < 0) ||
+	  ((nTighter > 0) &&
+	   problem_ -> doFBBT () &&
+	   !(problem_ -> btCore (chg_bds))))
+	throw infeasible;
+    }
+
 #ifdef COIN_HAS_NTY
 
     // TODO: when independent bound tightener, can get original bounds
     // through si.getCol{Low,Upp}er()
 
-    if (problem_ -> orbitalBranching () && !firstcall_) {
+    else if (problem_ -> orbitalBranching () && !firstcall_) {
 
       CouNumber 
 	*lb = problem_ -> Lb (),
@@ -480,7 +510,7 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 	if (orbit.size () <= 1)
 	  continue; // not much to do when only one variable in this orbit
 
-	if (jnlst_ -> ProduceOutput (J_VECTOR, J_BOUNDTIGHTENING)) {
+	if (COUENNE_TRACE (jnlst_, J_VECTOR, J_BOUNDTIGHTENING)) {
 	  printf ("orbit bounds: "); fflush (stdout);
 	  for(int j = 0; j < orbit.size (); j++) {
 	    printf ("x_%d [%g,%g] ", orbit[j], lb [orbit [j]], ub [orbit [j]]);
@@ -537,13 +567,15 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
       int logAbtLev = problem_ -> logAbtLev ();
 
       if (problem_ -> doABT () &&             // flag is checked, AND
-	  ((logAbtLev != 0) ||                // (parameter is nonzero OR
-	   (info.level == 0)) &&              //  we are at root node), AND
 	  (info.pass == 0) &&                 // at first round of cuts, AND 
-	  ((logAbtLev < 0) ||                 // (logAbtLev = -1, OR
-	   (info.level <= logAbtLev) ||       //  depth is lower than COU_OBBT_CUTOFF_LEVEL, OR
-	   (CoinDrand48 () <                  //  probability inversely proportional to the level)
-	    pow (2., (double) logAbtLev - (info.level + 1))))) {
+	  problem_ -> abtPerfIndicator () -> run // the adaptive schedule (if any) says so, or
+	  (info.level,
+	   ((logAbtLev != 0) ||                // (parameter is nonzero OR
+	    (info.level == 0)) &&              //  we are at root node), AND
+	   ((logAbtLev < 0) ||                 // (logAbtLev = -1, OR
+	    (info.level <= logAbtLev) ||       //  depth is lower than COU_OBBT_CUTOFF_LEVEL, OR
+	    (CoinDrand48 () <                  //  probability inversely proportional to the level)
+	     pow (2., (double) logAbtLev - (info.level + 1)))))) {
 
 	jnlst_ -> Printf(J_VECTOR, J_BOUNDTIGHTENING,"  performing ABT\n");
 	if (! (problem_ -> aggressiveBT (nlp_, chg_bds, info, babInfo)))
@@ -577,7 +609,7 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
       problem_ -> getAuxs (problem_ -> domain () -> x ());
       }
 
-      if (jnlst_ -> ProduceOutput (J_VECTOR, J_CONVEXIFYING)) {
+      if (COUENNE_TRACE (jnlst_, J_VECTOR, J_CONVEXIFYING)) {
 	jnlst_ -> Printf(J_VECTOR, J_CONVEXIFYING,"== genrowcuts on NLP =============\n");
 	for (int i = 0; i < problem_ -> nVars (); i++)
 	  if (problem_ -> Var (i) -> Multiplicity () > 0)
@@ -601,7 +633,7 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 
     } else {
 
-      if (jnlst_ -> ProduceOutput (J_VECTOR, J_CONVEXIFYING)) {
+      if (COUENNE_TRACE (jnlst_, J_VECTOR, J_CONVEXIFYING)) {
 	jnlst_ -> Printf(J_VECTOR, J_CONVEXIFYING,"== genrowcuts on LP =============\n");
 	for (int i = 0; i < problem_ -> nVars (); i++)
 	  if (problem_ -> Var (i) -> Multiplicity () > 0)
@@ -637,6 +669,7 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 			"Couenne: Infeasible node\n");
 
       WipeMakeInfeas (cs);
+      timer.pruned ();
     }
 
     if (babInfo) // set infeasibility to true in order to skip NLP heuristic
@@ -661,6 +694,11 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 
   } else { 
 
+    if (recordRoot_ &&         // a restart will need bounds and cuts
+	!(info.inTree) &&      // of the root node
+	!isWiped (cs))
+      recordRoot (si, cs, nInitCuts);
+
     problem_ -> domain () -> pop ();
 
     ntotalcuts_ += (cs.sizeRowCuts () - nInitCuts);
@@ -671,7 +709,12 @@ void CouenneCutGenerator::generateCuts (const OsiSolverInterface &si,
 
   septime_ += CoinCpuTime () - now;
 
-  if (jnlst_ -> ProduceOutput (J_ITERSUMMARY, J_CONVEXIFYING)) {
+  timer.cuts (cs.sizeRowCuts () - nInitCuts);
+
+  CouenneTrace::event (CouenneTrace::TRACE_CUTROUND, cs.sizeRowCuts () - nInitCuts, si.getObjValue ());
+  CouenneStatus::tick ();
+
+  if (COUENNE_TRACE (jnlst_, J_ITERSUMMARY, J_CONVEXIFYING)) {
 
     if (cs.sizeColCuts ()) {
       jnlst_ -> Printf (J_ITERSUMMARY, J_CONVEXIFYING,"Couenne col cuts:\n");
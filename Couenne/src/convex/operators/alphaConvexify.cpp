@@ -62,7 +62,7 @@ bool exprQuad::alphaConvexify (const CouenneProblem *p) {
 
   bool changed_bounds = false;
 
-  for (std::map <exprVar *, std::pair <CouNumber, CouNumber> >::iterator i = bounds_.begin ();
+  for (std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > >::iterator i = bounds_.begin ();
        i != bounds_.end (); ++i, k++) {
 
 #ifdef DEBUG
@@ -9,10 +9,14 @@
  */
 
 #include <queue>
+#include <vector>
+
+#include "CoinHelperFunctions.hpp"
 
 #include "CouenneTypes.hpp"
 #include "CouenneExprMul.hpp"
 #include "CouenneExprTrilinear.hpp"
+#include "CouenneExprMultiLin.hpp"
 #include "CouenneExprBMul.hpp"
 #include "CouenneExprConst.hpp"
 #include "CouenneExprPow.hpp"
@@ -260,6 +264,61 @@ exprAux *exprMul::standardize (CouenneProblem *p, bool addAux) {
 
   // ----------------------------------------------------------------------------------------------
 
+  case Couenne::multilin: {
+
+    // The product is kept as a single multilinear term, whose
+    // envelopes are separated exactly. As separation is exponential
+    // in the number of factors, longer products are split into
+    // consecutive chunks of at most COU_MULTILIN_MAX_FACTORS factors
+    // (in the order of their indices, so that common subsequences of
+    // different products give the same auxiliary), then the product
+    // of the chunks is split again, until a single term is left.
+
+    qsort (arglist_, nargs_, sizeof (expression*), compareExpr);
+
+    std::vector <expression *> factors (arglist_, arglist_ + nargs_);
+
+    while ((int) factors.size () > COU_MULTILIN_MAX_FACTORS) {
+
+      std::vector <expression *> chunks;
+
+      for (int i = 0, n = (int) factors.size (); i < n; i += COU_MULTILIN_MAX_FACTORS) {
+
+	int nChunk = CoinMin (COU_MULTILIN_MAX_FACTORS, n - i);
+
+	if (nChunk == 1) {
+	  chunks.push_back (factors [i]);
+	  continue;
+	}
+
+	expression **al = new expression * [nChunk];
+
+	for (int j=0; j<nChunk; j++)
+	  al [j] = new exprClone (factors [i+j]);
+
+	chunks.push_back (p -> addAuxiliary ((nChunk == 2) ?
+					     (expression *) new exprMul (al, 2) :
+					     (expression *) new exprMultiLin (al, nChunk)));
+      }
+
+      factors = chunks;
+    }
+
+    int nFactors = (int) factors.size ();
+
+    expression **al = new expression * [nFactors];
+
+    for (int j=0; j<nFactors; j++)
+      al [j] = new exprClone (factors [j]);
+
+    retExpr = (nFactors == 2) ?
+      (expression *) new exprMul      (al, 2) :
+      (expression *) new exprMultiLin (al, nFactors);
+
+  } break;
+
+  // ----------------------------------------------------------------------------------------------
+
   case Couenne::rAI:
   default:
 
@@ -0,0 +1,294 @@
+/* $Id$
+ *
+ * Name:    conv-exprMultiLin.cpp
+ * Author:  Pietro Belotti
+ * Purpose: standardization and convexification methods for
+ *          multilinear terms
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+#include <vector>
+
+#include "OsiRowCut.hpp"
+#include "OsiCuts.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "CoinPackedVector.hpp"
+#include "CoinPackedMatrix.hpp"
+
+#include "CouenneCutGenerator.hpp"
+
+#include "CouenneTypes.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneExprMultiLin.hpp"
+#include "CouenneExprAux.hpp"
+
+using namespace Couenne;
+
+// Create standard formulation of this expression
+
+exprAux *exprMultiLin::standardize (CouenneProblem *p, bool addAux) {
+
+  exprOp::standardize (p);
+
+  return (addAux ? (p -> addAuxiliary (this)) : new exprAux (this, p -> domain ()));
+}
+
+
+/// Find the facet of the convex (if upper is false) or concave
+/// envelope of f(x) = c x_1 x_2 ... x_n on the box [l,u] that
+/// supports the envelope at x0.
+///
+/// The envelopes of a multilinear function on a box are determined
+/// by its values at the 2^n vertices of the box [Rikun 1997], hence
+/// the facet is the optimal solution (a,b) of the LP
+///
+/// max {a x0 + b: a v + b <= f(v) for all vertices v}
+///
+/// (min and >= for the concave envelope), whose constraints are
+/// loaded in lp by the caller. As f - ax is multilinear too, the
+/// intercept is then recomputed as the minimum (maximum) of f(v) - av
+/// over all vertices, which makes the cut valid regardless of the
+/// accuracy of the LP solution.
+
+static bool envelopeFacet (OsiClpSolverInterface &lp,
+			   int n,
+			   const std::vector <CouNumber> &vertices,
+			   const std::vector <CouNumber> &fv,
+			   const CouNumber *x0,
+			   bool upper,
+			   CouNumber *a,
+			   CouNumber &b) {
+
+  int nVert = (int) fv.size ();
+
+  for (int k=0; k<nVert; k++)
+    if (upper) lp.setRowBounds (k, fv [k], COIN_DBL_MAX);
+    else       lp.setRowBounds (k, -COIN_DBL_MAX, fv [k]);
+
+  for (int i=0; i<n; i++)
+    lp.setObjCoeff (i, x0 [i]);
+
+  lp.setObjCoeff (n, 1.);
+  lp.setObjSense (upper ? 1. : -1.);
+
+  lp.initialSolve ();
+
+  if (!(lp.isProvenOptimal ()))
+    return false;
+
+  CoinCopyN (lp.getColSolution (), n, a);
+
+  for (int i=0; i<n; i++)
+    if (fabs (a [i]) > COU_MAX_COEFF)
+      return false;
+
+  b = upper ? -COIN_DBL_MAX : COIN_DBL_MAX;
+
+  for (int k=0; k<nVert; k++) {
+
+    CouNumber rest = fv [k];
+
+    for (int i=0; i<n; i++)
+      rest -= a [i] * vertices [k*n + i];
+
+    if (upper) {if (rest > b) b = rest;}
+    else       {if (rest < b) b = rest;}
+  }
+
+  return (fabs (b) < COUENNE_INFINITY);
+}
+
+
+// generate convexification cuts for constraint w = c x_1 x_2 ... x_n:
+// facets of the convex and concave envelope on the current bounding
+// box, separated at the current point (and, at the first call, at the
+// center of the box). As w = f(x) on the vertices of the box, a
+// facet can only be violated when w is not equal to f(x), which is
+// checked before solving any LP.
+
+void exprMultiLin::generateCuts (expression *w,
+				 OsiCuts &cs, const CouenneCutGenerator *cg,
+				 t_chg_bounds *chg, int wind,
+				 CouNumber lbw, CouNumber ubw) {
+  int w_ind = w -> Index ();
+
+  enum auxSign sign = cg -> Problem () -> Var (w_ind) -> sign ();
+
+  // fold constant factors into c, collect bounds of the others
+
+  CouNumber c = 1.;
+
+  std::vector <int>       ind;
+  std::vector <CouNumber> xl, xu, x0;
+
+  bool bounded = true;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int index = arglist_ [i] -> Index ();
+
+    if (index < 0) {
+      c *= arglist_ [i] -> Value ();
+      continue;
+    }
+
+    CouNumber l, u;
+    arglist_ [i] -> getBounds (l, u);
+
+    if ((l < -COUENNE_INFINITY) ||
+	(u >  COUENNE_INFINITY))
+      bounded = false;
+
+    ind.push_back (index);
+    xl. push_back (l);
+    xu. push_back (u);
+    x0. push_back (CoinMax (l, CoinMin (u, (*(arglist_ [i])) ())));
+  }
+
+  int n = (int) ind.size ();
+
+  if (n == 0) {cg -> createCut (cs, c, sign, w_ind, 1.);                return;} // w = c
+  if (n == 1) {cg -> createCut (cs, 0., sign, w_ind, 1., ind [0], -c); return;} // w = c x
+
+  if (!bounded ||
+      (n > COU_MULTILIN_MAX_FACTORS) ||
+      (fabs (c) < COUENNE_EPS))
+    return;
+
+  bool
+    first    = cg -> isFirst (),
+    doLower  = (sign != expression::AUX_LEQ),
+    doUpper  = (sign != expression::AUX_GEQ);
+
+  CouNumber
+    w0 = (*w) (),
+    f0 = c;
+
+  for (int i=0; i<n; i++)
+    f0 *= x0 [i];
+
+  // w = f(x) at the current point: no facet is violated
+
+  if (!first && (w0 > f0 - COUENNE_EPS)) doLower = false;
+  if (!first && (w0 < f0 + COUENNE_EPS)) doUpper = false;
+
+  if (!doLower && !doUpper)
+    return;
+
+  // vertices of the box and values of f on them
+
+  int nVert = 1 << n;
+
+  std::vector <CouNumber>
+    vertices (nVert * n),
+    fv       (nVert);
+
+  std::vector <int>       rowInd, colInd;
+  std::vector <CouNumber> elem;
+
+  for (int k=0; k<nVert; k++) {
+
+    CouNumber f = c;
+
+    for (int i=0; i<n; i++) {
+
+      CouNumber v = ((k >> i) & 1) ? xu [i] : xl [i];
+
+      vertices [k*n + i] = v;
+      f *= v;
+
+      if (v != 0.) {
+	rowInd. push_back (k);
+	colInd. push_back (i);
+	elem.   push_back (v);
+      }
+    }
+
+    fv [k] = f;
+
+    rowInd. push_back (k);
+    colInd. push_back (n);
+    elem.   push_back (1.);
+  }
+
+  CoinPackedMatrix matrix (false, &(rowInd [0]), &(colInd [0]), &(elem [0]), (CoinBigIndex) elem.size ());
+
+  std::vector <CouNumber>
+    colLB (n+1, -COIN_DBL_MAX),
+    colUB (n+1,  COIN_DBL_MAX),
+    obj   (n+1, 0.),
+    rowLB (nVert, -COIN_DBL_MAX),
+    rowUB (fv);
+
+  // reload the LP kept by the cut generator rather than building a new one
+
+  OsiClpSolverInterface &lp = *(cg -> multiLinLP ());
+
+  lp.loadProblem (matrix, &(colLB [0]), &(colUB [0]), &(obj [0]), &(rowLB [0]), &(rowUB [0]));
+
+  // points where to separate: current point and, at the beginning,
+  // the center of the box
+
+  std::vector <std::vector <CouNumber> > points (1, x0);
+
+  if (first) {
+
+    std::vector <CouNumber> center (n);
+
+    for (int i=0; i<n; i++)
+      center [i] = .5 * (xl [i] + xu [i]);
+
+    points.push_back (center);
+  }
+
+  CouNumber *a = new CouNumber [n];
+
+  for (std::vector <std::vector <CouNumber> >::iterator p = points.begin (); p != points.end (); ++p)
+
+    for (int side = 0; side < 2; side++) {
+
+      bool upper = (side == 1);
+
+      if (( upper && !doUpper) ||
+	  (!upper && !doLower))
+	continue;
+
+      CouNumber b;
+
+      if (!envelopeFacet (lp, n, vertices, fv, &((*p) [0]), upper, a, b))
+	continue;
+
+      // cut is w - a x >= b (<= b for the concave envelope)
+
+      CouNumber lhs = w0;
+
+      CoinPackedVector row;
+
+      row.insert (w_ind, 1.);
+
+      for (int i=0; i<n; i++)
+	if (fabs (a [i]) > 1.e-21) { // see createCuts.cpp
+	  row.insert (ind [i], -a [i]);
+	  lhs -= a [i] * cg -> Problem () -> X (ind [i]);
+	}
+
+      if (!first &&
+	  cg -> addViolated () &&
+	  (( upper && (lhs < b + COUENNE_EPS)) ||
+	   (!upper && (lhs > b - COUENNE_EPS))))
+	continue;
+
+      OsiRowCut cut;
+
+      cut.setRow (row);
+
+      if (upper) cut.setUb (b);
+      else       cut.setLb (b);
+
+      cs.insert (cut);
+    }
+
+  delete [] a;
+}
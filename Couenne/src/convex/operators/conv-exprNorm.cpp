@@ -0,0 +1,265 @@
+/* $Id$
+ *
+ * Name:    conv-exprNorm.cpp
+ * Author:  Pietro Belotti
+ * Purpose: standardization and convexification methods for the
+ *          Euclidean norm
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+#include <map>
+
+#include "OsiRowCut.hpp"
+#include "OsiCuts.hpp"
+#include "CoinPackedVector.hpp"
+
+#include "CouenneCutGenerator.hpp"
+
+#include "CouenneTypes.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneExprNorm.hpp"
+#include "CouenneExprAux.hpp"
+
+using namespace Couenne;
+
+/// maximum number of arguments for which all 2^n directions
+/// \f$ (\pm 1, \pm 1 \ldots \pm 1) \f$ are used in the initial
+/// polyhedral approximation of the cone
+#define MAX_ARGS_INIT_DIRECTIONS 3
+
+
+// Create standard formulation of this expression
+
+exprAux *exprNorm::standardize (CouenneProblem *p, bool addAux) {
+
+  exprOp::standardize (p);
+
+  return (addAux ? (p -> addAuxiliary (this)) : new exprAux (this, p -> domain ()));
+}
+
+
+/// insert cut lb <= \sum_{j} coe [j] x_j <= ub, unless it has bad
+/// coefficients or (if only violated cuts are requested) it is
+/// satisfied by the current point
+
+static void addNormCut (OsiCuts &cs, const CouenneCutGenerator *cg,
+			const std::map <int, CouNumber> &coe,
+			CouNumber lb, CouNumber ub, bool global) {
+
+  if ((fabs (lb) > COU_MAX_COEFF) &&
+      (fabs (ub) > COU_MAX_COEFF))
+    return;
+
+  CoinPackedVector row (false);
+  row.reserve ((int) coe.size ());
+
+  CouNumber lhs = 0.;
+
+  const CouNumber *x = cg -> Problem () -> X ();
+
+  for (std::map <int, CouNumber>::const_iterator i = coe.begin (); i != coe.end (); ++i) {
+
+    if (fabs (i -> second) > COU_MAX_COEFF)
+      return;
+
+    if (fabs (i -> second) > 1.e-21) { // see createCuts.cpp
+      row.insert (i -> first, i -> second);
+      lhs += i -> second * x [i -> first];
+    }
+  }
+
+  if (row.getNumElements () < 2) // only w left, nothing to separate
+    return;
+
+  if (!(cg -> isFirst ()) &&
+      cg -> addViolated () &&
+      (lhs < ub + COUENNE_EPS) &&
+      (lhs > lb - COUENNE_EPS))
+    return;
+
+  OsiRowCut cut;
+
+  cut.setRow (row);
+
+  if (lb > -COUENNE_INFINITY) cut.setLb (lb);
+  if (ub <  COUENNE_INFINITY) cut.setUb (ub);
+
+  cut.setGloballyValid (global);
+
+  cs.insert (cut);
+}
+
+
+// generate convexification cuts for constraint w = ||x||_2
+//
+// The convex side w >= ||x|| is approximated by tangents to the
+// second-order cone: at the first call by the planes w >= |x_i| (and,
+// for few arguments, the planes w >= (\pm x_1 \pm x_2 ... \pm x_n) /
+// \sqrt n), then by the tangent at the current point. The concave
+// side w <= ||x|| is overestimated, for finite bounds, by the
+// linearization of the concave function \sqrt {\sum_i (l_i+u_i) x_i -
+// l_i u_i}, which is an upper bound on ||x|| in the bounding box.
+
+void exprNorm::generateCuts (expression *w,
+			     OsiCuts &cs, const CouenneCutGenerator *cg,
+			     t_chg_bounds *chg, int wind,
+			     CouNumber lbw, CouNumber ubw) {
+
+  int w_ind = w -> Index ();
+
+  enum auxSign sign = cg -> Problem () -> Var (w_ind) -> sign ();
+
+  // current point and number of nonconstant arguments
+
+  CouNumber
+    *x0   = new CouNumber [nargs_],
+    norm0 = 0.;
+
+  int nVarArgs = 0;
+
+  for (int i=0; i<nargs_; i++) {
+
+    x0 [i] = (*(arglist_ [i])) ();
+    norm0 += x0 [i] * x0 [i];
+
+    if (arglist_ [i] -> Index () >= 0)
+      ++nVarArgs;
+  }
+
+  norm0 = sqrt (norm0);
+
+  if (!nVarArgs) {
+    delete [] x0;
+    return;
+  }
+
+  std::map <int, CouNumber> coe;
+
+  if (sign != expression::AUX_LEQ) { // w >= ||x||
+
+    if (cg -> isFirst ()) {
+
+      // w >= x_i, w >= -x_i
+
+      for (int i=0; i<nargs_; i++) {
+
+	int ind = arglist_ [i] -> Index ();
+
+	if (ind < 0)
+	  continue;
+
+	for (int s = -1; s <= 1; s += 2) {
+	  coe.clear ();
+	  coe [w_ind]  = 1.;
+	  coe [ind]   -= s;
+	  addNormCut (cs, cg, coe, 0., COIN_DBL_MAX, true);
+	}
+      }
+
+      // w >= (\pm x_1 \pm x_2 ... \pm x_n) / \sqrt n
+
+      if ((nVarArgs > 1) &&
+	  (nVarArgs <= MAX_ARGS_INIT_DIRECTIONS)) {
+
+	CouNumber c = 1. / sqrt ((double) nVarArgs);
+
+	for (int signs = 0; signs < (1 << nVarArgs); signs++) {
+
+	  coe.clear ();
+	  coe [w_ind] = 1.;
+
+	  for (int i=0, k=0; i<nargs_; i++) {
+
+	    int ind = arglist_ [i] -> Index ();
+
+	    if (ind >= 0)
+	      coe [ind] -= ((signs >> k++) & 1) ? c : -c;
+	  }
+
+	  addNormCut (cs, cg, coe, 0., COIN_DBL_MAX, true);
+	}
+      }
+    }
+
+    // tangent at x0: w >= \sum_i x0_i / ||x0|| x_i
+
+    if (norm0 > COUENNE_EPS) {
+
+      CouNumber rhs = 0.;
+
+      coe.clear ();
+      coe [w_ind] = 1.;
+
+      for (int i=0; i<nargs_; i++) {
+
+	int ind = arglist_ [i] -> Index ();
+
+	CouNumber a = x0 [i] / norm0;
+
+	if (ind < 0) rhs       += a * x0 [i];
+	else         coe [ind] -= a;
+      }
+
+      addNormCut (cs, cg, coe, rhs, COIN_DBL_MAX, true);
+    }
+  }
+
+  if (sign != expression::AUX_GEQ) { // w <= ||x||
+
+    // x_i^2 <= (l_i+u_i) x_i - l_i u_i within [l_i,u_i], hence
+    //
+    // ||x|| <= sqrt (S(x)),   S(x) = \sum_i (l_i+u_i) x_i - l_i u_i
+    //
+    // and by concavity of sqrt, ||x|| <= (S(x0) + S(x)) / (2 sqrt (S(x0)))
+
+    CouNumber
+      *l = new CouNumber [nargs_],
+      *u = new CouNumber [nargs_],
+      S0 = 0.,
+      L  = 0.;
+
+    bool finite = true;
+
+    for (int i=0; i<nargs_ && finite; i++) {
+
+      arglist_ [i] -> getBounds (l [i], u [i]);
+
+      if ((l [i] < -COUENNE_INFINITY) ||
+	  (u [i] >  COUENNE_INFINITY))
+	finite = false;
+      else {
+	S0 += (l [i] + u [i]) * x0 [i] - l [i] * u [i];
+	L  +=  l [i] * u [i];
+      }
+    }
+
+    if (finite && (S0 > COUENNE_EPS)) {
+
+      CouNumber
+	sqS0 = 2. * sqrt (S0),
+	rhs  = (S0 - L) / sqS0;
+
+      coe.clear ();
+      coe [w_ind] = 1.;
+
+      for (int i=0; i<nargs_; i++) {
+
+	int ind = arglist_ [i] -> Index ();
+
+	CouNumber a = (l [i] + u [i]) / sqS0;
+
+	if (ind < 0) rhs       += a * x0 [i];
+	else         coe [ind] -= a;
+      }
+
+      addNormCut (cs, cg, coe, -COIN_DBL_MAX, rhs, false);
+    }
+
+    delete [] l;
+    delete [] u;
+  }
+
+  delete [] x0;
+}
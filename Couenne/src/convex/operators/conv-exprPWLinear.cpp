@@ -0,0 +1,196 @@
+/* $Id$
+ *
+ * Name:    conv-exprPWLinear.cpp
+ * Author:  Pietro Belotti
+ * Purpose: standardization and convexification methods for
+ *          piecewise linear functions
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+
+#include "CouenneCutGenerator.hpp"
+
+#include "CouenneTypes.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneExprPWLinear.hpp"
+#include "CouenneExprAux.hpp"
+
+using namespace Couenne;
+
+// Create standard formulation of this expression
+
+exprAux *exprPWLinear::standardize (CouenneProblem *p, bool addAux) {
+
+  exprOp::standardize (p);
+
+  return (addAux ? (p -> addAuxiliary (this)) : new exprAux (this, p -> domain ()));
+}
+
+
+/// compute lines (slope, intercept) of the convex envelope of f on
+/// [l,u] (of the concave envelope if upper is true). The envelope of
+/// a piecewise linear function is the lower convex hull of the points
+/// (x,f(x)) with x in {l, u, breakpoints within [l,u]}, extended by
+/// the two half-lines if l or u are infinite. Return false if the
+/// envelope is unbounded
+
+bool exprPWLinear::envelope (CouNumber l, CouNumber u, bool upper,
+			     std::vector <std::pair <CouNumber, CouNumber> > &lines) const {
+
+  // the concave envelope of f is the opposite of the convex envelope of -f
+
+  CouNumber
+    mult = upper ? -1. : 1.,
+    sL   = mult * slopeL_,
+    sR   = mult * slopeR_;
+
+  bool
+    infL = (l < -COUENNE_INFINITY),
+    infR = (u >  COUENNE_INFINITY);
+
+  // points in increasing order of x; with equal x (jumps and bounds
+  // on a breakpoint) keep the lowest
+
+  std::vector <std::pair <CouNumber, CouNumber> > points;
+
+#define ADD_POINT(x,y) {						\
+    if (!points.empty () && (points.back (). first >= (x) - COUENNE_EPS)) { \
+      if ((y) < points.back (). second) points.back (). second = (y);	\
+    } else points.push_back (std::pair <CouNumber, CouNumber> (x, y));	\
+  }
+
+  if (!infL)
+    ADD_POINT (l, mult * eval (l));
+
+  for (int k = 0, K = (int) x_.size (); k < K; k++)
+    if ((x_ [k] > l) && (x_ [k] < u))
+      ADD_POINT (x_ [k], mult * y_ [k]);
+
+  if (!infR)
+    ADD_POINT (u, mult * eval (u));
+
+#undef ADD_POINT
+
+  if (points.empty ())
+    return false;
+
+  // lower convex hull (monotone chain)
+
+  std::vector <std::pair <CouNumber, CouNumber> > hull;
+
+  for (std::vector <std::pair <CouNumber, CouNumber> >::iterator p = points.begin (); p != points.end (); ++p) {
+
+    while (hull.size () >= 2) {
+
+      const std::pair <CouNumber, CouNumber>
+	&o = hull [hull.size () - 2],
+	&a = hull [hull.size () - 1];
+
+      if ((a.first - o.first) * (p -> second - o.second) -
+	  (a.second - o.second) * (p -> first - o.first) > 0.)
+	break;
+
+      hull.pop_back ();
+    }
+
+    hull.push_back (*p);
+  }
+
+  // half-lines: the envelope starts (ends) with slope sL (sR), hence
+  // drop initial (final) hull edges with smaller (larger) slope
+
+#define SLOPE(a,b) (((b).second - (a).second) / ((b).first - (a).first))
+
+  if (infL)
+    while ((hull.size () >= 2) && (SLOPE (hull [0], hull [1]) < sL))
+      hull.erase (hull.begin ());
+
+  if (infR)
+    while ((hull.size () >= 2) && (SLOPE (hull [hull.size () - 2], hull [hull.size () - 1]) > sR))
+      hull.pop_back ();
+
+  if (infL && infR && (hull.size () == 1) && (sL > sR)) // f unbounded from below
+    return false;
+
+  if (infL)
+    lines.push_back (std::pair <CouNumber, CouNumber> (sL, hull [0]. second - sL * hull [0]. first));
+
+  for (int i = 1; i < (int) hull.size (); i++) {
+
+    CouNumber s = SLOPE (hull [i-1], hull [i]);
+
+    if (!infL || (i > 1) || (s > sL + COUENNE_EPS)) // skip edge aligned with left half-line
+      lines.push_back (std::pair <CouNumber, CouNumber> (s, hull [i]. second - s * hull [i]. first));
+  }
+
+  if (infR && (lines.empty () || (sR > lines.back (). first + COUENNE_EPS)))
+    lines.push_back (std::pair <CouNumber, CouNumber> (sR, hull.back (). second - sR * hull.back (). first));
+
+#undef SLOPE
+
+  if (upper)
+    for (std::vector <std::pair <CouNumber, CouNumber> >::iterator i = lines.begin (); i != lines.end (); ++i) {
+      i -> first  = -i -> first;
+      i -> second = -i -> second;
+    }
+
+  return true;
+}
+
+
+// generate convexification cuts for constraint w = f(x), f piecewise
+// linear: all facets of the convex and concave envelopes of f on the
+// current bounding box of x
+
+void exprPWLinear::generateCuts (expression *w,
+				 OsiCuts &cs, const CouenneCutGenerator *cg,
+				 t_chg_bounds *chg, int wind,
+				 CouNumber lbw, CouNumber ubw) {
+  int
+    w_ind = w            -> Index (),
+    x_ind = arglist_ [0] -> Index ();
+
+  enum auxSign sign = cg -> Problem () -> Var (w_ind) -> sign ();
+
+  if (x_ind < 0) { // constant argument
+    cg -> createCut (cs, eval (arglist_ [0] -> Value ()), sign, w_ind, 1.);
+    return;
+  }
+
+  // envelopes only depend on the bounds of x
+
+  bool cbase = !chg || cg -> isFirst ();
+
+  if (!cbase &&
+      (chg [x_ind].lower () == t_chg_bounds::UNCHANGED) &&
+      (chg [x_ind].upper () == t_chg_bounds::UNCHANGED))
+    return;
+
+  CouNumber l, u;
+  arglist_ [0] -> getBounds (l, u);
+
+  if (u - l < COUENNE_EPS) { // fixed argument
+    cg -> createCut (cs, eval (.5 * (l+u)), sign, w_ind, 1.);
+    return;
+  }
+
+  std::vector <std::pair <CouNumber, CouNumber> > lines;
+
+  // w >= f(x): facets of convex envelope, w - s x >= c
+
+  if ((sign != expression::AUX_LEQ) &&
+      envelope (l, u, false, lines))
+    for (std::vector <std::pair <CouNumber, CouNumber> >::iterator i = lines.begin (); i != lines.end (); ++i)
+      cg -> createCut (cs, i -> second, +1, w_ind, 1., x_ind, - i -> first);
+
+  lines.clear ();
+
+  // w <= f(x): facets of concave envelope, w - s x <= c
+
+  if ((sign != expression::AUX_GEQ) &&
+      envelope (l, u, true, lines))
+    for (std::vector <std::pair <CouNumber, CouNumber> >::iterator i = lines.begin (); i != lines.end (); ++i)
+      cg -> createCut (cs, i -> second, -1, w_ind, 1., x_ind, - i -> first);
+}
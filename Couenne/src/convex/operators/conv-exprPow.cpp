@@ -25,6 +25,7 @@
 #include "CouenneExprMul.hpp"
 #include "CouenneExprSum.hpp"
 #include "CouenneExprLog.hpp"
+#include "CouenneExprNorm.hpp"
 #include "CouennePrecisions.hpp"
 #include "CouenneProblem.hpp"
 
@@ -63,8 +64,37 @@ exprAux *exprPow::standardize (CouenneProblem *p, bool addAux) {
 
   } else { // expression is x^k, return as it is
 
-    // TODO: check if it's of the form ||x||_k, as this admits a
-    // better (lower) convexification -- replace exprOp::standardize 
+    // check if it's of the form ||x||_2 = (\sum_i x_i^2)^(1/2), as
+    // this admits a better (lower) convexification
+
+    if (p -> useNorm () && 
+	!issignpower_ &&
+	(fabs (arglist_ [1] -> Value () - 0.5) < COUENNE_EPS_SIMPL) &&
+	(arglist_ [0] -> code () == COU_EXPRSUM) &&
+	(arglist_ [0] -> nArgs () > 1)) {
+
+      int n = arglist_ [0] -> nArgs ();
+      expression **al = arglist_ [0] -> ArgList ();
+
+      bool isNorm = true;
+
+      for (int i=0; i<n && isNorm; i++)
+	if ((al [i] -> code () != COU_EXPRPOW) ||
+	    (al [i] -> ArgList () [1] -> Type () != CONST) ||
+	    (fabs (al [i] -> ArgList () [1] -> Value () - 2.) > COUENNE_EPS_SIMPL))
+	  isNorm = false;
+
+      if (isNorm) {
+
+	expression **normArgs = new expression * [n];
+
+	for (int i=0; i<n; i++)
+	  normArgs [i] = al [i] -> ArgList () [0] -> clone ();
+
+	return (new exprNorm (normArgs, n)) -> standardize (p, addAux);
+      }
+    }
+
     exprOp::standardize (p);
 
     // if binary -- NO! Bounds not known yet
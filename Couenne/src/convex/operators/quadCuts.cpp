@@ -44,7 +44,7 @@ void exprQuad::quadCuts (expression *w, OsiCuts &cs, const CouenneCutGenerator *
 
   int index = 0;
 
-  for (std::map <exprVar *, std::pair <CouNumber, CouNumber> >::iterator i = bounds_.begin ();
+  for (std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > >::iterator i = bounds_.begin ();
        i != bounds_.end (); ++i, index++) {
 
     printf ("%3d:\t", index);
@@ -102,7 +102,7 @@ void exprQuad::quadCuts (expression *w, OsiCuts &cs, const CouenneCutGenerator *
 
     // there is a convexification, check if out of current point
 
-    for (std::map <exprVar *, std::pair <CouNumber, CouNumber> >::iterator i = bounds_.begin ();
+    for (std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > >::iterator i = bounds_.begin ();
 	 i != bounds_.end (); ++i) {
 
       int ind = i -> first -> Index ();
@@ -202,7 +202,7 @@ void exprQuad::quadCuts (expression *w, OsiCuts &cs, const CouenneCutGenerator *
 
   if (fabs (lambda) > COUENNE_EPS) // Now the part which depends on lambda, if there is one
 
-    for (std::map <exprVar *, std::pair <CouNumber, CouNumber> >::iterator i = bounds_.begin ();
+    for (std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > >::iterator i = bounds_.begin ();
 	 i != bounds_.end (); ++i) {
 
       int ind = i -> first -> Index ();
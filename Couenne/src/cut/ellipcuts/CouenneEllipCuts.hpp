@@ -1,8 +1,133 @@
+/* $Id$
+ *
+ * Name:    CouenneEllipCuts.hpp
+ * Author:  Pietro Belotti
+ * Purpose: Cuts for convex quadratic (e.g. ellipsoidal) constraints
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
 #ifndef CouenneEllipCuts_hpp
 #define CouenneEllipCuts_hpp
 
+#include <vector>
+
+#include "BonRegisteredOptions.hpp"
+
+#include "CglConfig.h"
+#include "CglCutGenerator.hpp"
+#include "OsiRowCut.hpp"
+#include "CouenneJournalist.hpp"
+#include "CouenneTypes.hpp"
+
+namespace Ipopt {
+  template <class T> class SmartPtr;
+  class OptionsList;
+}
+
 namespace Couenne {
 
+  class CouenneProblem;
+
+  /// A convex relation \f$ w \ge q(x) \f$, with \f$ q(x) = c_0 + b^T x
+  /// + x^T Q x \f$ and Q positive semidefinite, obtained from an
+  /// auxiliary \f$ w := q(x) \f$ (or from \f$ -w \ge -q(x) \f$ if q is
+  /// concave). Q is stored as a dense matrix on the variables of the
+  /// quadratic part, together with its spectral decomposition.
+
+  class CouenneEllipConstr {
+
+  public:
+
+    int                    wIndex_;  ///< index of the auxiliary variable w
+    CouNumber              mult_;    ///< 1 if q is convex, -1 if q is concave (then q := -q, w := -w)
+    CouNumber              c0_;      ///< constant term
+
+    std::vector <int>       linInd_; ///< variables that only appear in the linear part
+    std::vector <CouNumber> linCoe_; ///< their coefficients
+
+    std::vector <int>       qInd_;   ///< variables of the quadratic part
+    std::vector <CouNumber> b_;      ///< their linear coefficients
+    std::vector <CouNumber> Q_;      ///< dense Q, row major
+
+    bool                    definite_;  ///< Q is positive definite, i.e., {x: q(x) <= w} is an ellipsoid
+    std::vector <CouNumber> center_;    ///< if definite_, minimizer of b^T x + x^T Q x ...
+    CouNumber               centerVal_; ///< ... and its value
+
+    /// value of \f$ x^T Q x \f$ for x in the space of the quadratic variables
+    CouNumber quadForm (const CouNumber *x) const;
+  };
+
+
+  /// Cut generator for convex quadratic constraints.
+  ///
+  /// Auxiliaries w := q(x) with q convex or concave quadratic are
+  /// detected once, at setup, and their matrix Q is factorized (spectral
+  /// decomposition). When Q is positive definite, the level sets of q
+  /// are ellipsoids, whose center is computed once. At each call, the
+  /// LP point (x*,w*) is projected on the boundary of the convex set
+  /// {(x,w): w >= q(x)} along the segment joining x* with the center,
+  /// and the tangent cut at the projection is added. Contrary to the
+  /// tangent at x*, this cut supports the feasible set, which reduces
+  /// the number of rounds needed by the cutting plane loop. All cuts
+  /// are globally valid.
+
+  class CouenneEllipCuts: public CglCutGenerator {
+
+  public:
+
+    /// constructor
+    CouenneEllipCuts (CouenneProblem *,
+		      JnlstPtr,
+		      const Ipopt::SmartPtr <Ipopt::OptionsList>);
+
+    /// copy constructor
+    CouenneEllipCuts  (const CouenneEllipCuts &);
+
+    /// destructor
+    virtual ~CouenneEllipCuts ();
+
+    /// clone method (necessary for the abstract CglCutGenerator class)
+    virtual CouenneEllipCuts *clone () const
+    {return new CouenneEllipCuts (*this);}
+
+    /// the main CglCutGenerator
+    virtual void generateCuts (const OsiSolverInterface &,
+			       OsiCuts &,
+			       const CglTreeInfo = CglTreeInfo ())
+#if CGL_VERSION_MAJOR == 0 && CGL_VERSION_MINOR <= 57
+    const
+#endif
+    ;
+
+    /// Add list of options to be read from file
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+    /// true if there are no convex quadratic constraints, hence no
+    /// need to add this cut generator
+    bool doNotUse () const
+    {return constr_.empty ();}
+
+  protected:
+
+    /// Detect convex quadratic constraints and factorize them
+    void setup ();
+
+    /// Journalist
+    JnlstPtr jnlst_;
+
+    /// pointer to the CouenneProblem representation
+    CouenneProblem *problem_;
+
+    /// convex quadratic constraints
+    std::vector <CouenneEllipConstr> constr_;
+
+    /// number of calls (cutting plane rounds)
+    mutable int nRounds_;
+
+    /// total number of cuts generated
+    mutable int nCuts_;
+  };
 }
 
 #endif
@@ -0,0 +1,63 @@
+/* $Id$
+ *
+ * Name:    EllipCutsConstructors.cpp
+ * Author:  Pietro Belotti
+ * Purpose: Cuts for convex quadratic constraints: constructors and options
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include "BonRegisteredOptions.hpp"
+#include "CouenneEllipCuts.hpp"
+
+#include "CglCutGenerator.hpp"
+#include "CouenneJournalist.hpp"
+#include "IpOptionsList.hpp"
+
+using namespace Ipopt;
+using namespace Couenne;
+
+/// constructor
+CouenneEllipCuts::CouenneEllipCuts (CouenneProblem *p,
+				    JnlstPtr jnlst,
+				    const Ipopt::SmartPtr <Ipopt::OptionsList>):
+  jnlst_    (jnlst),
+  problem_  (p),
+  nRounds_  (0),
+  nCuts_    (0) {
+
+  setup ();
+}
+
+/// copy constructor
+CouenneEllipCuts::CouenneEllipCuts  (const CouenneEllipCuts &src):
+
+  CglCutGenerator (src),
+  jnlst_    (src.jnlst_),
+  problem_  (src.problem_),
+  constr_   (src.constr_),
+  nRounds_  (src.nRounds_),
+  nCuts_    (src.nCuts_) {}
+
+/// destructor
+CouenneEllipCuts::~CouenneEllipCuts () {
+
+  if (nRounds_)
+    jnlst_ -> Printf (J_ITERSUMMARY, J_CONVEXIFYING,
+		      "Ellipsoidal cuts: %d cuts in %d rounds\n", nCuts_, nRounds_);
+}
+
+/// Add list of options to be read from file
+void CouenneEllipCuts::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("ellip_cuts",
+     "The frequency (in terms of nodes) at which Couenne cuts for convex quadratic constraints are generated.",
+     -99, 0,
+     "These are tangent cuts at the projection of the LP point on convex quadratic (e.g. ellipsoidal) constraints, "
+     "and are only used if the problem has any such constraint. "
+     "A frequency of 0 (default) means these cuts are never generated. "
+     "Any positive number n instructs Couenne to generate them at every n nodes of the B&B tree. "
+     "A negative number -n means that generation should be attempted at the root node, and if successful it can be repeated at every n nodes, otherwise it is stopped altogether."
+    );
+}
@@ -0,0 +1,176 @@
+/* $Id$
+ *
+ * Name:    EllipCutsGenCuts.cpp
+ * Author:  Pietro Belotti
+ * Purpose: Separate cuts for convex quadratic constraints
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+
+#include "CglCutGenerator.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "CoinPackedVector.hpp"
+
+#include "CouenneEllipCuts.hpp"
+#include "CouennePrecisions.hpp"
+#include "CouenneProfile.hpp"
+
+using namespace Ipopt;
+using namespace Couenne;
+
+/// the main CglCutGenerator.
+///
+/// For each relation w >= q(x), with q(x) = c0 + d^T y + b^T x +
+/// x^T Q x (y are the linear-only variables), and LP point (x*, y*,
+/// w*) violating it, find a point x^ such that q(x^) = w* (with y =
+/// y*) and add the tangent
+///
+/// w >= q(x^) + grad q(x^) (x - x^),
+///
+/// which is w - (b + 2 Q x^)^T x - d^T y >= c0 - x^T Q x^. If Q is
+/// definite, x^ is on the segment between x* and the center x_c of
+/// the ellipsoid {x: q(x) <= w*}: along x_c + t (x* - x_c), q is a
+/// quadratic function of t with minimum at t=0, hence t is found in
+/// closed form. Otherwise, x^ = x*.
+
+void CouenneEllipCuts::generateCuts (const OsiSolverInterface &si,
+				     OsiCuts &cs,
+				     const CglTreeInfo)
+#if CGL_VERSION_MAJOR == 0 && CGL_VERSION_MINOR <= 57
+   const
+#endif
+{
+  CouenneProfile::Timer timer (CouenneProfile::PROF_ELLIPCUTS);
+
+  const double *sol = si.getColSolution ();
+
+  int nInitCuts = cs.sizeRowCuts ();
+
+  std::vector <CouNumber> x, xHat, grad;
+
+  for (std::vector <CouenneEllipConstr>::const_iterator con = constr_.begin (); con != constr_.end (); ++con) {
+
+    int n = (int) con -> qInd_.size ();
+
+    x.   resize (n);
+    xHat.resize (n);
+    grad.resize (n);
+
+    for (int i=0; i<n; i++)
+      x [i] = sol [con -> qInd_ [i]];
+
+    CouNumber
+      w   = con -> mult_ * sol [con -> wIndex_],
+      lin = con -> c0_,
+      q;
+
+    for (int i = (int) con -> linInd_.size (); i--;)
+      lin += con -> linCoe_ [i] * sol [con -> linInd_ [i]];
+
+    CouNumber bx = 0.;
+
+    for (int i=0; i<n; i++)
+      bx += con -> b_ [i] * x [i];
+
+    q = lin + bx + con -> quadForm (&(x [0]));
+
+    if (w >= q - COUENNE_EPS * CoinMax (1., fabs (q))) // satisfied
+      continue;
+
+    // find x^
+
+    CouNumber target = w - lin; // value of b^T x + x^T Q x at x^
+
+    if (con -> definite_) {
+
+      if (target <= con -> centerVal_) // LP point below the minimum of q: use center
+
+	xHat = con -> center_;
+
+      else {
+
+	for (int i=0; i<n; i++)
+	  grad [i] = x [i] - con -> center_ [i]; // direction d
+
+	CouNumber
+	  dQd = con -> quadForm (&(grad [0])),
+	  t   = (dQd > COUENNE_EPS) ? sqrt ((target - con -> centerVal_) / dQd) : 1.;
+
+	if (t > 1.)
+	  t = 1.;
+
+	for (int i=0; i<n; i++)
+	  xHat [i] = con -> center_ [i] + t * grad [i];
+      }
+
+    } else xHat = x;
+
+    // gradient at x^: b + 2 Q x^
+
+    for (int i=0; i<n; i++) {
+
+      CouNumber row = 0.;
+
+      for (int j=0; j<n; j++)
+	row += con -> Q_ [i*n + j] * xHat [j];
+
+      grad [i] = con -> b_ [i] + 2. * row;
+    }
+
+    CouNumber
+      rhs = con -> c0_ - con -> quadForm (&(xHat [0])),
+      lhs = w;
+
+    CoinPackedVector row;
+
+    row.insert (con -> wIndex_, con -> mult_);
+
+    bool badCoe = false;
+
+    for (int i=0; i<n; i++) {
+
+      if (fabs (grad [i]) > COU_MAX_COEFF) {
+	badCoe = true;
+	break;
+      }
+
+      if (fabs (grad [i]) > 1.e-21) { // see createCuts.cpp
+	row.insert (con -> qInd_ [i], -grad [i]);
+	lhs -= grad [i] * x [i];
+      }
+    }
+
+    if (badCoe)
+      continue;
+
+    for (int i = (int) con -> linInd_.size (); i--;) {
+      row.insert (con -> linInd_ [i], -con -> linCoe_ [i]);
+      lhs -= con -> linCoe_ [i] * sol [con -> linInd_ [i]];
+    }
+
+    if ((lhs > rhs - COUENNE_EPS) || // not violated
+	(fabs (rhs) > COUENNE_INFINITY))
+      continue;
+
+    OsiRowCut cut;
+
+    cut.setRow (row);
+    cut.setLb (rhs);
+    cut.setGloballyValid (true);
+
+    cs.insert (cut);
+  }
+
+  int nNewCuts = cs.sizeRowCuts () - nInitCuts;
+
+  ++nRounds_;
+  nCuts_ += nNewCuts;
+
+  timer.cuts (nNewCuts);
+
+  jnlst_ -> Printf (J_DETAILED, J_CONVEXIFYING,
+		    "Ellipsoidal cuts: round %d, %d cuts\n", nRounds_, nNewCuts);
+}
@@ -0,0 +1,216 @@
+/* $Id$
+ *
+ * Name:    EllipCutsSetup.cpp
+ * Author:  Pietro Belotti
+ * Purpose: Detect convex quadratic constraints and factorize them
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <map>
+#include <math.h>
+
+#include "IpLapack.hpp"
+#include "CoinHelperFunctions.hpp"
+
+#include "CouenneEllipCuts.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneExprVar.hpp"
+#include "CouenneExprAux.hpp"
+#include "CouenneExprQuad.hpp"
+
+using namespace Ipopt;
+using namespace Couenne;
+
+/// maximum size of the quadratic part (dense matrices are used)
+#define ELLIP_MAX_DIM 500
+
+/// relative tolerance on eigenvalues for convexity
+#define ELLIP_EIG_TOL 1e-9
+
+
+/// value of x^T Q x
+CouNumber CouenneEllipConstr::quadForm (const CouNumber *x) const {
+
+  int n = (int) qInd_.size ();
+
+  CouNumber val = 0.;
+
+  for (int i=0; i<n; i++) {
+
+    CouNumber row = 0.;
+
+    for (int j=0; j<n; j++)
+      row += Q_ [i*n + j] * x [j];
+
+    val += x [i] * row;
+  }
+
+  return val;
+}
+
+
+/// Detect auxiliaries w := q(x) with q convex or concave quadratic
+/// (with the convex side of the relation in the problem), and compute
+/// the spectral decomposition of Q, which tells whether q is convex
+/// and gives the center of its level sets
+
+void CouenneEllipCuts::setup () {
+
+  for (std::vector <exprVar *>::iterator i = problem_ -> Variables (). begin ();
+       i != problem_ -> Variables (). end (); ++i) {
+
+    if (((*i) -> Type () != AUX) ||
+	((*i) -> Multiplicity () <= 0))
+      continue;
+
+    expression *image = (*i) -> Image ();
+
+    if ((image -> code () != COU_EXPRQUAD) ||
+	(image -> nArgs () > 0)) // nonlinear, nonquadratic part
+      continue;
+
+    exprQuad *q = dynamic_cast <exprQuad *> (image);
+
+    if (!q || q -> getQ (). empty ())
+      continue;
+
+    // variables of the quadratic part
+
+    std::map <int, int> pos;
+
+    for (exprQuad::sparseQ::iterator row = q -> getQ (). begin (); row != q -> getQ (). end (); ++row) {
+
+      pos [row -> first -> Index ()] = 0;
+
+      for (exprQuad::sparseQcol::iterator col = row -> second.begin (); col != row -> second.end (); ++col)
+	pos [col -> first -> Index ()] = 0;
+    }
+
+    int n = (int) pos.size ();
+
+    if (n > ELLIP_MAX_DIM)
+      continue;
+
+    CouenneEllipConstr con;
+
+    con.wIndex_ = (*i) -> Index ();
+    con.c0_     = q -> getc0 ();
+
+    for (std::map <int, int>::iterator j = pos.begin (); j != pos.end (); ++j) {
+      j -> second = (int) con.qInd_.size ();
+      con.qInd_.push_back (j -> first);
+    }
+
+    con.b_.resize (n, 0.);
+    con.Q_.resize (n*n, 0.);
+
+    for (exprGroup::lincoeff::iterator el = q -> lcoeff (). begin (); el != q -> lcoeff (). end (); ++el) {
+
+      std::map <int, int>::iterator j = pos.find (el -> first -> Index ());
+
+      if (j != pos.end ())
+	con.b_ [j -> second] += el -> second;
+      else {
+	con.linInd_.push_back (el -> first -> Index ());
+	con.linCoe_.push_back (el -> second);
+      }
+    }
+
+    // off-diagonal terms appear once in exprQuad and count twice
+
+    for (exprQuad::sparseQ::iterator row = q -> getQ (). begin (); row != q -> getQ (). end (); ++row) {
+
+      int r = pos [row -> first -> Index ()];
+
+      for (exprQuad::sparseQcol::iterator col = row -> second.begin (); col != row -> second.end (); ++col) {
+
+	int c = pos [col -> first -> Index ()];
+
+	con.Q_ [r*n + c] = col -> second;
+	con.Q_ [c*n + r] = col -> second;
+      }
+    }
+
+    // spectral decomposition of Q: eigenvectors overwrite the
+    // (column-major, but symmetric) matrix
+
+    std::vector <CouNumber>
+      eigVec (con.Q_),
+      eigVal (n);
+
+    int info;
+
+    IpLapackDsyev (true, n, &(eigVec [0]), n, &(eigVal [0]), info);
+
+    if (info != 0)
+      continue;
+
+    CouNumber
+      minEig = eigVal [0],
+      maxEig = eigVal [n-1],
+      tol    = ELLIP_EIG_TOL * CoinMax (1., CoinMax (fabs (minEig), fabs (maxEig)));
+
+    enum expression::auxSign sign = (*i) -> sign ();
+
+    if      ((minEig > -tol) && (sign != expression::AUX_LEQ)) con.mult_ =  1.; // w >= q(x), q convex
+    else if ((maxEig <  tol) && (sign != expression::AUX_GEQ)) con.mult_ = -1.; // w <= q(x), q concave
+    else continue;
+
+    if (con.mult_ < 0.) {
+
+      con.c0_ = -con.c0_;
+
+      for (std::vector <CouNumber>::iterator j = con.linCoe_. begin (); j != con.linCoe_. end (); ++j) *j = -*j;
+      for (std::vector <CouNumber>::iterator j = con.b_.      begin (); j != con.b_.      end (); ++j) *j = -*j;
+      for (std::vector <CouNumber>::iterator j = con.Q_.      begin (); j != con.Q_.      end (); ++j) *j = -*j;
+      for (std::vector <CouNumber>::iterator j = eigVal.      begin (); j != eigVal.      end (); ++j) *j = -*j;
+    }
+
+    // if Q is positive definite, the level sets of q are ellipsoids
+    // centered at x_c = -1/2 Q^{-1} b = -1/2 sum_k v_k (v_k^T b) / lambda_k
+
+    con.definite_ = true;
+
+    for (int k=0; k<n; k++)
+      if (eigVal [k] < tol) {
+	con.definite_ = false;
+	break;
+      }
+
+    if (con.definite_) {
+
+      con.center_.resize (n, 0.);
+
+      for (int k=0; k<n; k++) {
+
+	const CouNumber *v = &(eigVec [k*n]);
+
+	CouNumber vb = 0.;
+
+	for (int j=0; j<n; j++)
+	  vb += v [j] * con.b_ [j];
+
+	for (int j=0; j<n; j++)
+	  con.center_ [j] -= .5 * v [j] * vb / eigVal [k];
+      }
+
+      // value of b^T x + x^T Q x at the center is b^T x_c / 2
+
+      con.centerVal_ = 0.;
+
+      for (int j=0; j<n; j++)
+	con.centerVal_ += .5 * con.b_ [j] * con.center_ [j];
+    }
+
+    jnlst_ -> Printf (J_VECTOR, J_CONVEXIFYING,
+		      "Ellipsoidal cuts: x_%d %s quadratic form on %d variables%s\n",
+		      con.wIndex_, (con.mult_ > 0.) ? ">= convex" : "<= concave", n,
+		      con.definite_ ? " (definite)" : "");
+
+    constr_.push_back (con);
+  }
+
+  jnlst_ -> Printf (J_ITERSUMMARY, J_CONVEXIFYING,
+		    "Ellipsoidal cuts: %d convex quadratic constraints\n", (int) constr_.size ());
+}
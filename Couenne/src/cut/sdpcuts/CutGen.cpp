@@ -21,6 +21,7 @@
 #include "CouenneProblem.hpp"
 #include "CouenneMatrix.hpp"
 #include "CouenneSdpCuts.hpp"
+#include "CouenneProfile.hpp"
 
 #include "dsyevx_wrapper.hpp"
 
@@ -48,6 +49,10 @@ void CouenneSdpCuts::generateCuts (const OsiSolverInterface &si, OsiCuts &cs,
 
   if ((info . level + info . pass > 4)) return;
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_SDPCUTS);
+
+  int nInitCuts = cs.sizeRowCuts ();
+
   problem_ -> domain () -> push (&si, &cs);
 
   for (std::vector <CouenneExprMatrix *>::const_iterator 
@@ -57,6 +62,8 @@ void CouenneSdpCuts::generateCuts (const OsiSolverInterface &si, OsiCuts &cs,
     genCutSingle (*minor, si, cs, info);
 
   problem_ -> domain () -> pop ();
+
+  timer.cuts (cs.sizeRowCuts () - nInitCuts);
 }
 
 
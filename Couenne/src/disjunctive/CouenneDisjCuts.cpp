@@ -12,6 +12,8 @@
 #include "CouenneDisjCuts.hpp"
 #include "CouenneProblem.hpp"
 
+#include "CoinWarmStart.hpp"
+
 using namespace Ipopt;
 using namespace Couenne;
 
@@ -35,7 +37,14 @@ CouenneDisjCuts::CouenneDisjCuts (Bonmin::OsiTMINLPInterface *minlp,
   activeRows_         (false),
   activeCols_         (false),
   addPreviousCut_     (false),
-  cpuTime_            (-1.) {
+  cpuTime_            (-1.),
+  reuseCglp_          (true),
+  cglp_               (NULL),
+  cglpA_              (NULL),
+  cglpRhs_            (NULL),
+  cglpBasis_          (NULL),
+  nCglpBuilt_         (0),
+  nCglpReused_        (0) {
 
   options -> GetNumericValue ("time_limit", cpuTime_,  "couenne.");
 
@@ -48,6 +57,7 @@ CouenneDisjCuts::CouenneDisjCuts (Bonmin::OsiTMINLPInterface *minlp,
   options -> GetStringValue ("disj_active_rows", s, "couenne."); activeRows_     = (s == "yes");
   options -> GetStringValue ("disj_active_cols", s, "couenne."); activeCols_     = (s == "yes");
   options -> GetStringValue ("disj_cumulative",  s, "couenne."); addPreviousCut_ = (s == "yes");
+  options -> GetStringValue ("disj_reuse_cglp",  s, "couenne."); reuseCglp_      = (s == "yes");
 }
 
 
@@ -69,13 +79,38 @@ CouenneDisjCuts::CouenneDisjCuts (const CouenneDisjCuts &src):
   activeRows_         (src.activeRows_),
   activeCols_         (src.activeCols_),
   addPreviousCut_     (src.addPreviousCut_),
-  cpuTime_            (src.cpuTime_) {}
+  cpuTime_            (src.cpuTime_),
+  reuseCglp_          (src.reuseCglp_),
+  cglp_               (NULL), // CGLP skeleton is not shared, rebuilt at first call
+  cglpA_              (NULL),
+  cglpRhs_            (NULL),
+  cglpBasis_          (NULL),
+  nCglpBuilt_         (0),
+  nCglpReused_        (0) {}
 
 
 
 /// destructor
-CouenneDisjCuts::~CouenneDisjCuts ()
-{if (septime_ > 1e-9) jnlst_ -> Printf (J_ERROR, J_DISJCUTS, "Disjunctive cuts: total time %g\n", septime_);}
+CouenneDisjCuts::~CouenneDisjCuts () {
+
+  if (septime_ > 1e-9) jnlst_ -> Printf (J_ERROR, J_DISJCUTS, "Disjunctive cuts: total time %g\n", septime_);
+
+  if (nCglpBuilt_ + nCglpReused_ > 0)
+    jnlst_ -> Printf (J_DETAILED, J_DISJCUTS, "Disjunctive cuts: CGLP built %d times, reused %d times\n", 
+		      nCglpBuilt_, nCglpReused_);
+
+  clearCglp ();
+}
+
+
+/// discard CGLP skeleton and its basis
+void CouenneDisjCuts::clearCglp () const {
+
+  delete cglp_;      cglp_      = NULL;
+  delete cglpA_;     cglpA_     = NULL;
+  delete cglpRhs_;   cglpRhs_   = NULL;
+  delete cglpBasis_; cglpBasis_ = NULL;
+}
 
 
 /// Add list of options to be read from file
@@ -139,4 +174,14 @@ void CouenneDisjCuts::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOption
      "When generating disjunctive cuts on a set of disjunctions 1, 2, ..., k, introduce the cut relative to the previous disjunction i-1 in the CGLP used for disjunction i. "
      "Notice that, although this makes the cut generated more efficient, it increases the rank of the disjunctive cut generated."
     );
+
+  roptions -> AddStringOption2
+    ("disj_reuse_cglp",
+     "Keep the relaxation part of the CGLP across separation rounds and nodes.",
+     "yes", 
+     "yes", "",
+     "no", "",
+     "If the canonical form of the linear relaxation has not changed since the last separation, "
+     "only the objective of the Cut Generating LP (CGLP) is updated and the last CGLP basis is used as a warm start."
+    );
 }
@@ -23,6 +23,8 @@
 #include "CouenneTypes.hpp"
 #include "CouenneJournalist.hpp"
 
+class CoinWarmStart;
+
 namespace Couenne {
 
 class CouenneCutGenerator;
@@ -90,6 +92,27 @@ class CouenneDisjCuts: public CglCutGenerator {
   /// maximum CPU time
   double cpuTime_;
 
+  /// keep the CGLP skeleton (relaxation block) across separation calls
+  bool reuseCglp_;
+
+  /// persistent CGLP containing the relaxation block only
+  mutable OsiSolverInterface *cglp_;
+
+  /// canonical form of the relaxation used to build cglp_
+  mutable CoinPackedMatrix *cglpA_;
+
+  /// right-hand side of the canonical form used to build cglp_
+  mutable CoinPackedVector *cglpRhs_;
+
+  /// basis of the last CGLP solved, used to warm start the next one
+  mutable CoinWarmStart *cglpBasis_;
+
+  /// number of times the CGLP skeleton was built from scratch
+  mutable int nCglpBuilt_;
+
+  /// number of times the CGLP skeleton was reused
+  mutable int nCglpReused_;
+
  public:
 
   /// constructor
@@ -187,6 +210,16 @@ protected:
 		       OsiCuts *cuts,
 		       int displRow,
 		       int displRhs) const;
+
+  /// build CGLP skeleton (relaxation block only) from canonical form
+  /// of the relaxation, or reuse the one of the previous call if the
+  /// relaxation has not changed. Return true if reused
+  bool getCglpSkeleton (CoinPackedMatrix &Astd,
+			CoinPackedVector &rstd,
+			OsiSolverInterface &si) const;
+
+  /// discard CGLP skeleton and its basis
+  void clearCglp () const;
 };
 
 
@@ -9,6 +9,7 @@
  */
 
 #include "CoinTime.hpp"
+#include "CoinWarmStart.hpp"
 #include "OsiClpSolverInterface.hpp"
 #include "CouennePrecisions.hpp"
 #include "CouenneDisjCuts.hpp"
@@ -93,134 +94,39 @@ int CouenneDisjCuts::generateDisjCuts (std::vector <std::pair <OsiCuts *, OsiCut
   CoinPackedVector rstd;
   OsiSI2MatrVec (Astd, rstd, si); 
 
-  int
-    n   = si.   getNumCols (),      //mC   = 2*n + 3,
-    m   = Astd. getMajorDim (),     nC   = 1 + n + 2 * m,
-    nnz = Astd. getNumElements (),  nnzC = 2 * (n + 1 + nnz + 2*m);
+  int n = si.getNumCols ();
 
-  if (jnlst_ -> ProduceOutput (J_DETAILED, J_DISJCUTS))
-    printf ("canonical form has %d cols, %d rows, %d nonzeros --> cglp has %d,%d,%d\n", 
-	    n, m, nnz, nC, 2*n + 3, nnzC);
+  // build the relaxation block of the CGLP, or reuse the one of the
+  // previous call if the canonical form has not changed, in which
+  // case only the objective (i.e., xbar) is updated
+  bool reused = getCglpSkeleton (Astd, rstd, si);
 
-  double 
-    *elements = new double [nnzC];
+  OsiSolverInterface &cglp = *cglp_;
 
-  int 
-    *indices = new int [nnzC],
-    *start   = new int [nC + 1],
-    *length  = new int [nC],
-    cur      = 0,
-    curCol   = 0;
+  int N = cglp.getNumCols (); // # cols in CGLP skeleton
 
-  // first column: two identity matrices
-  for (int i=0, i2 = n; i<n;) {
-    start   [curCol]   = cur;
-    length  [curCol++] = 2;
-    indices [cur] =    i++; elements [cur++] = -1.;
-    indices [cur] =   i2++; elements [cur++] = -1.;
-  }
+  if (reused) {
 
-  // second column: two "-1" at position 2n and 2n+1
-  start   [curCol]   = cur;
-  length  [curCol++] = 2;
-  indices [cur] = 2*n;   elements [cur++] = -1.;
-  indices [cur] = 2*n+1; elements [cur++] = -1.;
+    double *obj = new double [N];
 
-  // third...
-  addSubMatr (start + curCol, length + curCol, 
-	      indices + cur, elements + cur, 
-	      Astd, rstd,
-	      cur, curCol, 
-	      0, 2*n,   2*n+2);
+    CoinCopyN (si.getColSolution (), n, obj);
+    obj [n] = -1.;
+    CoinFillN (obj + (n+1), N-(n+1),    0.);
 
-  if (jnlst_ -> ProduceOutput (J_MATRIX, J_DISJCUTS)) {
-    printf ("with third column\n");
-    printMatrix (curCol, 2*n+3, cur, start, length, indices, elements);
-  }
+    cglp.setObjective (obj);
 
-  // ... and fourth column: get single rows from Astd
-  addSubMatr (start + curCol, length + curCol, 
-	      indices + cur, elements + cur, 
-	      Astd, rstd, 
-	      cur, curCol, 
-	      n, 2*n+1, 2*n+2);
+    delete [] obj;
 
-  if (jnlst_ -> ProduceOutput (J_MATRIX, J_DISJCUTS)) {
-    printf ("with 4th column\n");
-    printMatrix (curCol, 2*n+3, cur, start, length, indices, elements);
+    if (cglpBasis_)
+      cglp.setWarmStart (cglpBasis_);
   }
 
-  CoinPackedMatrix *baseA = new CoinPackedMatrix;
-
-  baseA -> assignMatrix (true,     // column ordered
-			 2*n+3,    // minor dimension
-			 curCol,   // major dimension
-			 cur,      // number of elements
-			 elements, // elements
-			 indices,  // indices
-			 start,    // starting positions
-			 length);  // length
-
-  //printf ("should be copy of above\n");
-  //printMatrix (baseA);
-
-  OsiClpSolverInterface cglp;
-
-  cglp. messageHandler () -> setLogLevel (0);
-
-  int 
-    N = baseA -> getMajorDim (),        // # cols in base problem
-    M = baseA -> getMinorDim ();        // # rows in base problem
-
-  assert (M == 2 * n + 3);
-
-  // vectors of the problem
-  double
-    *collb  = new double [N], // variable lower bounds
-    *colub  = new double [N], // variable upper bounds
-    *obj    = new double [N], // objective coefficients
-    *rowrhs = new double [M], // right hand sides (all zero except the last, 1)
-    *rowrng = new double [M]; // row range (empty)
-
-  // bounds
-  CoinFillN (collb,       n+1,       -COEFF_BOUNDS);
-  CoinFillN (collb + n+1, N - (n+1),  0.);
-  CoinFillN (colub,       n+1,        COEFF_BOUNDS);
-  CoinFillN (colub + n+1, N - (n+1),  1.);
-
-  // objective coefficients
-  CoinCopyN (si.getColSolution (), n, obj);
-  obj [n] = -1.;
-  CoinFillN (obj + (n+1), N-(n+1),    0.);
-
-  // rhs
-  CoinFillN (rowrhs,      M-1,        0.);
-  rowrhs [M-1] = 1.;
-
-  // rhs range
-  CoinFillN (rowrng,      M,          COIN_DBL_MAX);
-
-  // signs of the inequalities
-  char *rowsen = new char [M];
-  CoinFillN (rowsen, M, 'E');
-  rowsen [M-3] = rowsen [M-2] = 'L';
-
-  cglp.assignProblem (baseA,   // matrix
-		      collb,   // lower bounds 
-		      colub,   // upper bounds
-		      obj,     // obj coefficients
-		      rowsen,  // row sense
-		      rowrhs,  // right hand sides
-		      rowrng); // no row range
-
-  // this is a maximization problem
-  cglp. setObjSense (-1);
-
   /////////////////////////////////////////////////////////////////
 
-  // generate and solve one CGLP for each disjunction
+  // generate and solve one CGLP for each disjunction. Without a
+  // basis of the previous call, the first CGLP is solved from scratch
 
-  bool first = true;
+  bool first = !reused || !cglpBasis_;
 
   for (std::vector <std::pair <OsiCuts *, OsiCuts *> >::iterator disjI = disjunctions.begin ();
        (disjI != disjunctions.end ()) && (CoinCpuTime () < cpuTime_); ++disjI) {
@@ -368,5 +274,182 @@ int CouenneDisjCuts::generateDisjCuts (std::vector <std::pair <OsiCuts *, OsiCut
     delete [] delIndices;
   }
 
+  // remove columns of the cuts added with disj_cumulative, so that
+  // the skeleton only contains the relaxation block at the next call
+  int nAdded = cglp.getNumCols () - N;
+
+  if (nAdded > 0) {
+    int *delIndices = new int [nAdded];
+    for (int i=0; i<nAdded; i++)
+      delIndices [i] = N + i;
+    cglp.deleteCols (nAdded, delIndices);
+    delete [] delIndices;
+  }
+
+  if (reuseCglp_) {
+
+    // save basis to warm start the next CGLP
+    if (!first) {
+      delete cglpBasis_;
+      cglpBasis_ = cglp.getWarmStart ();
+    }
+
+  } else clearCglp ();
+
   return COUENNE_FEASIBLE;
 }
+
+
+/// build CGLP skeleton (relaxation block only) from canonical form
+/// of the relaxation, or reuse the one of the previous call if the
+/// relaxation has not changed. Return true if reused
+bool CouenneDisjCuts::getCglpSkeleton (CoinPackedMatrix &Astd,
+				       CoinPackedVector &rstd,
+				       OsiSolverInterface &si) const {
+  int
+    n   = si.   getNumCols (),      //mC   = 2*n + 3,
+    m   = Astd. getMajorDim (),     nC   = 1 + n + 2 * m,
+    nnz = Astd. getNumElements (),  nnzC = 2 * (n + 1 + nnz + 2*m);
+
+  if (reuseCglp_ &&
+      cglp_      &&
+      (cglp_ -> getNumCols () == nC)      &&
+      (cglp_ -> getNumRows () == 2*n + 3) &&
+      cglpA_   -> isEquivalent (Astd)    &&
+      cglpRhs_ -> isEquivalent (rstd)) {
+
+    ++nCglpReused_;
+    return true;
+  }
+
+  clearCglp ();
+  ++nCglpBuilt_;
+
+  if (reuseCglp_) {
+    cglpA_   = new CoinPackedMatrix (Astd);
+    cglpRhs_ = new CoinPackedVector (rstd);
+  }
+
+  if (jnlst_ -> ProduceOutput (J_DETAILED, J_DISJCUTS))
+    printf ("canonical form has %d cols, %d rows, %d nonzeros --> cglp has %d,%d,%d\n", 
+	    n, m, nnz, nC, 2*n + 3, nnzC);
+
+  double 
+    *elements = new double [nnzC];
+
+  int 
+    *indices = new int [nnzC],
+    *start   = new int [nC + 1],
+    *length  = new int [nC],
+    cur      = 0,
+    curCol   = 0;
+
+  // first column: two identity matrices
+  for (int i=0, i2 = n; i<n;) {
+    start   [curCol]   = cur;
+    length  [curCol++] = 2;
+    indices [cur] =    i++; elements [cur++] = -1.;
+    indices [cur] =   i2++; elements [cur++] = -1.;
+  }
+
+  // second column: two "-1" at position 2n and 2n+1
+  start   [curCol]   = cur;
+  length  [curCol++] = 2;
+  indices [cur] = 2*n;   elements [cur++] = -1.;
+  indices [cur] = 2*n+1; elements [cur++] = -1.;
+
+  // third...
+  addSubMatr (start + curCol, length + curCol, 
+	      indices + cur, elements + cur, 
+	      Astd, rstd,
+	      cur, curCol, 
+	      0, 2*n,   2*n+2);
+
+  if (jnlst_ -> ProduceOutput (J_MATRIX, J_DISJCUTS)) {
+    printf ("with third column\n");
+    printMatrix (curCol, 2*n+3, cur, start, length, indices, elements);
+  }
+
+  // ... and fourth column: get single rows from Astd
+  addSubMatr (start + curCol, length + curCol, 
+	      indices + cur, elements + cur, 
+	      Astd, rstd, 
+	      cur, curCol, 
+	      n, 2*n+1, 2*n+2);
+
+  if (jnlst_ -> ProduceOutput (J_MATRIX, J_DISJCUTS)) {
+    printf ("with 4th column\n");
+    printMatrix (curCol, 2*n+3, cur, start, length, indices, elements);
+  }
+
+  CoinPackedMatrix *baseA = new CoinPackedMatrix;
+
+  baseA -> assignMatrix (true,     // column ordered
+			 2*n+3,    // minor dimension
+			 curCol,   // major dimension
+			 cur,      // number of elements
+			 elements, // elements
+			 indices,  // indices
+			 start,    // starting positions
+			 length);  // length
+
+  //printf ("should be copy of above\n");
+  //printMatrix (baseA);
+
+  OsiClpSolverInterface *cglp = new OsiClpSolverInterface;
+
+  cglp -> messageHandler () -> setLogLevel (0);
+
+  int 
+    N = baseA -> getMajorDim (),        // # cols in base problem
+    M = baseA -> getMinorDim ();        // # rows in base problem
+
+  assert (M == 2 * n + 3);
+
+  // vectors of the problem
+  double
+    *collb  = new double [N], // variable lower bounds
+    *colub  = new double [N], // variable upper bounds
+    *obj    = new double [N], // objective coefficients
+    *rowrhs = new double [M], // right hand sides (all zero except the last, 1)
+    *rowrng = new double [M]; // row range (empty)
+
+  // bounds
+  CoinFillN (collb,       n+1,       -COEFF_BOUNDS);
+  CoinFillN (collb + n+1, N - (n+1),  0.);
+  CoinFillN (colub,       n+1,        COEFF_BOUNDS);
+  CoinFillN (colub + n+1, N - (n+1),  1.);
+
+  // objective coefficients
+  CoinCopyN (si.getColSolution (), n, obj);
+  obj [n] = -1.;
+  CoinFillN (obj + (n+1), N-(n+1),    0.);
+
+  // rhs
+  CoinFillN (rowrhs,      M-1,        0.);
+  rowrhs [M-1] = 1.;
+
+  // rhs range
+  CoinFillN (rowrng,      M,          COIN_DBL_MAX);
+
+  // signs of the inequalities
+  char *rowsen = new char [M];
+  CoinFillN (rowsen, M, 'E');
+  rowsen [M-3] = rowsen [M-2] = 'L';
+
+  cglp -> assignProblem (baseA,   // matrix
+			 collb,   // lower bounds
+			 colub,   // upper bounds
+			 obj,     // obj coefficients
+			 rowsen,  // row sense
+			 rowrhs,  // right hand sides
+			 rowrng); // no row range
+
+  // this is a maximization problem
+  cglp -> setObjSense (-1);
+
+  cglp_ = cglp;
+
+
+  return false;
+}
@@ -15,6 +15,7 @@
 #include "CouenneDisjCuts.hpp"
 #include "CouenneProblem.hpp"
 #include "CouenneInfeasCut.hpp"
+#include "CouenneProfile.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -44,6 +45,8 @@ void CouenneDisjCuts::generateCuts (const OsiSolverInterface &si,
       (info.level > depthStopSeparate_))  // check if too deep for adding these cuts
     return;
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_DISJCUTS);
+
   int nInitCuts = nrootcuts_;
 
   if ((info.level <= 0) && !(info.inTree)) {
@@ -234,6 +237,7 @@ void CouenneDisjCuts::generateCuts (const OsiSolverInterface &si,
 
       jnlst_ -> Printf (J_DETAILED, J_DISJCUTS, "--- Disjunctive Cut separator: infeasible node\n");
       WipeMakeInfeas (cs);
+      timer.pruned ();
       infeasNode = true;
     }
   }
@@ -288,6 +292,8 @@ void CouenneDisjCuts::generateCuts (const OsiSolverInterface &si,
       nrootcuts_ += deltaNcuts;
     ntotalcuts_ += deltaNcuts;
 
+    timer.cuts (deltaNcuts);
+
     if (jnlst_ -> ProduceOutput (J_DETAILED, J_DISJCUTS)) {
 
       if (cs.sizeRowCuts()>initRowCuts) printf ("added %d row cuts\n", cs.sizeRowCuts () - initRowCuts);
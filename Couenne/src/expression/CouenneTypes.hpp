@@ -43,7 +43,7 @@ enum expr_type {/*COU_EXPRAUX,  COU_EXPRCLONE, COU_EXPRCOPY, */
 		/*COU_EXPRIVAR, */ 
 		COU_EXPROP,     /***** n-ary operators *******************/
 		COU_EXPRSUB,  COU_EXPRSUM, COU_EXPRGROUP, COU_EXPRQUAD,
-		COU_EXPRMIN,  COU_EXPRMUL, COU_EXPRTRILINEAR, COU_EXPRPOW, COU_EXPRSIGNPOW, COU_EXPRMAX, COU_EXPRDIV, 
+		COU_EXPRMIN,  COU_EXPRMUL, COU_EXPRTRILINEAR, COU_EXPRPOW, COU_EXPRSIGNPOW, COU_EXPRMAX, COU_EXPRDIV, COU_EXPRNORM, COU_EXPRPWLINEAR, COU_EXPRMULTILIN,
 		/*COU_EXPRBDIV,  COU_EXPRBMUL,*/ 
 		COU_EXPRUNARY,  /***** unary operators *******************/
 		COU_EXPRCOS,  COU_EXPRABS,
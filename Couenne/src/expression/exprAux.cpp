@@ -15,6 +15,7 @@
 #include "CouenneCutGenerator.hpp"
 #include "CouenneComplObject.hpp"
 #include "CouenneJournalist.hpp"
+#include "CouenneTrace.hpp"
 
 using namespace Couenne;
 
@@ -212,8 +213,8 @@ void exprAux::generateCuts (OsiCuts &cs, const CouenneCutGenerator *cg,
 
   //#ifdef DEBUG
 
-  if (cg -> Jnlst () -> ProduceOutput (Ipopt::J_DETAILED, J_CONVEXIFYING)) {
-    if (cg -> Jnlst () -> ProduceOutput (Ipopt::J_STRONGWARNING, J_CONVEXIFYING) && 
+  if (COUENNE_TRACE (cg -> Jnlst (), Ipopt::J_DETAILED, J_CONVEXIFYING)) {
+    if (COUENNE_TRACE (cg -> Jnlst (), Ipopt::J_STRONGWARNING, J_CONVEXIFYING) && 
 	(warned_large_coeff)) {
       for (int jj=nrc; jj < cs.sizeRowCuts (); jj++) {
 
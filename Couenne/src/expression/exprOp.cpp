@@ -14,6 +14,7 @@
 #include "CouenneExprOp.hpp"
 #include "CouenneExprGroup.hpp"
 #include "CouenneExprQuad.hpp"
+#include "CouenneExprPWLinear.hpp"
 #include "CouenneExprConst.hpp"
 #include "CouennePrecisions.hpp"
 
@@ -87,6 +88,15 @@ int exprOp::compare (exprOp &e1) {
     if (res) return res;
   }
 
+  // same argument, compare piecewise linear functions
+  if (c0 == COU_EXPRPWLINEAR) {
+
+    exprPWLinear *ne0 = dynamic_cast <exprPWLinear *> (this),
+                 *ne1 = dynamic_cast <exprPWLinear *> (&e1);
+
+    return ne0 -> compare (*ne1);
+  }
+
   // last chance, this might be an exprGroup or derived
   if ((c0 == COU_EXPRGROUP) ||
       (c0 == COU_EXPRQUAD)) {
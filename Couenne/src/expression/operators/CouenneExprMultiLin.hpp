@@ -12,11 +12,25 @@
 
 #include <vector>
 
-#include "CouenneExprOp.hpp"
+#include "CouenneExprMul.hpp"
+
+/// maximum number of factors of a multilinear term: its convex and
+/// concave envelopes are separated over the 2^n vertices of the
+/// bounding box, longer products are split into chunks of this size
+#define COU_MULTILIN_MAX_FACTORS 8
 
 namespace Couenne {
 
-  /// another class for multiplications, \f$ \prod_{i=1}^n f_i(x) \f$
+  /// another class for multiplications, \f$ \prod_{i=1}^n x_i \f$,
+  /// with distinct variables \f$ x_i \f$.
+  ///
+  /// Contrary to exprMul, which is decomposed into a sequence of
+  /// bilinear (or trilinear) terms, the product is kept as a whole
+  /// and convexified through the facets of its convex and concave
+  /// envelope on the bounding box, which is the tightest possible
+  /// relaxation and is polyhedral, as the envelopes of a multilinear
+  /// function are determined by its values at the vertices of the
+  /// box.
 
   class exprMultiLin: public exprMul {
 
@@ -25,21 +39,13 @@ namespace Couenne {
     /// Constructor
     exprMultiLin (expression **, int);
 
-    /// Constructor with two arguments
-    exprMultiLin (expression *, expression *);
+    /// Cloning method
+    expression *clone (Domain *d = NULL) const
+    {return new exprMultiLin (clonearglist (d), nargs_);}
 
     /// return l-2 norm of gradient at given point
     CouNumber gradientNorm (const double *x);
 
-    /// differentiation
-    expression *differentiate (int index); 
-
-    /// simplification
-    expression *simplify ();
-
-    /// get a measure of "how linear" the expression is:
-    virtual int Linearity ();
-
     /// Get lower and upper bound of an expression (if any)
     virtual void getBounds (expression *&, expression *&);
 
@@ -51,25 +57,26 @@ namespace Couenne {
     virtual exprAux *standardize (CouenneProblem *p, bool addAux = true);
 
     /// generate equality between *this and *w
-    void generateCuts (expression *w, //const OsiSolverInterface &si, 
-		       OsiCuts &cs, const CouenneCutGenerator *cg, 
-		       t_chg_bounds * = NULL, int = -1, 
-		       CouNumber = -COUENNE_INFINITY, 
+    void generateCuts (expression *w, //const OsiSolverInterface &si,
+		       OsiCuts &cs, const CouenneCutGenerator *cg,
+		       t_chg_bounds * = NULL, int = -1,
+		       CouNumber = -COUENNE_INFINITY,
 		       CouNumber =  COUENNE_INFINITY);
 
     /// code for comparison
-    virtual enum expr_type code () 
-    {return COU_EXPRMUL;}
+    virtual enum expr_type code ()
+    {return COU_EXPRMULTILIN;}
 
     /// implied bound processing
-    bool impliedBound (int, CouNumber *, CouNumber *, t_chg_bounds *, enum Couenne::expression::auxSign = Couenne::expression::AUX_EQ);
+    bool impliedBound (int, CouNumber *, CouNumber *, t_chg_bounds *,
+		       enum Couenne::expression::auxSign = Couenne::expression::AUX_EQ);
 
     /// set up branching object by evaluating many branching points for
     /// each expression's arguments
-    virtual CouNumber selectBranch (const CouenneObject *obj, 
+    virtual CouNumber selectBranch (const CouenneObject *obj,
 				    const OsiBranchingInformation *info,
-				    expression * &var, 
-				    double * &brpts, 
+				    expression * &var,
+				    double * &brpts,
 				    double * &brDist, // distance of current LP
 				    // point to new convexifications
 				    int &way);
@@ -79,18 +86,6 @@ namespace Couenne {
 				  expression *vardep,
 				  CouNumber &left,
 				  CouNumber &right) const;
-  protected:
-
-    /// inferring bounds on factors of a product
-    int impliedBoundMul (CouNumber wl, 
-			 CouNumber wu, 
-			 std::vector <CouNumber> &xl,
-			 std::vector <CouNumber> &xu,
-			 std::vector <std::pair <int, CouNumber> > &nl,
-			 std::vector <std::pair <int, CouNumber> > &nu);
-
-    /// balanced strategy for branching point selection in products
-    CouNumber balancedMul (const OsiBranchingInformation *info, int index, int wind);
 
     /// can this expression be further linearized or are we on its
     /// concave ("bad") side
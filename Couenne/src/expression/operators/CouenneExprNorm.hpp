@@ -4,23 +4,118 @@
  * Author:  Pietro Belotti
  * Purpose: definition of the exprNorm class implementing $l_k$ norms
  *
- * (C) Carnegie-Mellon University, 2007. 
+ * (C) Carnegie-Mellon University, 2007.
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
 #ifndef EXPRNORM_HPP
 #define EXPRNORM_HPP
 
+#include <math.h>
+
 #include "CouenneExprOp.hpp"
 
 namespace Couenne {
 
   /// Class for \f$ p \f$-norms, \f$ || f(x)||_p = \left(\sum_{i=1}^n f_i(x)^p\right)^{\frac{1}{p}} \f$
+  ///
+  /// Only the Euclidean norm (\f$ p=2 \f$) is implemented. It is
+  /// created in standardization when an expression \f$
+  /// \sqrt{\sum_{i=1}^n f_i(x)^2} \f$ is found, so that a single
+  /// auxiliary \f$ w \f$ replaces the squares, the sum and the
+  /// square root, and the convex side \f$ w \ge ||f(x)||_2 \f$ is
+  /// approximated by tangent cuts of the second-order cone.
 
   class exprNorm: public exprOp {
 
+  public:
+
+    /// Constructor
+    exprNorm (expression **al, int n):
+      exprOp (al, n) {}
+
+    /// Cloning method
+    virtual expression *clone (Domain *d = NULL) const
+    {return new exprNorm (clonearglist (d), nargs_);}
+
+    /// Print position
+    virtual enum pos printPos () const
+    {return PRE;}
+
+    /// Print operator
+    virtual std::string printOp () const
+    {return "norm";}
+
+    /// Method to evaluate the expression
+    virtual inline CouNumber operator () ();
+
+    /// return l-2 norm of gradient at given point
+    virtual CouNumber gradientNorm (const double *x);
+
+    /// differentiation
+    virtual expression *differentiate (int index);
+
+    /// get a measure of "how linear" the expression is
+    virtual inline int Linearity ()
+    {return NONLINEAR;}
+
+    /// Get lower and upper bound of an expression (if any)
+    virtual void getBounds (expression *&, expression *&);
+
+    /// Get value of lower and upper bound of an expression (if any)
+    virtual void getBounds (CouNumber &lb, CouNumber &ub);
+
+    /// reduce expression in standard form, creating additional aux
+    /// variables (and constraints)
+    virtual exprAux *standardize (CouenneProblem *p, bool addAux = true);
+
+    /// generate equality between *this and *w
+    virtual void generateCuts (expression *w, //const OsiSolverInterface &si,
+			       OsiCuts &cs, const CouenneCutGenerator *cg,
+			       t_chg_bounds * = NULL, int = -1,
+			       CouNumber = -COUENNE_INFINITY,
+			       CouNumber =  COUENNE_INFINITY);
+
+    /// code for comparison
+    virtual enum expr_type code ()
+    {return COU_EXPRNORM;}
+
+    /// either CONVEX, CONCAVE, AFFINE, or NONCONVEX
+    virtual enum convexity convexity () const
+    {return CONVEX;}
+
+    /// implied bound processing
+    virtual bool impliedBound (int, CouNumber *, CouNumber *, t_chg_bounds *,
+			       enum Couenne::expression::auxSign = Couenne::expression::AUX_EQ);
+
+    /// set up branching object by evaluating many branching points for
+    /// each expression's arguments
+    virtual CouNumber selectBranch (const CouenneObject *obj,
+				    const OsiBranchingInformation *info,
+				    expression * &var,
+				    double * &brpts,
+				    double * &brDist, // distance of current LP
+				                      // point to new convexifications
+				    int &way);
+
+    /// can this expression be further linearized or are we on its
+    /// concave ("bad") side
+    virtual bool isCuttable (CouenneProblem *problem, int index) const;
   };
 
+
+  /// compute Euclidean norm
+  inline CouNumber exprNorm::operator () () {
+
+    CouNumber ret = 0.;
+
+    for (int i = nargs_; i--;) {
+      CouNumber x = (*(arglist_ [i])) ();
+      ret += x*x;
+    }
+
+    return sqrt (ret);
+  }
 }
 
 #endif
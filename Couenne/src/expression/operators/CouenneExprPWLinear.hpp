@@ -4,21 +4,148 @@
  * Author:  Pietro Belotti
  * Purpose: definition of the exprPWLinear class implementing piecewise linear functions
  *
- * (C) Carnegie-Mellon University, 2007. 
+ * (C) Carnegie-Mellon University, 2007.
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
 #ifndef EXPRPWLINEAR_HPP
 #define EXPRPWLINEAR_HPP
 
+#include <vector>
+
 #include "CouenneExprOp.hpp"
 
 namespace Couenne {
 
-class exprPWLinear: public exprOp {
+  /// Class for piecewise linear functions of one argument, \f$ f(x)
+  /// \f$, defined by breakpoints \f$ (x_k, y_k), k=0\ldots K-1 \f$,
+  /// with \f$ x_k \le x_{k+1} \f$, and by the slopes of the two
+  /// half-lines \f$ x \le x_0 \f$ and \f$ x \ge x_{K-1} \f$. Two
+  /// breakpoints with the same abscissa define a jump (used for the
+  /// derivative, which is piecewise constant).
+  ///
+  /// The function is convexified through the convex and concave
+  /// envelopes of f on the bounding box of its argument, which are
+  /// computed exactly, and branching happens on breakpoints only:
+  /// once no breakpoint is in the interior of the bounding box, the
+  /// function is linear and its envelope is exact.
+
+  class exprPWLinear: public exprOp {
+
+  public:
+
+    /// Constructor
+    exprPWLinear (expression *arg, int n,
+		  const CouNumber *x, const CouNumber *y,
+		  CouNumber slopeLeft = 0., CouNumber slopeRight = 0.);
+
+    /// Constructor with argument list (for cloning)
+    exprPWLinear (expression **al,
+		  const std::vector <CouNumber> &x, const std::vector <CouNumber> &y,
+		  CouNumber slopeLeft, CouNumber slopeRight);
+
+    /// Cloning method
+    virtual expression *clone (Domain *d = NULL) const
+    {return new exprPWLinear (clonearglist (d), x_, y_, slopeL_, slopeR_);}
+
+    /// Print position
+    virtual enum pos printPos () const
+    {return PRE;}
+
+    /// Print operator
+    virtual std::string printOp () const
+    {return "pwl";}
+
+    /// print expression, with its breakpoints
+    virtual void print (std::ostream &out = std::cout, bool descend = false) const;
+
+    /// Method to evaluate the expression
+    virtual CouNumber operator () ()
+    {return eval ((*(*arglist_)) ());}
+
+    /// value of the function at a point
+    CouNumber eval (CouNumber x) const;
+
+    /// return l-2 norm of gradient at given point
+    virtual CouNumber gradientNorm (const double *x);
+
+    /// differentiation
+    virtual expression *differentiate (int index);
+
+    /// simplification
+    virtual expression *simplify ();
+
+    /// get a measure of "how linear" the expression is
+    virtual int Linearity ();
+
+    /// Get lower and upper bound of an expression (if any)
+    virtual void getBounds (expression *&, expression *&);
+
+    /// Get value of lower and upper bound of an expression (if any)
+    virtual void getBounds (CouNumber &lb, CouNumber &ub);
+
+    /// reduce expression in standard form, creating additional aux
+    /// variables (and constraints)
+    virtual exprAux *standardize (CouenneProblem *p, bool addAux = true);
+
+    /// generate equality between *this and *w
+    virtual void generateCuts (expression *w, //const OsiSolverInterface &si,
+			       OsiCuts &cs, const CouenneCutGenerator *cg,
+			       t_chg_bounds * = NULL, int = -1,
+			       CouNumber = -COUENNE_INFINITY,
+			       CouNumber =  COUENNE_INFINITY);
+
+    /// code for comparison
+    virtual enum expr_type code ()
+    {return COU_EXPRPWLINEAR;}
+
+    /// either CONVEX, CONCAVE, AFFINE, or NONCONVEX
+    virtual enum convexity convexity () const;
+
+    /// compare with another piecewise linear function (same argument)
+    virtual int compare (exprPWLinear &);
+
+    /// implied bound processing
+    virtual bool impliedBound (int, CouNumber *, CouNumber *, t_chg_bounds *,
+			       enum Couenne::expression::auxSign = Couenne::expression::AUX_EQ);
+
+    /// set up branching object by evaluating many branching points for
+    /// each expression's arguments
+    virtual CouNumber selectBranch (const CouenneObject *obj,
+				    const OsiBranchingInformation *info,
+				    expression * &var,
+				    double * &brpts,
+				    double * &brDist, // distance of current LP
+				                      // point to new convexifications
+				    int &way);
+
+    /// number of breakpoints
+    int nBreakpoints () const {return (int) x_.size ();}
+
+    /// abscissae of breakpoints
+    const std::vector <CouNumber> &X () const {return x_;}
+
+    /// ordinates of breakpoints
+    const std::vector <CouNumber> &Y () const {return y_;}
+
+  protected:
+
+    /// slope of segment k, that is, of the function between x_{k-1}
+    /// and x_k (k=0 and k=K are the two half-lines)
+    CouNumber slope (int k) const;
+
+    /// compute lines (slope, intercept) of the convex envelope of f
+    /// on [l,u]. If upper, compute lines of the concave envelope.
+    /// Return false if the envelope is unbounded
+    bool envelope (CouNumber l, CouNumber u, bool upper,
+		   std::vector <std::pair <CouNumber, CouNumber> > &lines) const;
 
-};
+    std::vector <CouNumber> x_; ///< abscissae of breakpoints
+    std::vector <CouNumber> y_; ///< ordinates of breakpoints
 
+    CouNumber slopeL_; ///< slope of f for x <= x_0
+    CouNumber slopeR_; ///< slope of f for x >= x_{K-1}
+  };
 }
 
 #endif
@@ -72,12 +72,47 @@ protected:
 			  std::vector <std::pair <exprVar *,
 						  CouNumber> > > > eigen_;
 
-  /// current bounds (checked before re-computing eigenvalues/vectors)
-  std::map <exprVar *, std::pair <CouNumber, CouNumber> > bounds_;
+  /// variables of Q (sorted by index) and their bounds at the last
+  /// convexification (checked before re-computing eigenvalues/vectors)
+  std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > > bounds_;
 
   /// number of non-zeroes in Q
   int nqterms_;
 
+  /** \name Incremental bounds
+   *
+   *  Flat arrays used by computeQBound() and impliedBound(). Each
+   *  variable of the linear and quadratic part (sorted by index) has
+   *  a slot, and each term (linear terms first, then Q in the order
+   *  of matrix_) has the slots of its variables and its contribution
+   *  to the lower and upper bound of the expression. The sum of the
+   *  finite contributions and the number of infinite ones are kept
+   *  up to date: when the bounds of a variable change, only the
+   *  terms where it appears are recomputed.
+   */
+  /** @{ */
+
+  std::vector <exprVar *> qbVar_;    ///< variable of each slot
+  std::vector <CouNumber> qbLb_;     ///< lower bound of each slot at last update
+  std::vector <CouNumber> qbUb_;     ///< upper bound of each slot at last update
+
+  std::vector <int> qbAdjStart_;     ///< terms of slot k are qbAdj_ [qbAdjStart_ [k] ... qbAdjStart_ [k+1]-1]
+  std::vector <int> qbAdj_;          ///< terms of each slot
+
+  std::vector <int>       qbI_;      ///< slot of first variable of each term
+  std::vector <int>       qbJ_;      ///< slot of second variable (-1 if linear term)
+  std::vector <CouNumber> qbCoe_;    ///< coefficient of each term
+  std::vector <CouNumber> qbTermLo_; ///< contribution to lower bound (-COIN_DBL_MAX if infinite)
+  std::vector <CouNumber> qbTermUp_; ///< contribution to upper bound ( COIN_DBL_MAX if infinite)
+
+  CouNumber qbSumLo_;  ///< sum of finite contributions to lower bound
+  CouNumber qbSumUp_;  ///< sum of finite contributions to upper bound
+  int       qbNInfLo_; ///< number of infinite contributions to lower bound
+  int       qbNInfUp_; ///< number of infinite contributions to upper bound
+  CouNumber qbDrift_;  ///< magnitude added and subtracted since sums were last recomputed
+
+  /** @} */
+
 public:
 
   /// Constructor
@@ -276,6 +311,18 @@ public:
 				CouNumber &right) const;
 protected:
 
+  /// fill bounds_ with the variables of Q, sorted by index
+  void fillBounds ();
+
+  /// set up slots and terms of the incremental bounds
+  void initQBounds ();
+
+  /// bring incremental bounds up to date with the current variable bounds
+  void updateQBounds ();
+
+  /// recompute sums of finite contributions from scratch
+  void sumQBounds ();
+
   /// return lower and upper bound of quadratic expression
   void computeQuadFiniteBound (CouNumber &qMin, CouNumber &qMax, 
 			       CouNumber *l, CouNumber *u,
@@ -8,7 +8,10 @@
  * This file is licensed under the Eclipse Public License (EPL)
  */
 
+#include <algorithm>
+
 #include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
 #include "CouenneExprBQuad.hpp"
 
 using namespace Couenne;
@@ -47,90 +50,245 @@ CouNumber exprQuad::computeQBound (int sign) {
   // without updating the convexification. Notice also that the
   // direction can also be vertical, not only horizontal.
 
-  CouNumber bound = c0_, term;
+  // The bound is the sum of the contributions of all terms, which
+  // are kept up to date by updateQBounds (see below): only the terms
+  // of variables whose bounds changed since the last call are
+  // recomputed.
 
-  // derive linear part (obtain constant)
-  for (lincoeff::iterator el = lcoeff_.begin (); el != lcoeff_.end (); ++el) {
+  updateQBounds ();
+
+  if (sign < 0) return (qbNInfLo_ > 0) ? -COUENNE_INFINITY : c0_ + qbSumLo_;
+  else          return (qbNInfUp_ > 0) ?  COUENNE_INFINITY : c0_ + qbSumUp_;
+}
+
+
+/// Contribution of a term to the lower and upper bound of the
+/// expression, or -/+COIN_DBL_MAX if that is infinite. The term is
+/// linear (coe * x_i) if j < 0, of the form coe * x_i^2 if i==j, and
+/// 2 * coe * x_i x_j otherwise.
+
+static inline void termBounds (int i, int j, CouNumber coe,
+			       const std::vector <CouNumber> &l,
+			       const std::vector <CouNumber> &u,
+			       CouNumber &lo, CouNumber &up) {
+
+  CouNumber
+    lbi = l [i],
+    ubi = u [i];
+
+  if (j < 0) { // linear term
 
-    CouNumber 
-      coe = el -> second, term = 0.,
-      lb  = el -> first -> lb (),
-      ub  = el -> first -> ub ();
+    if (coe < 0.) {
+      lo = (ubi >  COUENNE_INFINITY) ? -COIN_DBL_MAX : coe * ubi;
+      up = (lbi < -COUENNE_INFINITY) ?  COIN_DBL_MAX : coe * lbi;
+    } else {
+      lo = (lbi < -COUENNE_INFINITY) ? -COIN_DBL_MAX : coe * lbi;
+      up = (ubi >  COUENNE_INFINITY) ?  COIN_DBL_MAX : coe * ubi;
+    }
+
+  } else if (i == j) { // term of the form q_ii x_i^2
+
+    CouNumber
+      tmin = (ubi < 0) ? (ubi * ubi) : (lbi > 0) ? (lbi * lbi) : 0., //min{xi^2: xi in [lbi,ubi]
+      tmax = CoinMax (lbi*lbi, ubi*ubi);
+
+    if (coe > 0.) {
+      lo = coe * tmin;
+      up = (tmax > COUENNE_INFINITY) ?  COIN_DBL_MAX : coe * tmax;
+    } else if (coe < 0.) {
+      lo = (tmax > COUENNE_INFINITY) ? -COIN_DBL_MAX : coe * tmax;
+      up = coe * tmin;
+    } else lo = up = 0.;
+
+  } else { // term of the form 2 q_ij x_i x_j
 
-    if (((coe < 0.) && (sign < 0)) || 
-	((coe > 0.) && (sign > 0))) 
-      {if    ((term=ub) >  COUENNE_INFINITY) return (sign < 0)? -COUENNE_INFINITY : COUENNE_INFINITY;}
-    else {if ((term=lb) < -COUENNE_INFINITY) return (sign < 0)? -COUENNE_INFINITY : COUENNE_INFINITY;}
+    coe *= 2;
 
-    bound += coe * term;
+    CouNumber
+      lbj = l [j],
+      ubj = u [j],
+      b1 = coe * lbi * lbj,
+      b2 = coe * lbi * ubj,
+      b3 = coe * ubi * lbj,
+      b4 = coe * ubi * ubj;
+
+    if (fabs (lbi) == 0) b1 = b2 = 0;
+    if (fabs (lbj) == 0) b1 = b3 = 0;
+    if (fabs (ubi) == 0) b3 = b4 = 0;
+    if (fabs (ubj) == 0) b2 = b4 = 0;
+
+    lo = CoinMin (CoinMin (b1, b2), CoinMin (b3, b4));
+    up = CoinMax (CoinMax (b1, b2), CoinMax (b3, b4));
   }
 
-#ifdef DEBUG
-  printf ("quadBound --- linear, %cb = %g\n", (sign < 0) ? 'l' : 'u', bound);
-#endif
+  // a finite bound on a term is never beyond COUENNE_INFINITY
 
-  // derive quadratic part (obtain linear part)
-  for (sparseQ::iterator row = matrix_.begin (); row != matrix_.end (); ++row) {
+  if (lo < -COUENNE_INFINITY || lo > COUENNE_INFINITY) lo = -COIN_DBL_MAX;
+  if (up >  COUENNE_INFINITY || up < -COUENNE_INFINITY) up =  COIN_DBL_MAX;
+}
 
-    int xind = row -> first -> Index ();
 
-      CouNumber 
-	lbi = row -> first -> lb (),
-	ubi = row -> first -> ub ();
+/// set up slots and terms of the incremental bounds
+void exprQuad::initQBounds () {
+
+  // one slot per variable index
+
+  std::vector <std::pair <int, exprVar *> > vars;
+
+  for (lincoeff::iterator el = lcoeff_.begin (); el != lcoeff_.end (); ++el)
+    vars.push_back (std::pair <int, exprVar *> (el -> first -> Index (), el -> first));
+
+  for (std::vector <std::pair <exprVar *, std::pair <CouNumber, CouNumber> > >::iterator
+	 i = bounds_.begin (); i != bounds_.end (); ++i)
+    vars.push_back (std::pair <int, exprVar *> (i -> first -> Index (), i -> first));
+
+  std::sort (vars.begin (), vars.end ());
+
+  qbVar_.clear ();
+
+  std::vector <int> indices;
+
+  for (std::vector <std::pair <int, exprVar *> >::iterator i = vars.begin (); i != vars.end (); ++i)
+    if (indices.empty () || (indices.back () != i -> first)) {
+      indices.push_back (i -> first);
+      qbVar_.push_back (i -> second);
+    }
+
+  int nSlots = (int) qbVar_.size ();
+
+#define slotOf(var) ((int) (std::lower_bound (indices.begin (), indices.end (), (var) -> Index ()) - indices.begin ()))
+
+  // terms: linear part first, then Q in the order of matrix_
+
+  qbI_.  clear ();
+  qbJ_.  clear ();
+  qbCoe_.clear ();
+
+  for (lincoeff::iterator el = lcoeff_.begin (); el != lcoeff_.end (); ++el) {
+    qbI_.  push_back (slotOf (el -> first));
+    qbJ_.  push_back (-1);
+    qbCoe_.push_back (el -> second);
+  }
+
+  for (sparseQ::iterator row = matrix_.begin (); row != matrix_.end (); ++row) {
+
+    int i = slotOf (row -> first);
 
     for (sparseQcol::iterator col = row -> second.begin (); col != row -> second.end (); ++col) {
+      qbI_.  push_back (i);
+      qbJ_.  push_back (slotOf (col -> first));
+      qbCoe_.push_back (col -> second);
+    }
+  }
+
+#undef slotOf
+
+  int nTerms = (int) qbI_.size ();
+
+  // terms of each slot (a term q_ii x_i^2 only appears once)
+
+  qbAdjStart_.assign (nSlots + 1, 0);
+
+  for (int t=0; t<nTerms; t++) {
+    ++(qbAdjStart_ [qbI_ [t] + 1]);
+    if ((qbJ_ [t] >= 0) && (qbJ_ [t] != qbI_ [t]))
+      ++(qbAdjStart_ [qbJ_ [t] + 1]);
+  }
+
+  for (int k=0; k<nSlots; k++)
+    qbAdjStart_ [k+1] += qbAdjStart_ [k];
+
+  qbAdj_.resize (qbAdjStart_ [nSlots]);
+
+  std::vector <int> pos (qbAdjStart_.begin (), qbAdjStart_.end () - 1);
+
+  for (int t=0; t<nTerms; t++) {
+    qbAdj_ [pos [qbI_ [t]] ++] = t;
+    if ((qbJ_ [t] >= 0) && (qbJ_ [t] != qbI_ [t]))
+      qbAdj_ [pos [qbJ_ [t]] ++] = t;
+  }
+
+  // compute all contributions with the current bounds
+
+  qbLb_.resize (nSlots);
+  qbUb_.resize (nSlots);
 
-      int yind = col -> first -> Index ();
+  for (int k=0; k<nSlots; k++) {
+    qbLb_ [k] = qbVar_ [k] -> lb ();
+    qbUb_ [k] = qbVar_ [k] -> ub ();
+  }
+
+  qbTermLo_.resize (nTerms);
+  qbTermUp_.resize (nTerms);
+
+  for (int t=0; t<nTerms; t++)
+    termBounds (qbI_ [t], qbJ_ [t], qbCoe_ [t], qbLb_, qbUb_, qbTermLo_ [t], qbTermUp_ [t]);
+
+  sumQBounds ();
+}
 
-      CouNumber coe = col -> second;
 
-      if (xind == yind) { // term of the form q_ii x_i^2
+/// recompute sums of finite contributions from scratch
+void exprQuad::sumQBounds () {
 
-	if (((coe > 0.) && (sign < 0)) ||
-	    ((coe < 0.) && (sign > 0))) 
-	  term = (ubi < 0) ? (ubi * ubi) : (lbi > 0) ? (lbi * lbi) : 0.; //min{xi^2: xi in [lbi,ubi]
-	else 
-	  if ((term = CoinMax (lbi*lbi, ubi*ubi)) > COUENNE_INFINITY) 
-	    return (sign < 0) ? -COUENNE_INFINITY : COUENNE_INFINITY;
+  qbSumLo_  = qbSumUp_  = 0.;
+  qbNInfLo_ = qbNInfUp_ = 0;
+  qbDrift_  = 0.;
+
+  for (int t = (int) qbTermLo_.size (); t--;) {
+
+    if (qbTermLo_ [t] == -COIN_DBL_MAX) ++qbNInfLo_; else qbSumLo_ += qbTermLo_ [t];
+    if (qbTermUp_ [t] ==  COIN_DBL_MAX) ++qbNInfUp_; else qbSumUp_ += qbTermUp_ [t];
+  }
+}
 
-	term *= coe;
 
-#ifdef DEBUG
-	printf ("Qii %d %g %g -> %g\n", xind, coe, term, bound + term);
-#endif
-      } else {
+/// Bring incremental bounds up to date: check the bounds of each
+/// variable and, if they changed, subtract the old contribution of its
+/// terms and add the new one. Sums are recomputed from scratch when
+/// the magnitude of what has been added and subtracted is large
+/// compared to the sums, to keep the round-off error small.
 
-	coe *= 2;
+void exprQuad::updateQBounds () {
 
-	CouNumber
-	  lbj = col -> first -> lb (),
-	  ubj = col -> first -> ub (),
-	  b1 = coe * lbi * lbj, 
-	  b2 = coe * lbi * ubj,
-	  b3 = coe * ubi * lbj, 
-	  b4 = coe * ubi * ubj;
+  if (qbAdjStart_.empty ())
+    initQBounds ();
 
-	if (fabs (lbi) == 0) b1 = b2 = 0;
-	if (fabs (lbj) == 0) b1 = b3 = 0;
-	if (fabs (ubi) == 0) b3 = b4 = 0;
-	if (fabs (ubj) == 0) b2 = b4 = 0;
+  int nSlots = (int) qbVar_.size ();
 
-	if (sign < 0) {
-	  if ((term = CoinMin (CoinMin (b1, b2), CoinMin (b3, b4))) < -COUENNE_INFINITY) 
-	    return -COUENNE_INFINITY; 
-	} else
-	  if ((term = CoinMax (CoinMax (b1, b2), CoinMax (b3, b4))) >  COUENNE_INFINITY)
-	    return  COUENNE_INFINITY;
+  for (int k=0; k<nSlots; k++) {
 
-#ifdef DEBUG
-	printf ("Qij %d %d %g %g -> %g\n", xind, yind, coe, term, bound + term);
-#endif
-      }
+    CouNumber
+      lb = qbVar_ [k] -> lb (),
+      ub = qbVar_ [k] -> ub ();
 
-      //      if ((i!=j) || (lbi >= 0) || (ubi <= 0))
-      bound += term;
+    if ((lb == qbLb_ [k]) &&
+	(ub == qbUb_ [k]))
+      continue;
+
+    qbLb_ [k] = lb;
+    qbUb_ [k] = ub;
+
+    for (int a = qbAdjStart_ [k]; a < qbAdjStart_ [k+1]; a++) {
+
+      int t = qbAdj_ [a];
+
+      CouNumber
+	&lo = qbTermLo_ [t],
+	&up = qbTermUp_ [t];
+
+      if (lo == -COIN_DBL_MAX) --qbNInfLo_; else {qbSumLo_ -= lo; qbDrift_ += fabs (lo);}
+      if (up ==  COIN_DBL_MAX) --qbNInfUp_; else {qbSumUp_ -= up; qbDrift_ += fabs (up);}
+
+      termBounds (qbI_ [t], qbJ_ [t], qbCoe_ [t], qbLb_, qbUb_, lo, up);
+
+      if (lo == -COIN_DBL_MAX) ++qbNInfLo_; else {qbSumLo_ += lo; qbDrift_ += fabs (lo);}
+      if (up ==  COIN_DBL_MAX) ++qbNInfUp_; else {qbSumUp_ += up; qbDrift_ += fabs (up);}
     }
   }
 
-  return bound;
+  // the round-off error is at most about qbDrift_ * DBL_EPSILON
+
+  if (qbDrift_ > 1e6 * (1. + CoinMax (fabs (qbSumLo_), fabs (qbSumUp_))))
+    sumQBounds ();
 }
@@ -0,0 +1,215 @@
+/* $Id$
+ *
+ * Name:    exprMultiLin.cpp
+ * Author:  Pietro Belotti
+ * Purpose: definition of multilinear terms
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+
+#include "CoinHelperFunctions.hpp"
+#include "CouenneExprMultiLin.hpp"
+#include "CouenneExprBMul.hpp"
+#include "CouenneExprClone.hpp"
+#include "CouennePrecisions.hpp"
+#include "CoinFinite.hpp"
+
+using namespace Couenne;
+
+/// Constructor
+exprMultiLin::exprMultiLin (expression **al, int n):
+  exprMul (al, n) {
+
+  qsort (arglist_, nargs_, sizeof (expression*), compareExpr);
+}
+
+
+/// compute $y^{lv}$ and  $y^{uv}$ for Violation Transfer algorithm
+void exprMultiLin::closestFeasible (expression *varind,
+				    expression *vardep,
+				    CouNumber &left,
+				    CouNumber &right) const {
+
+  fprintf (stderr, "exprMultiLin::closestFeasible() not available for VT\n");
+}
+
+
+/// return l-2 norm of gradient at given point
+CouNumber exprMultiLin::gradientNorm (const double *x) {
+
+  CouNumber norm = 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    if (arglist_ [i] -> Index () < 0)
+      continue;
+
+    CouNumber prod = 1.; // partial derivative w.r.t. i-th factor
+
+    for (int j=0; j<nargs_; j++)
+      if (j != i) {
+	int ind = arglist_ [j] -> Index ();
+	prod *= (ind < 0) ? arglist_ [j] -> Value () : x [ind];
+      }
+
+    norm += prod * prod;
+  }
+
+  return sqrt (norm);
+}
+
+
+/// get lower/upper bounds of product in expression form: the bounds
+/// of the first k factors are multiplied by those of the (k+1)-st,
+/// which is exact for products of intervals
+
+void exprMultiLin::getBounds (expression *&lb, expression *&ub) {
+
+  arglist_ [0] -> getBounds (lb, ub);
+
+  for (int i=1; i<nargs_; i++) {
+
+    expression
+      **almin = new expression * [4],
+      **almax = new expression * [4];
+
+    almin [0] = lb;
+    almin [1] = ub;
+
+    arglist_ [i] -> getBounds (almin [2], almin [3]);
+
+    for (int j=0; j<4; j++)
+      almax [j] = new exprClone (almin [j]);
+
+    lb = new exprLBMul (almin, 4);
+    ub = new exprUBMul (almax, 4);
+  }
+}
+
+
+/// get value of lower/upper bounds of product, again by multiplying
+/// one interval at a time
+
+void exprMultiLin::getBounds (CouNumber &lb, CouNumber &ub) {
+
+  arglist_ [0] -> getBounds (lb, ub);
+
+  for (int i=1; i<nargs_; i++) {
+
+    CouNumber l, u;
+
+    arglist_ [i] -> getBounds (l, u);
+
+    CouNumber
+      p0 = safeProd (lb, l),
+      p1 = safeProd (lb, u),
+      p2 = safeProd (ub, l),
+      p3 = safeProd (ub, u);
+
+    lb = CoinMin (CoinMin (p0, p1), CoinMin (p2, p3));
+    ub = CoinMax (CoinMax (p0, p1), CoinMax (p2, p3));
+  }
+}
+
+
+/// bounds on x = w/p, given bounds on w and bounds [pl,pu] on p, with
+/// 0 < pl <= pu
+
+static void divBounds (CouNumber wl, CouNumber wu,
+		       CouNumber pl, CouNumber pu,
+		       CouNumber &xl, CouNumber &xu) {
+
+  if      (wl < -COUENNE_INFINITY) xl = -COIN_DBL_MAX;
+  else if (wl < 0.)                xl = wl / pl;
+  else                             xl = (pu > COUENNE_INFINITY) ? 0. : wl / pu;
+
+  if      (wu >  COUENNE_INFINITY) xu =  COIN_DBL_MAX;
+  else if (wu > 0.)                xu = wu / pl;
+  else                             xu = (pu > COUENNE_INFINITY) ? 0. : wu / pu;
+}
+
+
+/// implied bound processing for expression w = x_1 x_2 ... x_n, upon
+/// change in lower- and/or upper bound of w, whose index is wind.
+///
+/// For each factor x_i, if the product p of all other factors has a
+/// bounding interval [pl,pu] not containing zero, then x_i = w/p is
+/// within the quotient of the intervals of w and p
+
+bool exprMultiLin::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds *chg, enum auxSign sign) {
+
+  CouNumber
+    wl = sign == expression::AUX_GEQ ? -COIN_DBL_MAX : l [wind],
+    wu = sign == expression::AUX_LEQ ?  COIN_DBL_MAX : u [wind];
+
+  if ((wl < -COUENNE_INFINITY) &&
+      (wu >  COUENNE_INFINITY))
+    return false;
+
+  bool tighter = false;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    if (ind < 0)
+      continue;
+
+    // bounds of the product of all other factors
+
+    CouNumber pl = 1., pu = 1.;
+
+    for (int j=0; j<nargs_; j++) {
+
+      if (j == i)
+	continue;
+
+      int indj = arglist_ [j] -> Index ();
+
+      CouNumber lj, uj;
+
+      if (indj < 0) lj = uj = arglist_ [j] -> Value ();
+      else {lj = l [indj]; uj = u [indj];}
+
+      CouNumber
+	p0 = safeProd (pl, lj),
+	p1 = safeProd (pl, uj),
+	p2 = safeProd (pu, lj),
+	p3 = safeProd (pu, uj);
+
+      pl = CoinMin (CoinMin (p0, p1), CoinMin (p2, p3));
+      pu = CoinMax (CoinMax (p0, p1), CoinMax (p2, p3));
+
+      if ((pl <= 0.) && (pu >= 0.))
+	break;
+    }
+
+    if ((pl <= COUENNE_EPS) && (pu >= -COUENNE_EPS)) // zero in [pl,pu], x_i is free
+      continue;
+
+    CouNumber xl, xu;
+
+    if (pl > 0.) divBounds ( wl,  wu,  pl,  pu, xl, xu);
+    else         divBounds (-wu, -wl, -pu, -pl, xl, xu);
+
+    bool isInt = arglist_ [i] -> isInteger ();
+
+    if ((xl > -COUENNE_INFINITY) &&
+	updateBound (-1, l + ind, isInt ? ceil (xl - COUENNE_EPS) : xl)) {
+      tighter = true;
+      chg [ind].setLower (t_chg_bounds::CHANGED);
+    }
+
+    if ((xu < COUENNE_INFINITY) &&
+	updateBound (+1, u + ind, isInt ? floor (xu + COUENNE_EPS) : xu)) {
+      tighter = true;
+      chg [ind].setUpper (t_chg_bounds::CHANGED);
+    }
+  }
+
+  return tighter;
+}
@@ -0,0 +1,260 @@
+/* $Id$
+ *
+ * Name:    exprNorm.cpp
+ * Author:  Pietro Belotti
+ * Purpose: methods of the Euclidean norm
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+
+#include "CouenneExprNorm.hpp"
+#include "CouenneExprAbs.hpp"
+#include "CouenneExprSum.hpp"
+#include "CouenneExprMul.hpp"
+#include "CouenneExprDiv.hpp"
+#include "CouenneExprClone.hpp"
+#include "CouenneExprConst.hpp"
+
+#include "CouenneProblem.hpp"
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+
+using namespace Couenne;
+
+/// return l-2 norm of gradient at given point: the gradient of
+/// ||f(x)|| is f(x)/||f(x)||, restricted to nonconstant arguments
+
+CouNumber exprNorm::gradientNorm (const double *x) {
+
+  CouNumber
+    sumVar = 0.,
+    sumAll = 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    CouNumber xi = (ind < 0) ? arglist_ [i] -> Value () : x [ind];
+
+    sumAll += xi*xi;
+
+    if (ind >= 0)
+      sumVar += xi*xi;
+  }
+
+  return (sumAll > 0.) ? sqrt (sumVar / sumAll) : 0.;
+}
+
+
+/// differentiation: d/dx_j ||f(x)|| = \sum_i f_i(x) df_i/dx_j / ||f(x)||
+
+expression *exprNorm::differentiate (int index) {
+
+  expression **arglist = new expression * [nargs_];
+
+  int nonconst = 0;
+
+  for (int i = 0; i < nargs_; i++)
+    if (arglist_ [i] -> dependsOn (index))
+      arglist [nonconst++] = new exprMul (new exprClone (arglist_ [i]),
+					  arglist_ [i] -> differentiate (index));
+
+  if (!nonconst) {
+    delete [] arglist;
+    return new exprConst (0.);
+  }
+
+  expression **normArgs = new expression * [nargs_];
+
+  for (int i = 0; i < nargs_; i++)
+    normArgs [i] = new exprClone (arglist_ [i]);
+
+  return new exprDiv (new exprSum (arglist, nonconst),
+		      new exprNorm (normArgs, nargs_));
+}
+
+
+/// find lower and upper bound of a given expression: the norm of the
+/// bounds on the absolute value of each argument
+
+void exprNorm::getBounds (expression *&lb, expression *&ub) {
+
+  expression
+    **lbs = new expression * [nargs_],
+    **ubs = new expression * [nargs_];
+
+  for (int i=0; i<nargs_; i++) {
+
+    exprAbs absArg (new exprClone (arglist_ [i]));
+    absArg.getBounds (lbs [i], ubs [i]);
+  }
+
+  lb = new exprNorm (lbs, nargs_);
+  ub = new exprNorm (ubs, nargs_);
+}
+
+
+/// find value of lower and upper bound of a given expression
+
+void exprNorm::getBounds (CouNumber &lb, CouNumber &ub) {
+
+  lb = ub = 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    CouNumber lba, uba;
+
+    arglist_ [i] -> getBounds (lba, uba);
+
+    // minimum and maximum absolute value of argument
+
+    CouNumber
+      minAbs = (lba > 0.) ? lba : (uba < 0.) ? -uba : 0.,
+      maxAbs = CoinMax (-lba, uba);
+
+    lb += minAbs * minAbs;
+
+    if (ub < COUENNE_INFINITY)
+      ub = (maxAbs >= COUENNE_INFINITY) ? COUENNE_INFINITY : ub + maxAbs * maxAbs;
+  }
+
+  lb = sqrt (lb);
+
+  if (ub < COUENNE_INFINITY)
+    ub = sqrt (ub);
+}
+
+
+/// implied bound processing for expression w = ||x||, upon change in
+/// lower- and/or upper bound of w, whose index is wind
+
+bool exprNorm::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds *chg, enum auxSign sign) {
+
+  CouNumber
+    wl = sign == expression::AUX_GEQ ? -COIN_DBL_MAX : l [wind],
+    wu = sign == expression::AUX_LEQ ?  COIN_DBL_MAX : u [wind];
+
+  if ((wl <= 0.) && (wu >= COUENNE_INFINITY))
+    return false;
+
+  // minimum and maximum squared absolute value of each argument, and
+  // their sums
+
+  CouNumber
+    *minSq = new CouNumber [nargs_],
+    *maxSq = new CouNumber [nargs_],
+    sumMin = 0.,
+    sumMax = 0.;
+
+  int nInfMax = 0; // number of arguments with unbounded |x_i|
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    CouNumber
+      xl = (ind < 0) ? arglist_ [i] -> Value () : l [ind],
+      xu = (ind < 0) ? arglist_ [i] -> Value () : u [ind],
+      minAbs = (xl > 0.) ? xl : (xu < 0.) ? -xu : 0.,
+      maxAbs = CoinMax (-xl, xu);
+
+    minSq [i] = minAbs * minAbs;
+    sumMin   += minSq [i];
+
+    if (maxAbs >= COUENNE_INFINITY) {
+      maxSq [i] = COUENNE_INFINITY;
+      ++nInfMax;
+    } else {
+      maxSq [i] = maxAbs * maxAbs;
+      sumMax   += maxSq [i];
+    }
+  }
+
+  bool tighter = false;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    if (ind < 0)
+      continue;
+
+    bool isInt = arglist_ [i] -> isInteger ();
+
+    // w <= wu implies |x_i| <= sqrt (wu^2 - \sum_{j != i} min |x_j|^2)
+
+    if (wu < COUENNE_INFINITY) {
+
+      CouNumber bound = sqrt (CoinMax (0., wu*wu - (sumMin - minSq [i])));
+
+      if (updateBound (-1, l + ind, isInt ? ceil (-bound - COUENNE_EPS) : -bound)) {
+	tighter = true;
+	chg [ind].setLower (t_chg_bounds::CHANGED);
+      }
+
+      if (updateBound (+1, u + ind, isInt ? floor (bound + COUENNE_EPS) :  bound)) {
+	tighter = true;
+	chg [ind].setUpper (t_chg_bounds::CHANGED);
+      }
+    }
+
+    // w >= wl > 0 implies |x_i| >= sqrt (wl^2 - \sum_{j != i} max |x_j|^2),
+    // which only excludes an interval around zero: tighten if x_i is
+    // already on one side of it
+
+    if ((wl > 0.) &&
+	((nInfMax == 0) ||
+	 ((nInfMax == 1) && (maxSq [i] >= COUENNE_INFINITY)))) {
+
+      CouNumber rest = sumMax - ((maxSq [i] >= COUENNE_INFINITY) ? 0. : maxSq [i]);
+
+      if (wl*wl > rest) {
+
+	CouNumber bound = sqrt (wl*wl - rest);
+
+	if (l [ind] > -bound) {
+
+	  if (updateBound (-1, l + ind, isInt ? ceil (bound - COUENNE_EPS) : bound)) {
+	    tighter = true;
+	    chg [ind].setLower (t_chg_bounds::CHANGED);
+	  }
+
+	} else if (u [ind] < bound) {
+
+	  if (updateBound (+1, u + ind, isInt ? floor (-bound + COUENNE_EPS) : -bound)) {
+	    tighter = true;
+	    chg [ind].setUpper (t_chg_bounds::CHANGED);
+	  }
+	}
+      }
+    }
+  }
+
+  delete [] minSq;
+  delete [] maxSq;
+
+  return tighter;
+}
+
+
+/// can this expression be further linearized or are we on its
+/// concave ("bad") side: w <= ||x|| can be cut by a tangent
+
+bool exprNorm::isCuttable (CouenneProblem *problem, int index) const {
+
+  CouNumber sum = 0.;
+
+  for (int i=0; i<nargs_; i++) {
+
+    int ind = arglist_ [i] -> Index ();
+
+    CouNumber xi = (ind < 0) ? arglist_ [i] -> Value () : problem -> X (ind);
+
+    sum += xi*xi;
+  }
+
+  return (problem -> X (index) <= sqrt (sum));
+}
@@ -0,0 +1,378 @@
+/* $Id$
+ *
+ * Name:    exprPWLinear.cpp
+ * Author:  Pietro Belotti
+ * Purpose: methods of piecewise linear functions
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include "CouenneExprPWLinear.hpp"
+#include "CouenneExprMul.hpp"
+#include "CouenneExprClone.hpp"
+#include "CouenneExprConst.hpp"
+
+#include "CouenneProblem.hpp"
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+
+using namespace Couenne;
+
+/// Constructor
+exprPWLinear::exprPWLinear (expression *arg, int n,
+			    const CouNumber *x, const CouNumber *y,
+			    CouNumber slopeLeft, CouNumber slopeRight):
+
+  exprOp  (new expression * [1], 1),
+  x_      (x, x + n),
+  y_      (y, y + n),
+  slopeL_ (slopeLeft),
+  slopeR_ (slopeRight) {
+
+  assert (n > 0);
+
+  *arglist_ = arg;
+}
+
+
+/// Constructor with argument list (for cloning)
+exprPWLinear::exprPWLinear (expression **al,
+			    const std::vector <CouNumber> &x, const std::vector <CouNumber> &y,
+			    CouNumber slopeLeft, CouNumber slopeRight):
+  exprOp  (al, 1),
+  x_      (x),
+  y_      (y),
+  slopeL_ (slopeLeft),
+  slopeR_ (slopeRight) {}
+
+
+/// print expression, with its breakpoints
+void exprPWLinear::print (std::ostream &out, bool descend) const {
+
+  out << printOp () << "[" << slopeL_ << ";";
+
+  for (int k = 0, K = (int) x_.size (); k < K; k++)
+    out << " (" << x_ [k] << "," << y_ [k] << ")";
+
+  out << "; " << slopeR_ << "] (";
+  arglist_ [0] -> print (out, descend);
+  out << ")";
+}
+
+
+/// slope of segment k, between x_{k-1} and x_k (k=0 and k=K are the
+/// two half-lines). Jumps have null slope
+
+CouNumber exprPWLinear::slope (int k) const {
+
+  int K = (int) x_.size ();
+
+  if (k <= 0) return slopeL_;
+  if (k >= K) return slopeR_;
+
+  CouNumber dx = x_ [k] - x_ [k-1];
+
+  return (dx > 0.) ? (y_ [k] - y_ [k-1]) / dx : 0.;
+}
+
+
+/// value of the function at a point
+CouNumber exprPWLinear::eval (CouNumber x) const {
+
+  int
+    K = (int) x_.size (),
+    k = (int) (std::upper_bound (x_.begin (), x_.end (), x) - x_.begin ()); // first x_k > x
+
+  if (k == 0) return y_ [0]   + slopeL_ * (x - x_ [0]);
+  if (k == K) return y_ [K-1] + slopeR_ * (x - x_ [K-1]);
+
+  return y_ [k-1] + slope (k) * (x - x_ [k-1]);
+}
+
+
+/// return l-2 norm of gradient at given point
+CouNumber exprPWLinear::gradientNorm (const double *x) {
+
+  int ind = arglist_ [0] -> Index ();
+
+  if (ind < 0)
+    return 0.;
+
+  int k = (int) (std::upper_bound (x_.begin (), x_.end (), x [ind]) - x_.begin ());
+
+  return fabs (slope (k));
+}
+
+
+/// differentiation: the derivative of f is piecewise constant, hence
+/// it is a piecewise linear function with a jump at each breakpoint
+
+expression *exprPWLinear::differentiate (int index) {
+
+  if (!(arglist_ [0] -> dependsOn (index)))
+    return new exprConst (0.);
+
+  std::vector <CouNumber> dx, dy;
+
+  int K = (int) x_.size ();
+
+  CouNumber prev = slopeL_;
+
+  for (int k = 0; k < K;) {
+
+    int j = k; // last breakpoint with the same abscissa as x_k
+
+    while ((j+1 < K) && (x_ [j+1] <= x_ [k]))
+      ++j;
+
+    CouNumber next = slope (j+1);
+
+    dx.push_back (x_ [k]); dy.push_back (prev);
+    dx.push_back (x_ [k]); dy.push_back (next);
+
+    prev = next;
+    k    = j+1;
+  }
+
+  return new exprMul (new exprPWLinear (new exprClone (arglist_ [0]), (int) dx.size (), &(dx [0]), &(dy [0])),
+		      arglist_ [0] -> differentiate (index));
+}
+
+
+/// simplification
+expression *exprPWLinear::simplify () {
+
+  exprOp::simplify ();
+
+  if (arglist_ [0] -> Type () == CONST)
+    return new exprConst (eval (arglist_ [0] -> Value ()));
+
+  return NULL;
+}
+
+
+/// either CONVEX, CONCAVE, AFFINE, or NONCONVEX
+enum convexity exprPWLinear::convexity () const {
+
+  bool
+    nonDecr = true,
+    nonIncr = true;
+
+  int K = (int) x_.size ();
+
+  CouNumber prev = slopeL_;
+
+  for (int k=1; k<=K; k++) {
+
+    if ((k < K) && (x_ [k] <= x_ [k-1])) {
+
+      if (fabs (y_ [k] - y_ [k-1]) > COUENNE_EPS) // jump
+	return NONCONVEX;
+
+      continue;
+    }
+
+    CouNumber s = slope (k);
+
+    if (s < prev - COUENNE_EPS) nonDecr = false;
+    if (s > prev + COUENNE_EPS) nonIncr = false;
+
+    prev = s;
+  }
+
+  if (nonDecr && nonIncr) return AFFINE;
+  if (nonDecr)            return CONVEX;
+  if (nonIncr)            return CONCAVE;
+
+  return NONCONVEX;
+}
+
+
+/// get a measure of "how linear" the expression is
+int exprPWLinear::Linearity () {
+
+  return ((convexity () == AFFINE) &&
+	  (arglist_ [0] -> Linearity () <= LINEAR)) ? LINEAR : NONLINEAR;
+}
+
+
+/// find lower and upper bound of a given expression. These do not
+/// depend on the argument's bounds, so they are valid (if weak) for
+/// the whole tree
+
+void exprPWLinear::getBounds (expression *&lb, expression *&ub) {
+
+  CouNumber
+    l = (slopeL_ > 0.) || (slopeR_ < 0.) ? -COUENNE_INFINITY : *(std::min_element (y_.begin (), y_.end ())),
+    u = (slopeL_ < 0.) || (slopeR_ > 0.) ?  COUENNE_INFINITY : *(std::max_element (y_.begin (), y_.end ()));
+
+  lb = new exprConst (l);
+  ub = new exprConst (u);
+}
+
+
+/// find value of lower and upper bound of a given expression: f is
+/// linear between breakpoints, so its extrema over [l,u] are at l, u,
+/// or at the breakpoints in between
+
+void exprPWLinear::getBounds (CouNumber &lb, CouNumber &ub) {
+
+  CouNumber l, u;
+
+  arglist_ [0] -> getBounds (l, u);
+
+  lb =  COUENNE_INFINITY;
+  ub = -COUENNE_INFINITY;
+
+  if (l < -COUENNE_INFINITY) {
+    if (slopeL_ > 0.) lb = -COUENNE_INFINITY;
+    if (slopeL_ < 0.) ub =  COUENNE_INFINITY;
+  } else {
+    CouNumber f = eval (l);
+    lb = CoinMin (lb, f);
+    ub = CoinMax (ub, f);
+  }
+
+  if (u > COUENNE_INFINITY) {
+    if (slopeR_ > 0.) ub =  COUENNE_INFINITY;
+    if (slopeR_ < 0.) lb = -COUENNE_INFINITY;
+  } else {
+    CouNumber f = eval (u);
+    lb = CoinMin (lb, f);
+    ub = CoinMax (ub, f);
+  }
+
+  for (int k = 0, K = (int) x_.size (); k < K; k++)
+    if ((x_ [k] >= l) &&
+	(x_ [k] <= u)) {
+      lb = CoinMin (lb, y_ [k]);
+      ub = CoinMax (ub, y_ [k]);
+    }
+}
+
+
+/// compare with another piecewise linear function (same argument)
+int exprPWLinear::compare (exprPWLinear &e) {
+
+  if (x_.size () < e.x_.size ()) return -1;
+  if (x_.size () > e.x_.size ()) return  1;
+
+  if (slopeL_ < e.slopeL_) return -1;
+  if (slopeL_ > e.slopeL_) return  1;
+  if (slopeR_ < e.slopeR_) return -1;
+  if (slopeR_ > e.slopeR_) return  1;
+
+  for (int k = (int) x_.size (); k--;) {
+
+    if (x_ [k] < e.x_ [k]) return -1;
+    if (x_ [k] > e.x_ [k]) return  1;
+    if (y_ [k] < e.y_ [k]) return -1;
+    if (y_ [k] > e.y_ [k]) return  1;
+  }
+
+  return 0;
+}
+
+
+/// implied bound processing for expression w = f(x), upon change in
+/// lower- and/or upper bound of w, whose index is wind. On each
+/// linear piece of f the set {x: wl <= f(x) <= wu} is an interval,
+/// and the new bounds on x are the extremes of their union
+
+bool exprPWLinear::impliedBound (int wind, CouNumber *l, CouNumber *u, t_chg_bounds *chg, enum auxSign sign) {
+
+  int ind = arglist_ [0] -> Index ();
+
+  if (ind < 0)
+    return false;
+
+  CouNumber
+    wl = sign == expression::AUX_GEQ ? -COIN_DBL_MAX : l [wind],
+    wu = sign == expression::AUX_LEQ ?  COIN_DBL_MAX : u [wind];
+
+  if ((wl < -COUENNE_INFINITY) &&
+      (wu >  COUENNE_INFINITY))
+    return false;
+
+  CouNumber
+    xl = l [ind],
+    xu = u [ind],
+    newL =  COIN_DBL_MAX,
+    newU = -COIN_DBL_MAX;
+
+  int K = (int) x_.size ();
+
+  for (int k=0; k<=K; k++) {
+
+    // segment [a,b] through (x0,y0) with slope s
+
+    CouNumber
+      a  = (k == 0) ? -COIN_DBL_MAX : x_ [k-1],
+      b  = (k == K) ?  COIN_DBL_MAX : x_ [k],
+      x0 = (k == 0) ? x_ [0] : x_ [k-1],
+      y0 = (k == 0) ? y_ [0] : y_ [k-1],
+      s  = slope (k);
+
+    if ((k > 0) && (k < K) && (b <= a)) // jump, covered by neighbors
+      continue;
+
+    a = CoinMax (a, xl);
+    b = CoinMin (b, xu);
+
+    if (a > b)
+      continue;
+
+    CouNumber lo = a, hi = b;
+
+    if (fabs (s) < COUENNE_EPS) {
+
+      if ((y0 < wl - COUENNE_EPS) ||
+	  (y0 > wu + COUENNE_EPS))
+	continue;
+
+    } else if (s > 0.) {
+
+      if (wl > -COUENNE_INFINITY) lo = CoinMax (lo, x0 + (wl - y0) / s);
+      if (wu <  COUENNE_INFINITY) hi = CoinMin (hi, x0 + (wu - y0) / s);
+
+    } else {
+
+      if (wu <  COUENNE_INFINITY) lo = CoinMax (lo, x0 + (wu - y0) / s);
+      if (wl > -COUENNE_INFINITY) hi = CoinMin (hi, x0 + (wl - y0) / s);
+    }
+
+    if (lo > hi + COUENNE_EPS)
+      continue;
+
+    newL = CoinMin (newL, lo);
+    newU = CoinMax (newU, hi);
+  }
+
+  // no piece of f within the bounds of w: infeasibility is detected
+  // through the bounds of w, do nothing here
+
+  if (newL > newU)
+    return false;
+
+  bool
+    tighter = false,
+    isInt   = arglist_ [0] -> isInteger ();
+
+  if ((newL > -COUENNE_INFINITY) &&
+      updateBound (-1, l + ind, isInt ? ceil (newL - COUENNE_EPS) : newL)) {
+    tighter = true;
+    chg [ind].setLower (t_chg_bounds::CHANGED);
+  }
+
+  if ((newU < COUENNE_INFINITY) &&
+      updateBound (+1, u + ind, isInt ? floor (newU + COUENNE_EPS) : newU)) {
+    tighter = true;
+    chg [ind].setUpper (t_chg_bounds::CHANGED);
+  }
+
+  return tighter;
+}
@@ -104,37 +104,20 @@ exprQuad::exprQuad (CouNumber c0,
 
     sparseQcol line;
 
-    // insert first element in bound map
-    if (bounds_.find (row -> first) == bounds_.end ()) {
-
-      std::pair <CouNumber, CouNumber> newbound (-COIN_DBL_MAX, COIN_DBL_MAX);
-      std::pair <exprVar *, std::pair <CouNumber, CouNumber> > newvar (row -> first, newbound);
-      bounds_.insert (newvar);
-    }
-
-    for (rowMap::iterator cell = row -> second.begin (); cell != row -> second.end (); ++cell) {
-
+    for (rowMap::iterator cell = row -> second.begin (); cell != row -> second.end (); ++cell)
       line.push_back (std::pair <exprVar *, CouNumber> (*cell));
 
-      // insert second element in bound map
-      if (bounds_.find (cell -> first) == bounds_.end ()) {
-
-	std::pair <CouNumber, CouNumber> newbound (-COIN_DBL_MAX, COIN_DBL_MAX);
-	std::pair <exprVar *, std::pair <CouNumber, CouNumber> > newvar (cell -> first, newbound);
-	bounds_.insert (newvar);
-      }
-    }
-
     matrix_.push_back (std::pair <exprVar *, sparseQcol> (row -> first, line));
     nqterms_ += (int) (line.size ());
   }
+
+  fillBounds ();
 }
 
 
 /// copy constructor
 exprQuad::exprQuad (const exprQuad &src, Domain *d): 
   exprGroup (src, d),
-  bounds_   (src.bounds_),
   nqterms_  (src.nqterms_) {
 
   for (sparseQ::iterator row = src.matrix_.begin (); row != src.matrix_ . end (); ++row) {  
@@ -151,6 +134,15 @@ exprQuad::exprQuad (const exprQuad &src, Domain *d):
 		       (new exprVar (row -> first -> Index (), d), column));
   }
 
+  // same variables as in src, hence same order: keep the bounds of
+  // the last convexification
+
+  fillBounds ();
+
+  if (bounds_.size () == src.bounds_.size ())
+    for (int i = (int) bounds_.size (); i--;)
+      bounds_ [i].second = src.bounds_ [i].second;
+
   //////////////////////////////////////////////////////////////////////////////
 
   std::vector 
@@ -471,6 +463,9 @@ void exprQuad::replace (exprVar *x, exprVar *w) {
       }
     }
   }
+
+  fillBounds ();
+  qbAdjStart_.clear ();
 }
 
 
@@ -512,6 +507,37 @@ void exprQuad::realign (const CouenneProblem *p) {
       }
     }
   }
+
+  // variables have been replaced, set up bounds again
+
+  fillBounds ();
+  qbAdjStart_.clear ();
+}
+
+
+/// Fill bounds_ with the variables of Q, sorted by index (one per
+/// index), with infinite bounds so that the first convexification
+/// computes eigenvalues
+void exprQuad::fillBounds () {
+
+  std::vector <exprVar *> vars;
+
+  for (sparseQ::iterator row = matrix_.begin (); row != matrix_.end (); ++row) {
+
+    vars.push_back (row -> first);
+
+    for (sparseQcol::iterator col = row -> second.begin (); col != row -> second.end (); ++col)
+      vars.push_back (col -> first);
+  }
+
+  std::sort (vars.begin (), vars.end (), cmpVar ());
+
+  bounds_.clear ();
+
+  for (std::vector <exprVar *>::iterator i = vars.begin (); i != vars.end (); ++i)
+    if (bounds_.empty () || (bounds_.back ().first -> Index () != (*i) -> Index ()))
+      bounds_.push_back (std::pair <exprVar *, std::pair <CouNumber, CouNumber> >
+			 (*i, std::pair <CouNumber, CouNumber> (-COIN_DBL_MAX, COIN_DBL_MAX)));
 }
 
 
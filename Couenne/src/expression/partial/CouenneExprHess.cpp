@@ -54,11 +54,19 @@ ExprHess &ExprHess::operator= (const ExprHess &rhs) {
 
     for (int i=0; i<nnz_; i++) {
 
-      lamI_ [i] = CoinCopyOfArray (rhs. lamI_ [i], numL_ [i]);
+      lamI_ [i] = (int         *) malloc (numL_ [i] * sizeof (int));
+      expr_ [i] = (expression **) malloc (numL_ [i] * sizeof (expression *));
+
+      CoinCopyN (rhs. lamI_ [i], numL_ [i], lamI_ [i]);
 
       for (int j=0; j<numL_ [i]; j++)
 	expr_ [i] [j] = rhs. expr_ [i][j] -> clone ();
     }
+
+  } else {
+
+    lamI_ = NULL;
+    expr_ = NULL;
   }
 
   return *this;
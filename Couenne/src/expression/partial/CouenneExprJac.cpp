@@ -22,30 +22,50 @@ using namespace Couenne;
 
 // empty constructor
 ExprJac::ExprJac ():
-  nnz_   (0),
-  iRow_  (NULL),
-  jCol_  (NULL),
-  expr_  (NULL),
-  nRows_ (0) {}
+  nnz_     (0),
+  iRow_    (NULL),
+  jCol_    (NULL),
+  expr_    (NULL),
+  nRows_   (0),
+  func_    (NULL),
+  problem_ (NULL) {}
 
 
 //destructor
-ExprJac::~ExprJac () {
+ExprJac::~ExprJac ()
+{clear ();}
 
-  if (nnz_) {
 
-    free (iRow_);
-    free (jCol_);
+// free all arrays
+void ExprJac::clear () {
+
+  if (iRow_) free (iRow_);
+  if (jCol_) free (jCol_);
+  if (func_) free (func_);
+
+  if (expr_) {
 
     for (int i=0; i<nnz_; i++)
       delete expr_ [i];
 
     free (expr_);
   }
+
+  iRow_ = jCol_ = NULL;
+  func_ = expr_ = NULL;
+  nnz_  = nRows_ = 0;
 }
 
+
 // copy constructor
-ExprJac::ExprJac  (const ExprJac &rhs)
+ExprJac::ExprJac  (const ExprJac &rhs):
+  nnz_     (0),
+  iRow_    (NULL),
+  jCol_    (NULL),
+  expr_    (NULL),
+  nRows_   (0),
+  func_    (NULL),
+  problem_ (NULL)
 {operator= (rhs);}
 
 
@@ -57,23 +77,33 @@ ExprJac *ExprJac::clone ()
 // assignment
 ExprJac &ExprJac::operator= (const ExprJac &rhs) {
 
-  nnz_   = rhs. nnz_;
-  nRows_ = rhs. nRows_;
+  if (this == &rhs)
+    return *this;
+
+  clear ();
 
-  iRow_ = (nnz_ && rhs.iRow_) ? (int *) malloc (nnz_ * sizeof (int)) : NULL;
-  jCol_ = (nnz_ && rhs.jCol_) ? (int *) malloc (nnz_ * sizeof (int)) : NULL;
+  nnz_     = rhs. nnz_;
+  nRows_   = rhs. nRows_;
+  problem_ = rhs. problem_;
+
+  iRow_ = (nnz_ && rhs.iRow_) ? (int         *) malloc (nnz_ * sizeof (int))          : NULL;
+  jCol_ = (nnz_ && rhs.jCol_) ? (int         *) malloc (nnz_ * sizeof (int))          : NULL;
+  func_ = (nnz_ && rhs.func_) ? (expression **) malloc (nnz_ * sizeof (expression *)) : NULL;
 
   CoinCopyN (rhs.iRow_, nnz_, iRow_);
   CoinCopyN (rhs.jCol_, nnz_, jCol_);
+  CoinCopyN (rhs.func_, nnz_, func_);
+
+  // derivatives are cloned only if already computed, otherwise they
+  // are computed on demand as for rhs
 
-  if (nnz_) {
+  if (nnz_ && rhs.expr_) {
 
     expr_ = (expression **) malloc (nnz_ * sizeof (expression *));
 
     for (int i=0; i<nnz_; i++)
-      expr_ [i] = expr_ [i] -> clone ();
-
-  } else expr_ = NULL;
+      expr_ [i] = rhs. expr_ [i] -> clone ();
+  }
 
   return *this;
 }
@@ -82,7 +112,7 @@ ExprJac &ExprJac::operator= (const ExprJac &rhs) {
 /// code for refilling jacobian
 
 #define reallocStep 100
-static void reAlloc (int nCur, int &nMax, int *&r, int *&c, expression **&e) {
+static void reAlloc (int nCur, int &nMax, int *&r, int *&c, expression **&f) {
 
   if (nCur >= nMax) {
 
@@ -90,18 +120,20 @@ static void reAlloc (int nCur, int &nMax, int *&r, int *&c, expression **&e) {
 
     r = (int         *) realloc (r, nMax * sizeof (int));
     c = (int         *) realloc (c, nMax * sizeof (int));
-    e = (expression **) realloc (e, nMax * sizeof (expression *));
+    f = (expression **) realloc (f, nMax * sizeof (expression *));
   }
 }
 
 // constructor
 ExprJac::ExprJac (CouenneProblem *p):
 
-  nnz_   (0),
-  iRow_  (NULL),
-  jCol_  (NULL),
-  expr_  (NULL),
-  nRows_ (0) {
+  nnz_     (0),
+  iRow_    (NULL),
+  jCol_    (NULL),
+  expr_    (NULL),
+  nRows_   (0),
+  func_    (NULL),
+  problem_ (p) {
 
   /// constraints: 
   /// 
@@ -110,13 +142,17 @@ ExprJac::ExprJac (CouenneProblem *p):
   /// ask the problem).
   ///
   /// All other constraints should be part of the jacobian
+  ///
+  /// The sparsity pattern is that of the dependence lists of each
+  /// constraint, which is all Ipopt needs before it evaluates the
+  /// Jacobian. Derivatives are computed in fillExpr ()
 
   /// to be resized on demand
   int 
     cursize   = 0,
     nRealCons = 0;
 
-  reAlloc (nnz_, cursize, iRow_, jCol_, expr_);
+  reAlloc (nnz_, cursize, iRow_, jCol_, func_);
 
   // constraints ////////////////////////////////////////////////////////////
 
@@ -144,30 +180,13 @@ ExprJac::ExprJac (CouenneProblem *p):
       if (p -> Var (*k) -> Multiplicity () <= 0)
 	continue;
 
-      expression 
-	*J = c -> Body () -> differentiate (*k), // derivative of the
-                  	                         // constraint's body
-	                                         // w.r.t. x_i
-
-	*sJ = J -> simplify (),                  // a simplification
-	*rJ = sJ ? sJ : J;                       // the real one
-
-      if (sJ) 
-	delete J; // the only remaining expression won't be wasted
-
-      if ((rJ -> Type  () == CONST) &&
-	  (rJ -> Value () == 0.)) 
-	continue;
-
       // there is a nonzero entry!
 
-      reAlloc (nnz_ + 1, cursize, iRow_, jCol_, expr_);
-
-      rJ -> realign (p);
+      reAlloc (nnz_ + 1, cursize, iRow_, jCol_, func_);
 
       iRow_ [nnz_] = nRealCons;
       jCol_ [nnz_] = *k;
-      expr_ [nnz_] = rJ;
+      func_ [nnz_] = c -> Body ();
 
       nnz_++;
       nTerms++;
@@ -208,32 +227,13 @@ ExprJac::ExprJac (CouenneProblem *p):
       if (p -> Var (*k) -> Multiplicity () <= 0)
 	continue;
 
-      expression 
-	*J = (*k == e -> Index ()) ? 
-  	     new exprConst (-1.) :
-	     e -> Image () -> differentiate (*k), // derivative of the
-	                                          // constraint's body
-			  		          // w.r.t. x_i
-
-	*sJ = J -> simplify (),                   // a simplification
-	*rJ = sJ ? sJ : J;                        // the real one
-
-      if (sJ) 
-	delete J; // the only remaining expression won't be wasted
-
-      if ((rJ -> Type  () == CONST) &&
-	  (rJ -> Value () == 0.)) 
-	continue; 
-
-      rJ -> realign (p);
-
       // there is a nonzero entry!
 
-      reAlloc (nnz_ + 1, cursize, iRow_, jCol_, expr_);
+      reAlloc (nnz_ + 1, cursize, iRow_, jCol_, func_);
 
       iRow_ [nnz_] = nRealCons;
       jCol_ [nnz_] = *k;
-      expr_ [nnz_] = rJ;
+      func_ [nnz_] = (*k == e -> Index ()) ? NULL : e -> Image ();
 
       ++nnz_;
       ++nTerms;
@@ -247,7 +247,36 @@ ExprJac::ExprJac (CouenneProblem *p):
 
 #ifdef DEBUG
   printf ("jacobian: %d nonzeros, %d rows\n", nnz_, nRows_);
+#endif
+}
 
+
+// compute derivatives of all nonzeros
+void ExprJac::fillExpr () const {
+
+  expr_ = (expression **) malloc (nnz_ * sizeof (expression *));
+
+  for (int i=0; i<nnz_; i++) {
+
+    expression 
+      *J = func_ [i] ?
+           func_ [i] -> differentiate (jCol_ [i]) : // derivative of the
+	                                            // constraint's body
+	                                            // w.r.t. x_i
+	   new exprConst (-1.),                     // auxiliary
+
+      *sJ = J -> simplify (),                       // a simplification
+      *rJ = sJ ? sJ : J;                            // the real one
+
+    if (sJ) 
+      delete J; // the only remaining expression won't be wasted
+
+    rJ -> realign (problem_);
+
+    expr_ [i] = rJ;
+  }
+
+#ifdef DEBUG
   for (int i=0; i<nnz_; i++) {
 
     printf ("[%d,%d]: ", iRow_ [i], jCol_ [i]);
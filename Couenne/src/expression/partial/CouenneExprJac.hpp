@@ -16,7 +16,9 @@ namespace Couenne {
   class CouenneProblem;
 
   /// Jacobian of the problem (computed through Couenne expression
-  /// classes).
+  /// classes). Only the sparsity pattern is computed at construction;
+  /// the derivatives are computed symbolically the first time they
+  /// are needed through expr().
 
   class ExprJac {
 
@@ -26,10 +28,21 @@ namespace Couenne {
     int         *iRow_;  ///< row indices (read this way by eval_jac_g)
     int         *jCol_;  ///< col indices
 
-    expression **expr_;  ///< nonzero expression elements (there are nnz_ of them)
+    mutable expression **expr_;  ///< nonzero expression elements (there are nnz_ of them), NULL until needed
 
     int          nRows_; ///< number of actual constraints
 
+    expression **func_;  ///< function (constraint body or auxiliary's image, not owned)
+			 ///< to differentiate for each nonzero. NULL for -1 of auxiliary
+
+    CouenneProblem *problem_; ///< problem the variables refer to
+
+    /// compute derivatives
+    void fillExpr () const;
+
+    /// free all arrays
+    void clear ();
+
   public:
 
     ExprJac  ();
@@ -44,7 +57,12 @@ namespace Couenne {
     int *iRow () const {return iRow_;}
     int *jCol () const {return jCol_;}
 
-    expression **expr () const {return expr_;}
+    /// Derivatives, computed at the first call
+    expression **expr () const {
+      if (!expr_ && nnz_)
+	fillExpr ();
+      return expr_;
+    }
 
     int nRows () const {return nRows_;}
   };
@@ -18,9 +18,13 @@
 //#include "CbcBranchActual.hpp"
 #include "BonAuxInfos.hpp"
 #include "CoinHelperFunctions.hpp"
+#include "CoinWarmStartPrimalDual.hpp"
+#include "CouenneNlpMemo.hpp"
 #include "BonOsiTMINLPInterface.hpp"
 #include "BonNlpHeuristic.hpp"
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneTrace.hpp"
+#include "CouenneProfile.hpp"
 
 using namespace Ipopt;
 using namespace Couenne;
@@ -31,14 +35,24 @@ NlpSolveHeuristic::NlpSolveHeuristic():
   hasCloned_(false),
   maxNlpInf_(maxNlpInf_0),
   numberSolvePerLevel_(-1),
-  couenne_(NULL){
+  couenne_(NULL),
+  useWarmStart_(true),
+  warmStart_(NULL),
+  nNlpSolves_(0),
+  nSkipped_(0),
+  nWarmStarted_(0){
   setHeuristicName("NlpSolveHeuristic");
 }
   
 NlpSolveHeuristic::NlpSolveHeuristic(CbcModel & model, Bonmin::OsiTMINLPInterface &nlp, bool cloneNlp, CouenneProblem * couenne):
   CbcHeuristic(model), nlp_(&nlp), hasCloned_(cloneNlp),maxNlpInf_(maxNlpInf_0),
   numberSolvePerLevel_(-1),
-  couenne_(couenne){
+  couenne_(couenne),
+  useWarmStart_(true),
+  warmStart_(NULL),
+  nNlpSolves_(0),
+  nSkipped_(0),
+  nWarmStarted_(0){
   setHeuristicName("NlpSolveHeuristic");
   if(cloneNlp)
     nlp_ = dynamic_cast <Bonmin::OsiTMINLPInterface *> (nlp.clone());
@@ -49,7 +63,12 @@ NlpSolveHeuristic::NlpSolveHeuristic(const NlpSolveHeuristic & other):
   hasCloned_(other.hasCloned_),
   maxNlpInf_(other.maxNlpInf_),
   numberSolvePerLevel_(other.numberSolvePerLevel_),
-  couenne_(other.couenne_){
+  couenne_(other.couenne_),
+  useWarmStart_(other.useWarmStart_),
+  warmStart_(other.warmStart_ ? new CoinWarmStartPrimalDual (*(other.warmStart_)) : NULL),
+  nNlpSolves_(other.nNlpSolves_),
+  nSkipped_(other.nSkipped_),
+  nWarmStarted_(other.nWarmStarted_){
   if(hasCloned_ && nlp_ != NULL)
     nlp_ = dynamic_cast <Bonmin::OsiTMINLPInterface *> (other.nlp_->clone());
 }
@@ -77,13 +96,22 @@ NlpSolveHeuristic::operator=(const NlpSolveHeuristic & rhs){
   maxNlpInf_ = rhs.maxNlpInf_;
   numberSolvePerLevel_ = rhs.numberSolvePerLevel_;
   couenne_ = rhs.couenne_;
+  useWarmStart_ = rhs.useWarmStart_;
+  if (this != &rhs) {
+    delete warmStart_;
+    warmStart_ = rhs.warmStart_ ? new CoinWarmStartPrimalDual (*(rhs.warmStart_)) : NULL;
+  }
+  nNlpSolves_ = rhs.nNlpSolves_;
+  nSkipped_ = rhs.nSkipped_;
+  nWarmStarted_ = rhs.nWarmStarted_;
   return *this;
 }
-  
+
 NlpSolveHeuristic::~NlpSolveHeuristic(){
   if(hasCloned_)
     delete nlp_;
   nlp_ = NULL;
+  delete warmStart_;
 }
   
 void
@@ -119,6 +147,8 @@ NlpSolveHeuristic::solution (double & objectiveValue, double * newSolution) {
 
   const int depth = (model_ -> currentNode ()) ? model_ -> currentNode () -> depth () : 0;
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_NLPHEUR);
+
   if (depth <= 0)
     couenne_ -> Jnlst () -> Printf (J_ERROR, J_COUENNE, "NLP Heuristic: "); fflush (stdout);
 
@@ -305,21 +335,97 @@ NlpSolveHeuristic::solution (double & objectiveValue, double * newSolution) {
       else if (Y [i] > upper [i]) Y [i] = upper [i];
     }
 
+    // skip this call if the same integer assignment was already
+    // tried, by this or another heuristic
+
+    CouenneNlpMemo *memo = couenne_ -> nlpMemo ();
+
+    unsigned long memoKey = memo -> enabled () ? memo -> key (lower, upper) : 0;
+
+    if (memoKey &&
+	memo -> find (memoKey, lower, lower, upper)) {
+
+      ++nSkipped_;
+
+      couenne_ -> Jnlst () -> Printf (J_ALL, J_NLPHEURISTIC,
+				      "NLP heuristic: integer assignment already tried, skipping\n");
+
+      delete [] saveColLower;
+      delete [] saveColUpper;
+      delete [] Y;
+      delete [] lower;
+      delete [] upper;
+
+      throw noSolution;
+    }
+
     nlp_ -> setColLower    (lower);
     nlp_ -> setColUpper    (upper);
     nlp_ -> setColSolution (Y);
 
+    // Ipopt only uses warm start information in "optimum" mode, set
+    // it only for the duration of this call as nlp_ may be shared
+    Bonmin::OsiTMINLPInterface::WarmStartModes wsMode = nlp_ -> getWarmStartMode ();
+
+    bool warmStarted = false;
+
+    if (useWarmStart_) {
+
+      nlp_ -> setWarmStartMode (Bonmin::OsiTMINLPInterface::Optimum);
+
+      // use the current starting point with the duals of the last
+      // local solution
+      if (warmStart_ &&
+	  (warmStart_ -> primalSize () == nlp_ -> getNumCols ())) {
+
+	CoinWarmStartPrimalDual ws (nlp_ -> getNumCols (), warmStart_ -> dualSize (),
+				    Y, warmStart_ -> dual ());
+
+	warmStarted = nlp_ -> setWarmStart (&ws);
+      }
+    }
+
     // apply NLP solver /////////////////////////////////
     try {
+      ++nNlpSolves_;
       nlp_ -> options () -> SetNumericValue ("max_cpu_time", CoinMax (0.1, couenne_ -> getMaxCpuTime () - CoinCpuTime ()));
-      nlp_ -> initialSolve ();
+      if (warmStarted) {
+	++nWarmStarted_;
+	nlp_ -> resolve ();
+      } else nlp_ -> initialSolve ();
     }
     catch (Bonmin::TNLPSolver::UnsolvedError *E) {}
 
+    if (useWarmStart_) {
+
+      // save primal/dual solution for next call
+      if (nlp_ -> isProvenOptimal ()) {
+
+	CoinWarmStart *ws = nlp_ -> getWarmStart ();
+	CoinWarmStartPrimalDual *pdws = dynamic_cast <CoinWarmStartPrimalDual *> (ws);
+
+	if (pdws && (pdws -> dualSize () > 0)) {
+	  delete warmStart_;
+	  warmStart_ = new CoinWarmStartPrimalDual (*pdws);
+	}
+
+	delete ws;
+      }
+
+      nlp_ -> setWarmStart     (NULL);
+      nlp_ -> setWarmStartMode (wsMode);
+    }
+
     double obj = (nlp_ -> isProvenOptimal()) ? nlp_ -> getObjValue (): COIN_DBL_MAX;
 
-    if (nlp_ -> isProvenOptimal () &&
-	couenne_ -> checkNLP (nlp_ -> getColSolution (), obj, true) && // true for recomputing obj
+    bool isFeasible =
+      nlp_ -> isProvenOptimal () &&
+      couenne_ -> checkNLP (nlp_ -> getColSolution (), obj, true); // true for recomputing obj
+
+    if (memoKey)
+      memo -> insert (memoKey, lower, lower, upper, obj, isFeasible, nlp_ -> getColSolution ());
+
+    if (isFeasible &&
 	(obj < couenne_ -> getCutOff ())) {
 
       // store solution in Aux info
@@ -388,6 +494,10 @@ NlpSolveHeuristic::solution (double & objectiveValue, double * newSolution) {
     delete [] saveColUpper;
   }
 
+  couenne_ -> Jnlst () -> Printf (J_DETAILED, J_NLPHEURISTIC,
+				  "NLP heuristic: %d NLPs solved (%d warm started), %d skipped as already tried\n",
+				  nNlpSolves_, nWarmStarted_, nSkipped_);
+
   delete [] Y;
 
   delete [] lower;
@@ -399,6 +509,11 @@ NlpSolveHeuristic::solution (double & objectiveValue, double * newSolution) {
     else               printf ("no solution.\n");
   }
 
+  CouenneTrace::event (CouenneTrace::TRACE_HEURISTIC, foundSolution ? 1 : 0, objectiveValue);
+
+  if (foundSolution)
+    timer.solution ();
+
   return foundSolution;
 
   }
@@ -409,6 +524,8 @@ NlpSolveHeuristic::solution (double & objectiveValue, double * newSolution) {
 
     bool output = couenne_ -> Jnlst () -> ProduceOutput (J_ERROR, J_COUENNE) && (depth <= 0);
 
+    CouenneTrace::event (CouenneTrace::TRACE_HEURISTIC, ((e != noSolution) && (e != maxTime)) ? 1 : 0, objectiveValue);
+
     if      (e==noSolution) {if (output) printf ("no solution.\n");                            return 0;}
     else if (e==maxTime)    {if (output) printf ("time limit reached.\n");                     return 0;}
     else                    {if (output) printf ("solution found, obj. %g\n", objectiveValue); return 1;}
@@ -453,4 +570,13 @@ void NlpSolveHeuristic::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOpti
      "For example if parameter is 8, nlp's are solved for all node until level 8, " 
      "then for half the node at level 9, 1/4 at level 10.... "
      "Value -1 specify to perform at all nodes.");
+
+  roptions -> AddStringOption2
+    ("local_optimization_warm_start",
+     "Warm start local optimizations with the primal/dual information of the last local solution",
+     "yes",
+     "no","",
+     "yes","",
+     "If enabled, the NLP heuristic passes the dual information of the last successful local optimization "
+     "to Ipopt, rather than starting each solve from scratch.");
 }
@@ -16,6 +16,8 @@
 #include "BonOsiTMINLPInterface.hpp"
 #include "CouenneProblem.hpp"
 
+class CoinWarmStartPrimalDual;
+
 namespace Couenne {
 
   /** A heuristic to call an NlpSolver if all CouenneObjects are close
@@ -63,6 +65,17 @@ namespace Couenne {
     /** set number of nlp's solved for each given level of the tree*/
     void setNumberSolvePerLevel(int value){
       numberSolvePerLevel_ = value;}
+    /** use primal/dual information of the last local solution to
+	warm start Ipopt */
+    void setWarmStart(bool value){
+      useWarmStart_ = value;}
+
+    /** number of calls to the NLP solver */
+    int nNlpSolves () const {return nNlpSolves_;}
+    /** number of calls skipped as their integer pattern was already tried */
+    int nSkipped () const {return nSkipped_;}
+    /** number of calls to the NLP solver that were warm started */
+    int nWarmStarted () const {return nWarmStarted_;}
 
     /// initialize options
     static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions>);
@@ -78,6 +91,14 @@ namespace Couenne {
     int numberSolvePerLevel_;
     /** Pointer to a couenne representation of the problem. */
     CouenneProblem * couenne_;
+    /** warm start with primal/dual solution of last local solve?*/
+    bool useWarmStart_;
+    /** primal/dual solution of the last successful local solve */
+    CoinWarmStartPrimalDual * warmStart_;
+    /** statistics: NLP solved, calls skipped, warm started solves */
+    int nNlpSolves_;
+    int nSkipped_;
+    int nWarmStarted_;
   };
 
 }
@@ -21,6 +21,8 @@
 #include "CouenneTNLP.hpp"
 #include "CouenneFPpool.hpp"
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneNlpMemo.hpp"
+#include "CouenneProfile.hpp"
 
 #ifdef COIN_HAS_SCIP
 /* general SCIP includes */
@@ -50,6 +52,8 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
    		                   (depth - numberSolvePerLevel_ + 1))))))
     return 0;
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_FEASPUMP);
+
   problem_ -> Jnlst () -> Printf (J_WARNING, J_NLPHEURISTIC, "==================================================== FP: BEGIN\n");
 
   problem_ -> Jnlst () -> Printf (J_ERROR, J_NLPHEURISTIC, "[FeasPump] Initializing\n");
@@ -664,11 +668,32 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
 
     problem_ -> domain () -> push (*(problem_ -> domain () -> current ()));
 
+    // the NLP with this integer assignment may have been solved
+    // already, by this or another heuristic: its solution, if
+    // feasible, has then been recorded
+
+    CouenneNlpMemo *memo = problem_ -> nlpMemo ();
+
+    // bounds of the continuous variables at this node, before
+    // fixIntVariables tightens them
+    std::vector <CouNumber>
+      memoLb (problem_ -> Lb (), problem_ -> Lb () + problem_ -> nVars ()),
+      memoUb (problem_ -> Ub (), problem_ -> Ub () + problem_ -> nVars ());
+
+    unsigned long memoKey = memo -> enabled () ? memo -> key (best, &(memoLb [0]), &(memoUb [0])) : 0;
+
+    // solution of the final NLP
+    double *fSol = NULL;
+
+    if (memoKey && memo -> find (memoKey, best, &(memoLb [0]), &(memoUb [0])))
+
+      problem_ -> Jnlst () -> Printf (J_WARNING, J_NLPHEURISTIC, "FP: final NLP already solved, skipping\n");
+
     // fix integer coordinates of current (MINLP feasible!) solution
     // and, if feasible, set it as initial (obviously NLP feasible)
     // solution
 
-    if (fixIntVariables (best)) {
+    else if (fixIntVariables (best)) {
 
       nlp_ -> setInitSol (best);
 
@@ -702,17 +727,22 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
       // check if newly found NLP solution is also integer (unlikely...)
       bool isChecked = false;
 
-      if (nSol) {
+      if (nlp_ -> getSolution ()) {
 
 	problem_ -> Jnlst () -> Printf (J_WARNING, J_NLPHEURISTIC, "FP: found nlp solution, check it\n");
 
-	isChecked = problem_ -> checkNLP0 (nSol, z, true,
+	fSol = CoinCopyOfArray (nlp_ -> getSolution (), problem_ -> nVars ());
+
+	isChecked = problem_ -> checkNLP0 (fSol, z, true,
 					   false,
 					   true,
 					   true);
       }
 
-      if (nSol &&
+      if (memoKey)
+	memo -> insert (memoKey, best, &(memoLb [0]), &(memoUb [0]), z, isChecked, fSol);
+
+      if (fSol &&
 	  isChecked &&
 	  (z < problem_ -> getCutOff ())) {
 
@@ -723,7 +753,7 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
 #ifdef FM_CHECKNLP2
 	problem_->getRecordBestSol()->update();
 #else
-	problem_->getRecordBestSol()->update(nSol, problem_->nVars(), z, problem_->getFeasTol());
+	problem_->getRecordBestSol()->update(fSol, problem_->nVars(), z, problem_->getFeasTol());
 #endif
 	best = problem_->getRecordBestSol()->getSol();
 	objVal = problem_->getRecordBestSol()->getVal();
@@ -732,7 +762,7 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
 #ifdef FM_CHECKNLP2
 	best = problem_->getRecordBestSol()->getModSol(problem_ -> nVars ());
 #else
-	best   = nSol;
+	best   = fSol;
 #endif
 	objVal = z;
 #endif
@@ -749,6 +779,8 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
     }
 
     CoinCopyN (best, problem_ -> nVars (), newSolution);
+
+    if (fSol) delete [] fSol;
   }
 
   if (iSol) delete [] iSol;
@@ -768,6 +800,9 @@ int CouenneFeasPump::solution (double &objVal, double *newSolution) {
   problem_ -> Jnlst () -> Printf 
     (J_WARNING, J_NLPHEURISTIC, "FP: done ===================\n");
 
+  if (retval > 0)
+    timer.solution ();
+
   return retval;
 }
 
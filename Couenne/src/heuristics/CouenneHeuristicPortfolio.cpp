@@ -0,0 +1,305 @@
+/* $Id$
+ *
+ * Name:    CouenneHeuristicPortfolio.cpp
+ * Author:  Pietro Belotti
+ * Purpose: Run Couenne's primal heuristics as a portfolio, ordered
+ *          by their past yield
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <algorithm>
+
+#include "CoinTime.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CbcModel.hpp"
+
+#include "CouenneProblem.hpp"
+#include "CouenneHeuristicPortfolio.hpp"
+
+using namespace Ipopt;
+using namespace Couenne;
+
+/// Constructor
+CouenneHeuristicPortfolio::CouenneHeuristicPortfolio (CouenneProblem *p, bool stopAtFirst):
+  CbcHeuristic (),
+  problem_     (p),
+  jnlst_       (p ? p -> Jnlst () : NULL),
+  stopAtFirst_ (stopAtFirst),
+  stats_       (new std::vector <Stats>),
+  refCount_    (new int (1)) {
+
+  setHeuristicName ("Couenne heuristic portfolio");
+}
+
+
+/// Copy constructor (clones heuristics, shares statistics)
+CouenneHeuristicPortfolio::CouenneHeuristicPortfolio (const CouenneHeuristicPortfolio &rhs):
+  CbcHeuristic (rhs),
+  problem_     (rhs.problem_),
+  jnlst_       (rhs.jnlst_),
+  stopAtFirst_ (rhs.stopAtFirst_),
+  names_       (rhs.names_),
+  stats_       (rhs.stats_),
+  refCount_    (rhs.refCount_),
+  canRun_      (rhs.canRun_) {
+
+  ++ (*refCount_);
+
+  for (std::vector <CbcHeuristic *>::const_iterator i = rhs.heuristics_.begin ();
+       i != rhs.heuristics_.end (); ++i)
+    heuristics_.push_back ((*i) -> clone ());
+}
+
+
+/// Destructor. The last copy prints the statistics
+CouenneHeuristicPortfolio::~CouenneHeuristicPortfolio () {
+
+  clear ();
+  release ();
+}
+
+
+/// Drop this copy's reference to the statistics, print and free them
+/// if it was the last one
+void CouenneHeuristicPortfolio::release () {
+
+  if (-- (*refCount_))
+    return;
+
+  if (IsValid (jnlst_))
+    for (int i=0; i < (int) stats_ -> size (); i++)
+      if ((*stats_) [i]. nCalls_)
+	jnlst_ -> Printf (J_ITERSUMMARY, J_NLPHEURISTIC,
+			  "Heuristic portfolio: %-30s %6d calls, %5d solutions, %10.2fs\n",
+			  names_ [i]. c_str (),
+			  (*stats_) [i]. nCalls_,
+			  (*stats_) [i]. nSuccess_,
+			  (*stats_) [i]. time_);
+  delete stats_;
+  delete refCount_;
+}
+
+
+/// Assignment operator
+CouenneHeuristicPortfolio &CouenneHeuristicPortfolio::operator= (const CouenneHeuristicPortfolio &rhs) {
+
+  if (this != &rhs) {
+
+    CbcHeuristic::operator= (rhs);
+
+    clear ();
+    release ();
+
+    problem_     = rhs.problem_;
+    jnlst_       = rhs.jnlst_;
+    stopAtFirst_ = rhs.stopAtFirst_;
+    names_       = rhs.names_;
+    stats_       = rhs.stats_;
+    refCount_    = rhs.refCount_;
+    canRun_      = rhs.canRun_;
+
+    ++ (*refCount_);
+
+    for (std::vector <CbcHeuristic *>::const_iterator i = rhs.heuristics_.begin ();
+	 i != rhs.heuristics_.end (); ++i)
+      heuristics_.push_back ((*i) -> clone ());
+  }
+
+  return *this;
+}
+
+
+/// free heuristics
+void CouenneHeuristicPortfolio::clear () {
+
+  for (std::vector <CbcHeuristic *>::iterator i = heuristics_.begin ();
+       i != heuristics_.end (); ++i)
+    delete (*i);
+
+  heuristics_.clear ();
+}
+
+
+/// Add heuristic to the portfolio
+void CouenneHeuristicPortfolio::addHeuristic (CbcHeuristic *h, const char *name) {
+
+  Stats s;
+
+  s.nCalls_   = 0;
+  s.nSuccess_ = 0;
+  s.time_     = 0.;
+
+  heuristics_. push_back (h);
+  names_.      push_back (name);
+  stats_ ->    push_back (s);
+  canRun_.     push_back (true);
+
+  if (model_)
+    h -> setModel (model_);
+}
+
+
+/// Set model in all heuristics
+void CouenneHeuristicPortfolio::setModel (CbcModel *model) {
+
+  CbcHeuristic::setModel (model);
+
+  for (std::vector <CbcHeuristic *>::iterator i = heuristics_.begin ();
+       i != heuristics_.end (); ++i)
+    (*i) -> setModel (model);
+}
+
+
+/// Reset model in all heuristics
+void CouenneHeuristicPortfolio::resetModel (CbcModel *model) {
+
+  model_ = model;
+
+  for (std::vector <CbcHeuristic *>::iterator i = heuristics_.begin ();
+       i != heuristics_.end (); ++i)
+    (*i) -> resetModel (model);
+}
+
+
+/// Validate all heuristics
+void CouenneHeuristicPortfolio::validate () {
+
+  CbcHeuristic::validate ();
+
+  for (std::vector <CbcHeuristic *>::iterator i = heuristics_.begin ();
+       i != heuristics_.end (); ++i)
+    (*i) -> validate ();
+}
+
+
+/// Check which heuristics can run at this point of the search
+bool CouenneHeuristicPortfolio::shouldHeurRun (int whereFrom) {
+
+  bool retval = false;
+
+  for (int i=0; i < nHeuristics (); i++)
+    if ((canRun_ [i] = heuristics_ [i] -> shouldHeurRun (whereFrom)))
+      retval = true;
+
+  return retval;
+}
+
+
+/// yield of heuristic i: expected number of solutions per second.
+/// Heuristics never run get the highest yield, so that all of them
+/// are tried at least once
+double CouenneHeuristicPortfolio::score (int i) const {
+
+  const Stats &s = (*stats_) [i];
+
+  if (!s.nCalls_)
+    return COIN_DBL_MAX;
+
+  return (1. + s.nSuccess_) / (1. + s.nCalls_) / CoinMax (1e-3, s.time_ / s.nCalls_);
+}
+
+
+namespace {
+
+  /// order heuristics by decreasing score
+  struct compScore {
+
+    const std::vector <double> &score_;
+
+    compScore (const std::vector <double> &score): score_ (score) {}
+
+    bool operator () (int a, int b) const
+    {return (score_ [a] > score_ [b]);}
+  };
+}
+
+
+/// Run heuristics in order of yield
+int CouenneHeuristicPortfolio::solution (double &objectiveValue, double *newSolution) {
+
+  int
+    n      = nHeuristics (),
+    retval = 0,
+    depth  = model_ ? model_ -> currentDepth () : 0,
+    nCols  = model_ ? model_ -> solver () -> getNumCols () : 0;
+
+  std::vector <int>    order (n);
+  std::vector <double> scores (n);
+
+  for (int i=0; i<n; i++) {
+    order  [i] = i;
+    scores [i] = score (i);
+  }
+
+  std::stable_sort (order.begin (), order.end (), compScore (scores));
+
+  double *sol = new double [nCols];
+
+  for (int j=0; j<n; j++) {
+
+    int i = order [j];
+
+    if (!canRun_ [i])
+      continue;
+
+    if (problem_ &&
+	(CoinCpuTime () > problem_ -> getMaxCpuTime ()))
+      break;
+
+    double
+      value = objectiveValue,
+      start = CoinCpuTime ();
+
+    int found = heuristics_ [i] -> solution (value, sol);
+
+    ++ ((*stats_) [i]. nCalls_);
+    (*stats_) [i]. time_ += CoinCpuTime () - start;
+
+    if ((found > 0) && (value < objectiveValue)) {
+
+      ++ ((*stats_) [i]. nSuccess_);
+
+      heuristics_ [i] -> incrementNumberSolutionsFound ();
+
+      // publish the incumbent right away: the heuristics run next
+      // use the new cutoff
+
+      objectiveValue = value;
+      CoinCopyN (sol, nCols, newSolution);
+
+      if (problem_) {
+
+	problem_ -> Jnlst () -> Printf (J_ITERSUMMARY, J_NLPHEURISTIC,
+					"Heuristic portfolio: %s found solution %g\n",
+					names_ [i]. c_str (), value);
+
+	if (value < problem_ -> getCutOff ())
+	  problem_ -> setCutOff (value);
+      }
+
+      retval = 1;
+
+      if (stopAtFirst_ && depth > 0)
+	break;
+    }
+  }
+
+  delete [] sol;
+
+  return retval;
+}
+
+
+/// Add options to the list
+void CouenneHeuristicPortfolio::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddStringOption3
+    ("heuristic_portfolio",
+     "Run Couenne's primal heuristics as a portfolio ordered by their past yield",
+     "no",
+     "no",   "Run heuristics separately, in fixed order",
+     "yes",  "Run all heuristics, in decreasing order of solutions found per second",
+     "stop", "As yes, but stop at the first improving solution below the root node",
+     "The heuristics for which the portfolio is used are the NLP heuristic, iterative rounding, and the feasibility pump.");
+}
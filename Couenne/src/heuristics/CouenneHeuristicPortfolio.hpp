@@ -0,0 +1,135 @@
+/* $Id$
+ *
+ * Name:    CouenneHeuristicPortfolio.hpp
+ * Author:  Pietro Belotti
+ * Purpose: Run Couenne's primal heuristics as a portfolio, ordered
+ *          by their past yield
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#ifndef CouenneHeuristicPortfolio_HPP
+#define CouenneHeuristicPortfolio_HPP
+
+#include <vector>
+#include <string>
+
+#include "CbcHeuristic.hpp"
+#include "BonRegisteredOptions.hpp"
+#include "CouenneJournalist.hpp"
+
+namespace Couenne {
+
+  class CouenneProblem;
+
+  /// Portfolio of primal heuristics. At every call, the heuristics
+  /// are run in decreasing order of solutions found per second of
+  /// CPU time spent, so that the one most likely to quickly find an
+  /// incumbent runs first. All heuristics in the portfolio publish
+  /// their incumbent in the CouenneProblem as soon as they find it,
+  /// hence the following heuristics run with the improved
+  /// cutoff. Below the root node, the portfolio can stop at the first
+  /// improving solution.
+  ///
+  /// Statistics are shared by all copies of a portfolio, so that the
+  /// copy used by Cbc updates those of the original; they are printed
+  /// once, when the last copy is destroyed. Heuristics should be added
+  /// before the portfolio is copied.
+  ///
+  /// Heuristics are run one after the other: the NLP heuristic and
+  /// iterative rounding solve their NLPs through the same
+  /// CouenneInterface, hence the same Ipopt application, and all of
+  /// them read and modify the LP solver of the CbcModel.
+
+  class CouenneHeuristicPortfolio: public CbcHeuristic {
+
+  public:
+
+    /// Constructor
+    CouenneHeuristicPortfolio (CouenneProblem *p = NULL, bool stopAtFirst = true);
+
+    /// Copy constructor (clones heuristics, shares statistics)
+    CouenneHeuristicPortfolio (const CouenneHeuristicPortfolio &rhs);
+
+    /// Destructor
+    virtual ~CouenneHeuristicPortfolio ();
+
+    /// Assignment operator
+    CouenneHeuristicPortfolio &operator= (const CouenneHeuristicPortfolio &rhs);
+
+    /// Clone
+    virtual CbcHeuristic *clone () const
+    {return new CouenneHeuristicPortfolio (*this);}
+
+    /// Add heuristic to the portfolio (it is owned by the portfolio
+    /// from now on)
+    void addHeuristic (CbcHeuristic *h, const char *name);
+
+    /// number of heuristics in the portfolio
+    int nHeuristics () const {return (int) heuristics_.size ();}
+
+    /// Set model in all heuristics
+    virtual void setModel (CbcModel *model);
+
+    /// Reset model in all heuristics
+    virtual void resetModel (CbcModel *model);
+
+    /// Validate all heuristics
+    virtual void validate ();
+
+    /// Check which heuristics can run at this point of the search
+    virtual bool shouldHeurRun (int whereFrom);
+
+    /// Run heuristics in order of yield. Return 1 if an improving
+    /// solution was found, 0 otherwise
+    virtual int solution (double &objectiveValue, double *newSolution);
+
+    /// Add options to the list
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+  protected:
+
+    /// Statistics of a single heuristic
+    struct Stats {
+
+      int    nCalls_;    ///< number of calls
+      int    nSuccess_;  ///< number of improving solutions found
+      double time_;      ///< total CPU time
+    };
+
+    /// free heuristics
+    void clear ();
+
+    /// drop reference to the statistics, print and free them if last
+    void release ();
+
+    /// yield of heuristic i: expected number of solutions per second
+    double score (int i) const;
+
+    /// Pointer to the problem, to publish solutions
+    CouenneProblem *problem_;
+
+    /// Journalist (the problem may be deleted before the portfolio)
+    ConstJnlstPtr jnlst_;
+
+    /// Stop at first improving solution below the root node
+    bool stopAtFirst_;
+
+    /// Heuristics
+    std::vector <CbcHeuristic *> heuristics_;
+
+    /// Names of the heuristics (for output)
+    std::vector <std::string> names_;
+
+    /// Statistics, shared among copies of this object
+    std::vector <Stats> *stats_;
+
+    /// number of copies sharing stats_
+    int *refCount_;
+
+    /// Heuristics that can run at the current call
+    std::vector <bool> canRun_;
+  };
+}
+
+#endif
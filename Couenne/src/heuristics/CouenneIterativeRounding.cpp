@@ -17,6 +17,8 @@
 #endif
 
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneNlpMemo.hpp"
+#include "CouenneProfile.hpp"
 
 #define MILPTIME 5
 #define CBCMILPTIME 20
@@ -358,6 +360,8 @@ namespace Couenne{
 
     numSol_ = model_->getSolutionCount();
 
+    CouenneProfile::Timer timer (CouenneProfile::PROF_ITERROUND);
+
     std::cout << "Launching IterativeRounding with parameters:" << std::endl;
     std::cout << "Max rounding iter: " << maxRoundingIter_ << std::endl;
     std::cout << "Max feas point: " << maxFirPoints_ << std::endl;
@@ -543,23 +547,10 @@ namespace Couenne{
 	    cinlp_->setColUpper(i, tmpSolution[i]);
 	  }
 	}
-	cinlp_->setColSolution(tmpSolution);
-
-	cinlp_->messageHandler()->setLogLevel(1);
-	cinlp_->resolve();
-	obj = ((cinlp_->isProvenOptimal()) ? 
-	       cinlp_->getObjValue():COIN_DBL_MAX);
-	memcpy(tmpSolution, cinlp_->getColSolution(), 
-	       nNlp*sizeof(double));
-	// check solution of the NLP;
+	// solve NLP and check its solution;
 	// if we have a new incumbent we are done, otherwise we iterate
 
-	bool isChecked = false;
-
-	isChecked = couenne_ -> checkNLP0 (tmpSolution, obj, true,
-					   false,
-					   true,
-					   false);
+	bool isChecked = solveFixedNlp(tmpSolution, nNlp, obj);
 
 // #ifdef FM_CHECKNLP2
 // 	isChecked = couenne_->checkNLP2(tmpSolution, 0, false, // do not care about obj
@@ -573,8 +564,7 @@ namespace Couenne{
 // 	isChecked = couenne_->checkNLP(tmpSolution, obj, true);
 // #endif  /* not FM_CHECKNLP2 */
 	
-	if (cinlp_->isProvenOptimal () &&
-	    isChecked &&
+	if (isChecked &&
 	    (obj < couenne_->getCutOff())) {
 	  
 #ifdef FM_CHECKNLP2
@@ -886,22 +876,10 @@ namespace Couenne{
 	  cinlp_->setColUpper(i, tmpSolution[i]);
 	}
       }
-      cinlp_->setColSolution(tmpSolution);
-
-      cinlp_->messageHandler()->setLogLevel(1);
-      cinlp_->resolve();
-      obj = ((cinlp_->isProvenOptimal()) ? cinlp_->getObjValue():COIN_DBL_MAX);
-      memcpy(tmpSolution, cinlp_->getColSolution(), 
-	     nNlp*sizeof(double));
-      // check solution of the NLP;
+      // solve NLP and check its solution;
       // if we have a new incumbent we are done, otherwise we iterate
 
-      bool isChecked = false;
-
-      isChecked = couenne_ -> checkNLP0 (tmpSolution, obj, true,
-					 false,
-					 true,
-					 false);
+      bool isChecked = solveFixedNlp(tmpSolution, nNlp, obj);
 
 // #ifdef FM_CHECKNLP2
 //       isChecked = couenne_->checkNLP2(tmpSolution, 0, false, // do not care about obj
@@ -915,8 +893,7 @@ namespace Couenne{
 //       isChecked = couenne_->checkNLP(tmpSolution, obj, true);
 // #endif  /* not FM_CHECKNLP2 */
       
-      if (cinlp_->isProvenOptimal () &&
-	  isChecked &&
+      if (isChecked &&
 	  (obj < couenne_->getCutOff())) {
 	
 #ifdef FM_CHECKNLP2
@@ -1238,4 +1215,53 @@ namespace Couenne{
 
   }
 
+  bool
+  CouenneIterativeRounding::solveFixedNlp(double* sol, int nNlp, double& obj){
+
+    CouenneNlpMemo *memo = couenne_->nlpMemo();
+
+    // the NLP is identified by the integer assignment and by the
+    // bounds on the continuous variables
+    const double *lb = cinlp_->getColLower();
+    const double *ub = cinlp_->getColUpper();
+
+    unsigned long key = memo->enabled() ? memo->key(sol, lb, ub) : 0;
+
+    const CouenneNlpMemo::Entry *entry = key ? memo->find(key, sol, lb, ub) : NULL;
+
+    if (entry){
+      // this integer assignment was already tried, possibly by
+      // another heuristic: no need to solve the NLP again
+      obj = entry->obj_;
+      if (entry->sol_)
+	memcpy(sol, entry->sol_, CoinMin(nNlp, couenne_->nOrigVars())*sizeof(double));
+      return entry->feasible_;
+    }
+
+    cinlp_->setColSolution(sol);
+
+    cinlp_->messageHandler()->setLogLevel(1);
+    cinlp_->resolve();
+    obj = ((cinlp_->isProvenOptimal()) ? cinlp_->getObjValue():COIN_DBL_MAX);
+
+    bool isChecked = false;
+
+    if (cinlp_->isProvenOptimal()){
+
+      // integer variables are fixed, hence sol and the NLP solution
+      // have the same key
+      memcpy(sol, cinlp_->getColSolution(), nNlp*sizeof(double));
+
+      isChecked = couenne_ -> checkNLP0 (sol, obj, true,
+					 false,
+					 true,
+					 false);
+    }
+
+    if (key)
+      memo->insert(key, sol, lb, ub, obj, isChecked, sol);
+
+    return isChecked;
+  }
+
 }/** Ends namespace Couenne.*/
@@ -210,6 +210,12 @@ private:
 
     /** Solve the MILP contained in milp to feasibility, or report failure */
     bool solveMilp(OsiSolverInterface* milp, double maxTime);
+
+    /** Solve the NLP with integer variables fixed (as in the bounds
+	of cinlp_) from starting point sol, unless an NLP with the
+	same integer assignment was solved before. Return true if
+	the NLP solution, copied in sol, is MINLP feasible */
+    bool solveFixedNlp(double* sol, int nNlp, double& obj);
   };
 }/* Ends namespace Couenne. */
 
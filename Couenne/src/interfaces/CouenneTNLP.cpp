@@ -21,6 +21,7 @@
 #include <stdio.h>
 
 #include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
 #include "CoinFinite.hpp"
 
 //#define DEBUG
@@ -65,7 +66,7 @@ CouenneTNLP::CouenneTNLP (CouenneProblem *p):
   sol_            (NULL),
   bestZ_          (COIN_DBL_MAX),
   Jac_            (p),
-  HLa_            (new ExprHess (p)),
+  HLa_            (NULL),
   optHessian_     (NULL),
   saveOptHessian_ (false) {
 
@@ -154,6 +155,26 @@ CouenneTNLP *CouenneTNLP::clone ()
 {return new CouenneTNLP (*this);}
 
 
+/// Return Hessian, computing it if needed. Symbolic second
+/// derivatives are expensive to compute and store, hence they are
+/// only computed when an NLP is actually solved
+ExprHess *CouenneTNLP::HLa () {
+
+  if (!HLa_) {
+
+    double now = CoinCpuTime ();
+
+    HLa_ = new ExprHess (problem_);
+
+    problem_ -> Jnlst () -> Printf (Ipopt::J_DETAILED, J_NLPHEURISTIC,
+				    "Hessian of the Lagrangian: %d nonzeros, computed in %gs\n",
+				    HLa_ -> nnz (), CoinCpuTime () - now);
+  }
+
+  return HLa_;
+}
+
+
 // overload this method to return the number of variables and
 // constraints, and the number of non-zeros in the jacobian and the
 // hessian. The index_style parameter lets you specify C or Fortran
@@ -167,8 +188,8 @@ bool CouenneTNLP::get_nlp_info (Index& n,
   n = problem_ -> nVars ();
   m = Jac_. nRows ();
 
-  nnz_jac_g = Jac_ .  nnz ();
-  nnz_h_lag = HLa_ -> nnz ();
+  nnz_jac_g = Jac_  . nnz ();
+  nnz_h_lag = HLa () -> nnz ();
 
   index_style = C_STYLE; // what else? ;-)
 
@@ -469,7 +490,7 @@ bool CouenneTNLP::eval_jac_g (Index n, const Number* x, bool new_x,
     // fill in Jacobian's values. Evaluate each member using the
     // domain modified above by the new value of x
 
-    register expression **e = Jac_. expr ();
+    register expression **e = Jac_. expr (); // computed at first call
 
     for (register int i=nele_jac; i--;)
       *values++ = (**(e++)) ();
@@ -525,8 +546,8 @@ bool CouenneTNLP::eval_h (Index n, const Number* x,      bool new_x,      Number
 
     /// first call, must determine structure iRow/jCol
 
-    CoinCopyN (HLa_ -> iRow (), nele_hess, iRow);
-    CoinCopyN (HLa_ -> jCol (), nele_hess, jCol);
+    CoinCopyN (HLa () -> iRow (), nele_hess, iRow);
+    CoinCopyN (HLa () -> jCol (), nele_hess, jCol);
 
   } else {
 
@@ -535,17 +556,19 @@ bool CouenneTNLP::eval_h (Index n, const Number* x,      bool new_x,      Number
 
     CoinZeroN (values, nele_hess);
 
+    ExprHess *hess = HLa ();
+
     for (int i=0; i<nele_hess; i++, values++) {
 
       int 
-	 numL  = HLa_ -> numL () [i],
-	*lamI  = HLa_ -> lamI () [i];
+	 numL  = hess -> numL () [i],
+	*lamI  = hess -> lamI () [i];
 
       expression
-	**expr = HLa_ -> expr () [i];
+	**expr = hess -> expr () [i];
 
 #ifdef DEBUG
-      printf ("[%d %d] %d lambdas: ", HLa_ -> iRow () [i], HLa_ -> jCol () [i], numL); fflush (stdout);
+      printf ("[%d %d] %d lambdas: ", hess -> iRow () [i], hess -> jCol () [i], numL); fflush (stdout);
       for (int k=0; k<numL; k++) {
 	printf ("%d ", lamI [k]);
 	fflush (stdout);
@@ -577,12 +600,13 @@ bool CouenneTNLP::eval_h (Index n, const Number* x,      bool new_x,      Number
 // accordingly
 void CouenneTNLP::setObjective (expression *newObj) {
 
+  // change the Hessian accordingly. It is recomputed when Ipopt
+  // needs it
+
   if (HLa_)
     delete HLa_;
 
-  // change the Hessian accordingly
-
-  HLa_ = new ExprHess (problem_);
+  HLa_ = NULL;
 
   std::set <int> objDep;
 
@@ -640,7 +664,7 @@ void CouenneTNLP::finalize_solution (SolverReturn status,
 
     problem_ -> domain () -> push (n, x, problem_ -> domain () -> current () -> lb (),
    				         problem_ -> domain () -> current () -> ub ());
-    int nnz = HLa_ -> nnz ();
+    int nnz = HLa () -> nnz ();
 
     // resize them to full size (and realloc them to optHessianNum_ later)
 
@@ -210,9 +210,12 @@ namespace Couenne {
     ExprJac Jac_;
 
     /// Hessian --- there are 1+m of them, but all are squeezed in a
-    /// single object
+    /// single object. NULL until needed
     ExprHess *HLa_;
 
+    /// Return Hessian, computing it if needed
+    ExprHess *HLa ();
+
     /// Stores the values of the Hessian of the Lagrangian at optimum for later use
     CouenneSparseMatrix *optHessian_;
 
@@ -30,6 +30,8 @@
 #include "CouenneCutGenerator.hpp"
 
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneNlpMemo.hpp"
+#include "CouenneProfile.hpp"
 
 using namespace Couenne;
 
@@ -417,6 +419,12 @@ Linearization cuts added in total:       %8d  (separation time: %gs)\n",
 
     else jnlst -> Printf (J_ERROR, J_COUENNE, "Problem infeasible\n");
 
+    if (cp && cp -> nlpMemo () && cp -> nlpMemo () -> nLookups ())
+      jnlst -> Printf (J_ITERSUMMARY, J_COUENNE, "\
+NLPs with fixed integers avoided:        %8d  (of %d lookups)\n",
+		       cp -> nlpMemo () -> nHits (),
+		       cp -> nlpMemo () -> nLookups ());
+
     jnlst -> Printf (J_NONE, J_COUENNE, "\
 Total time:                              %8gs (%gs in branch-and-bound)\n\
 Lower bound:                           %s\n\
@@ -438,6 +446,42 @@ Branch-and-bound nodes:                  %8d\n",
     delete [] ubstr;
     delete [] gapstr;
 
+    std::string profile, profFile;
+
+    // the profile may also be collected for the status (see
+    // CouenneStatus), print it only if requested
+
+    couenne.options () -> GetStringValue ("profile", profile, "couenne.");
+
+    if (profile == "yes") {
+
+      CouenneProfile::print (jnlst);
+
+      couenne.options () -> GetStringValue ("profile_file", profFile, "couenne.");
+
+      if (profFile.length () > 0) {
+
+	CouenneProfile::addSummary ("time",        CoinCpuTime () - time_start);
+	CouenneProfile::addSummary ("bb_time",     cg ? (CoinCpuTime () - CoinMax (time_start, cg -> rootTime ())) : CoinCpuTime () - time_start);
+	CouenneProfile::addSummary ("infeasible",  infeasible ? 1. : 0.);
+	CouenneProfile::addSummary ("lower_bound", infeasible ? COIN_DBL_MAX : lb);
+	CouenneProfile::addSummary ("upper_bound", (infeasible || (retcomp < 0)) ? COIN_DBL_MAX : ub);
+	CouenneProfile::addSummary ("root_bound",  infeasible ? COIN_DBL_MAX : bb.model (). rootObjectiveAfterCuts ());
+	CouenneProfile::addSummary ("nodes",       infeasible ? 0 : bb.numNodes ());
+	CouenneProfile::addSummary ("root_cuts",   nr);
+	CouenneProfile::addSummary ("total_cuts",  nt);
+
+#if !defined(_MSC_VER) && !defined(__MSVCRT__)
+	struct rusage usage;
+	if (!getrusage (RUSAGE_SELF, &usage))
+	  CouenneProfile::addSummary ("peak_rss_kb", (double) usage.ru_maxrss);
+#endif
+
+	if (!(CouenneProfile::writeJSON (profFile)))
+	  jnlst -> Printf (J_ERROR, J_COUENNE, "Could not write profile on %s\n", profFile.c_str ());
+      }
+    }
+
     if (global_opt < COUENNE_INFINITY) { // some value found in couenne.opt
 
       double opt = infeasible ? -COIN_DBL_MAX : bb.model (). getBestPossibleObjValue ();
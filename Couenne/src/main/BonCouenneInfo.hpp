@@ -16,6 +16,8 @@
 #include "IpSmartPtr.hpp"
 #include <list>
 
+#include "CouenneStatus.hpp"
+
 namespace Couenne {
 
   /** Bonmin class for passing info between components of branch-and-cuts.*/
@@ -86,6 +88,7 @@ namespace Couenne {
     void addSolution(Ipopt::SmartPtr<const NlpSolution> newSol)
     {
       nlpSols_.push_back(newSol);
+      CouenneStatus::nlpSolution ();
     }
 
     protected:
@@ -48,6 +48,7 @@
 #include "BonCouenneInterface.hpp"
 #include "BonInitHeuristic.hpp"
 #include "BonNlpHeuristic.hpp"
+#include "CouenneHeuristicPortfolio.hpp"
 
 #include "BonFixAndSolveHeuristic.hpp"
 #include "BonDummyPump.hpp"
@@ -76,7 +77,13 @@
 #include "CouenneDisjCuts.hpp"
 #include "CouenneCrossConv.hpp"
 #include "CouenneSdpCuts.hpp"
+#include "CouenneEllipCuts.hpp"
 #include "CouenneTwoImplied.hpp"
+#include "CouenneSepaCoordinator.hpp"
+#include "CouenneTrace.hpp"
+#include "CouenneProfile.hpp"
+#include "CouenneStatus.hpp"
+#include "CouenneBab.hpp"
 
 // only for amaya_andrea_ options
 #include "CouenneExprPow.hpp"
@@ -189,6 +196,36 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
   addJournalist ("disjcuts_print_level",        J_DISJCUTS);
   addJournalist ("reformulate_print_level",     J_REFORMULATE);
 
+  // fix the levels read by the COUENNE_TRACE guards, and open the
+  // events trace if required
+
+  CouenneTrace::setup (journalist ());
+
+  options () -> GetStringValue ("trace_events_file", s, "couenne.");
+
+  if (s.length () > 0) {
+    options () -> GetIntegerValue ("trace_events_size", i, "couenne.");
+    CouenneTrace::openEvents (s, i);
+  }
+
+  options () -> GetStringValue ("status_file", s, "couenne.");
+
+  if (s.length () > 0) {
+    double interval;
+    options () -> GetNumericValue ("status_interval", interval, "couenne.");
+    CouenneStatus::open (s, interval);
+  }
+
+  // the status reports the time share of each component, hence
+  // needs the profile even if it is not printed
+
+  options () -> GetStringValue ("profile", s, "couenne.");
+  CouenneProfile::enable ((s == "yes") || CouenneStatus::enabled ());
+
+  options () -> GetIntegerValue ("random_seed", i, "couenne.");
+  if (i >= 0)
+    CoinSeedRandom (i);
+
   /* Initialize Couenne cut generator.*/
   //int ivalue, num_points;
   //options()->GetEnumValue("convexification_type", ivalue,"couenne.");
@@ -441,10 +478,12 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
   // }
 
 #ifdef COIN_HAS_NTY
-  if (couenneProb_ -> orbitalBranching ()) {
+  if (couenneProb_ -> orbitalBranching () ||
+      couenneProb_ -> orbitalFixing ()) {
 
     couenneProb_ -> ChangeBounds (couenneProb_ -> Lb (), couenneProb_ -> Ub (), couenneProb_ -> nVars ());
     couenneProb_ -> Compute_Symmetry ();
+    couenneProb_ -> setupSymGenerators ();
   }
 #endif
 
@@ -461,17 +500,39 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
 
   delete [] objects;
 
+  // Setup separation coordinator, which runs some separators
+  // concurrently, each on a copy of the problem ////////////////////////////////
+
+  int sepaThreads;
+  options () -> GetIntegerValue ("sepa_threads", sepaThreads, "couenne.");
+
+  CouenneSepaCoordinator *sepa = (sepaThreads > 1) ?
+    new CouenneSepaCoordinator (couenneProb_, journalist (), options ()) : NULL;
+
+  // the coordinator takes the place of the fixed point FBBT, which
+  // runs before the convexification so as to feed it tighter bounds
+
+  int sepaPosition = (int) cutGenerators (). size ();
+
   // Setup Fix Point bound tightener /////////////////////////////////////////////
 
   options () -> GetIntegerValue ("fixpoint_bt", freq, "couenne.");
 
   if (freq != 0) {
 
-    CuttingMethod cg;
-    cg.frequency = freq;
-    cg.cgl = new CouenneFixPoint (couenneProb_, options ());
-    cg.id = "Couenne fixed point FBBT";
-    cutGenerators (). push_back (cg);
+    if (sepa) {
+
+      CouenneProblem *copy = couenneProb_ -> clone ();
+      sepa -> addMember (new CouenneFixPoint (copy, options ()), freq, "Couenne fixed point FBBT", copy);
+
+    } else {
+
+      CuttingMethod cg;
+      cg.frequency = freq;
+      cg.cgl = new CouenneFixPoint (couenneProb_, options ());
+      cg.id = "Couenne fixed point FBBT";
+      cutGenerators (). push_back (cg);
+    }
   }
 
   // Setup Convexifier generators ////////////////////////////////////////////////
@@ -506,15 +567,22 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
 
   if (freq != 0) {
 
+    CouenneProblem *copy = sepa ? couenneProb_ -> clone () : couenneProb_;
+
     CouenneTwoImplied * couenne2I = 
-      new CouenneTwoImplied (couenneProb_,
+      new CouenneTwoImplied (copy,
 			     journalist (),
 			     options    ());
-    CuttingMethod cg;
-    cg.frequency = freq;
-    cg.cgl = couenne2I;
-    cg.id = "Couenne two-implied cuts";
-    cutGenerators (). push_back(cg);
+
+    if (sepa)
+      sepa -> addMember (couenne2I, freq, "Couenne two-implied cuts", copy);
+    else {
+      CuttingMethod cg;
+      cg.frequency = freq;
+      cg.cgl = couenne2I;
+      cg.id = "Couenne two-implied cuts";
+      cutGenerators (). push_back(cg);
+    }
   }
 
   // check branch variable selection for disjunctive cuts
@@ -557,6 +625,15 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
   //continuousSolver_ -> findIntegersAndSOS (false);
   //addSos (); // only adds embedded SOS objects
 
+  // if requested, Couenne's heuristics are run within a portfolio
+  // rather than separately
+
+  std::string portfolioMode;
+  options () -> GetStringValue ("heuristic_portfolio", portfolioMode, "couenne.");
+
+  CouenneHeuristicPortfolio *portfolio = (portfolioMode == "no") ? NULL :
+    new CouenneHeuristicPortfolio (couenneProb_, portfolioMode == "stop");
+
   if (doHeuristic == "yes") {
 
     int numSolve;
@@ -566,20 +643,31 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
     nlpHeuristic->setCouenneProblem(couenneProb_);
     nlpHeuristic->setMaxNlpInf(maxNlpInf_0);
     nlpHeuristic->setNumberSolvePerLevel(numSolve);
-    HeuristicMethod h;
-    h.id = "Couenne Rounding NLP";
-    h.heuristic = nlpHeuristic;
-    heuristics_.push_back(h);
+    std::string warmStart;
+    options () -> GetStringValue ("local_optimization_warm_start", warmStart, "couenne.");
+    nlpHeuristic->setWarmStart(warmStart == "yes");
+    if (portfolio)
+      portfolio -> addHeuristic (nlpHeuristic, "Couenne Rounding NLP");
+    else {
+      HeuristicMethod h;
+      h.id = "Couenne Rounding NLP";
+      h.heuristic = nlpHeuristic;
+      heuristics_.push_back(h);
+    }
   }
 
   options () -> GetStringValue ("iterative_rounding_heuristic", doHeuristic, "couenne.");
   
   if (doHeuristic == "yes") {
     CouenneIterativeRounding * nlpHeuristic = new CouenneIterativeRounding(nonlinearSolver_, ci, couenneProb_, options());
-    HeuristicMethod h;
-    h.id = "Couenne Iterative Rounding";
-    h.heuristic = nlpHeuristic;
-    heuristics_.push_back(h);
+    if (portfolio)
+      portfolio -> addHeuristic (nlpHeuristic, "Couenne Iterative Rounding");
+    else {
+      HeuristicMethod h;
+      h.id = "Couenne Iterative Rounding";
+      h.heuristic = nlpHeuristic;
+      heuristics_.push_back(h);
+    }
   }
 
   options () -> GetStringValue ("feas_pump_heuristic", doHeuristic, "couenne.");
@@ -593,11 +681,29 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
 
     nlpHeuristic -> setNumberSolvePerLevel (numSolve);
 
-    HeuristicMethod h;
+    if (portfolio)
+      portfolio -> addHeuristic (nlpHeuristic, "Couenne Feasibility Pump");
+    else {
+
+      HeuristicMethod h;
+
+      h.id = "Couenne Feasibility Pump";
+      h.heuristic = nlpHeuristic;
+      heuristics_. push_back (h);
+    }
+  }
+
+  if (portfolio) {
 
-    h.id = "Couenne Feasibility Pump";
-    h.heuristic = nlpHeuristic;
-    heuristics_. push_back (h);
+    if (portfolio -> nHeuristics ()) {
+
+      HeuristicMethod h;
+
+      h.id = "Couenne Heuristic Portfolio";
+      h.heuristic = portfolio;
+      heuristics_. push_back (h);
+
+    } else delete portfolio;
   }
 
 
@@ -770,15 +876,53 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
 
   if (freq != 0) {
 
+    CouenneProblem *copy = sepa ? couenneProb_ -> clone () : couenneProb_;
+
     CouenneSdpCuts * couenneSDP = 
-      new CouenneSdpCuts (couenneProb_,
+      new CouenneSdpCuts (copy,
 			  journalist (),
 			  options    ());
-    CuttingMethod cg;
-    cg.frequency = freq;
-    cg.cgl = couenneSDP;
-    cg.id = "Couenne SDP cuts";
-    cutGenerators (). push_back (cg);
+
+    if (sepa)
+      sepa -> addMember (couenneSDP, freq, "Couenne SDP cuts", copy);
+    else {
+      CuttingMethod cg;
+      cg.frequency = freq;
+      cg.cgl = couenneSDP;
+      cg.id = "Couenne SDP cuts";
+      cutGenerators (). push_back (cg);
+    }
+  }
+
+  // Add cuts for convex quadratic constraints ///////////////////////////////////////
+
+  options () -> GetIntegerValue ("ellip_cuts", freq, "couenne.");
+
+  if (freq != 0) {
+
+    CouenneProblem *copy = sepa ? couenneProb_ -> clone () : couenneProb_;
+
+    CouenneEllipCuts * couenneEllip =
+      new CouenneEllipCuts (copy,
+			    journalist (),
+			    options    ());
+
+    if (couenneEllip -> doNotUse ()) {
+
+      delete couenneEllip;
+
+      if (copy != couenneProb_)
+	delete copy;
+
+    } else if (sepa)
+      sepa -> addMember (couenneEllip, freq, "Couenne ellipsoidal cuts", copy);
+    else {
+      CuttingMethod cg;
+      cg.frequency = freq;
+      cg.cgl = couenneEllip;
+      cg.id = "Couenne ellipsoidal cuts";
+      cutGenerators (). push_back (cg);
+    }
   }
 
   // Add disjunctive cuts ///////////////////////////////////////////////////////
@@ -820,6 +964,24 @@ bool CouenneSetup::InitializeCouenne (char ** argv,
     cutGenerators (). push_back(cg);
   }
 
+  // Add separation coordinator, if it has anything to run ////////////////////////
+
+  if (sepa) {
+
+    if (sepa -> nMembers () > 0) {
+
+      CuttingMethod cg;
+      cg.frequency = 1; // frequencies of separators are checked by the coordinator
+      cg.cgl = sepa;
+      cg.id = "Couenne separation coordinator";
+
+      CuttingMethods::iterator pos = cutGenerators (). begin ();
+      std::advance (pos, sepaPosition);
+      cutGenerators (). insert (pos, cg);
+
+    } else delete sepa;
+  }
+
   return retval;
 }
  
@@ -885,10 +1047,17 @@ void CouenneSetup::registerAllOptions (Ipopt::SmartPtr <Bonmin::RegisteredOption
   CouenneDisjCuts         ::registerOptions (roptions);
   CouenneCrossConv        ::registerOptions (roptions);
   CouenneSdpCuts          ::registerOptions (roptions);
+  CouenneEllipCuts        ::registerOptions (roptions);
   CouenneTwoImplied       ::registerOptions (roptions);
+  CouenneSepaCoordinator  ::registerOptions (roptions);
   NlpSolveHeuristic       ::registerOptions (roptions);
   CouenneFeasPump         ::registerOptions (roptions);
   CouenneIterativeRounding::registerOptions (roptions);
+  CouenneHeuristicPortfolio::registerOptions (roptions);
+  CouenneTrace            ::registerOptions (roptions);
+  CouenneProfile          ::registerOptions (roptions);
+  CouenneStatus           ::registerOptions (roptions);
+  CouenneBab              ::registerOptions (roptions);
 
   /// TODO: move later!
   roptions -> AddStringOption2
@@ -917,6 +1086,12 @@ void CouenneSetup::registerAllOptions (Ipopt::SmartPtr <Bonmin::RegisteredOption
 				"yes", "",
 				"no", "");
 
+  roptions -> AddLowerBoundedIntegerOption ("random_seed",
+					    "Seed of the random number generator used by Couenne",
+					    -1, -1,
+					    "If -1 (default), the generator is not seeded. "
+					    "Set to a nonnegative value to reproduce runs, e.g., for benchmarking.");
+
   roptions -> AddStringOption5 ("lp_solver",
 				"Linear Programming solver for the linearization",
 				"clp",
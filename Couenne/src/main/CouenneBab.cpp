@@ -30,7 +30,11 @@
 
 #include "CouenneBab.hpp"
 #include "CouenneProblem.hpp"
+#include "CouenneProblemElem.hpp"
+#include "CouenneCutGenerator.hpp"
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneTrace.hpp"
+#include "CouenneStatus.hpp"
 
 // sets cutoff a bit above real one, to avoid single-point feasible sets
 #define CUTOFF_TOL 1e-6
@@ -71,7 +75,13 @@ using namespace Couenne;
 using namespace Bonmin;
 
 /** Constructor.*/
-CouenneBab::CouenneBab (): Bab (), problem_(NULL) {}
+CouenneBab::CouenneBab (): 
+  Bab                (), 
+  problem_           (NULL),
+  restartNodes_      (0),
+  restartIterations_ (0),
+  warmStart_         (NULL),
+  recordWarmStart_   (false) {}
 
 /** Destructor.*/
 CouenneBab::~CouenneBab () {}
@@ -80,6 +90,31 @@ void CouenneBab::setProblem (CouenneProblem *p)
 {problem_ = p;}
 
 
+/// the convexification cut generator of a model (NULL if none)
+static CouenneCutGenerator *couenneGenerator (CbcModel &model) {
+
+  for (int i=0; i < model.numberCutGenerators (); i++) {
+
+    CouenneCutGenerator *cg = dynamic_cast <CouenneCutGenerator *> (model.cutGenerator (i) -> generator ());
+
+    if (cg)
+      return cg;
+  }
+
+  return NULL;
+}
+
+
+/// the pseudocosts of the branching chooser of a model (NULL if none)
+static OsiPseudoCosts *pseudoCosts (CbcModel &model) {
+
+  BonChooseVariable *choose = model.branchingMethod () ? 
+    dynamic_cast <BonChooseVariable *> (model.branchingMethod () -> chooseMethod ()) : NULL;
+
+  return choose ? &(choose -> pseudoCosts ()) : NULL;
+}
+
+
 /** Perform a branch-and-bound on given setup.*/
 void CouenneBab::branchAndBound (Bonmin::BabSetupBase & s) {
 
@@ -535,8 +570,33 @@ void CouenneBab::branchAndBound (Bonmin::BabSetupBase & s) {
     //model_.branchAndBound(3);
     remaining_time -= CoinCpuTime();
     model_.setDblParam(CbcModel::CbcMaximumSeconds, remaining_time);
-    if(remaining_time > 0.)
+    CouenneStatus::setModel (&model_);
+
+    int nRestartNodes, nCuts;
+    s.options () -> GetIntegerValue ("restart_nodes", nRestartNodes, "couenne.");
+    s.options () -> GetIntegerValue ("restart_cuts",  nCuts,         "couenne.");
+
+    bool search = (remaining_time > 0.);
+
+    if (search && recordWarmStart_) {
+
+      CouenneCutGenerator *cg = couenneGenerator (model_);
+
+      if (cg)
+	cg -> setRecordRoot (true);
+    }
+
+    if (search && warmStart_)
+      applyWarmStart (*warmStart_);
+
+    if (search && problem_ && (nRestartNodes > 0))
+      search = restart (bonBabInfoPtr, nRestartNodes, nCuts, remaining_time);
+
+    if (search)
       model_.branchAndBound();
+
+    if (recordWarmStart_)
+      collectWarmStart (model_, learned_, nCuts);
   }
 
   catch(TNLPSolver::UnsolvedError *E){
@@ -545,10 +605,10 @@ void CouenneBab::branchAndBound (Bonmin::BabSetupBase & s) {
     throw E;
   }
 
-  numNodes_ = model_.getNodeCount();
+  numNodes_ = model_.getNodeCount() + restartNodes_;
   bestObj_ = model_.getObjValue();
   bestBound_ = model_.getBestPossibleObjValue();
-  mipIterationCount_ = model_.getIterationCount();
+  mipIterationCount_ = model_.getIterationCount() + restartIterations_;
 
   bool hasFailed = false;
   if (specOpt==16)//Did we continue branching on a failure
@@ -676,6 +736,9 @@ void CouenneBab::branchAndBound (Bonmin::BabSetupBase & s) {
      s.nonlinearSolver () -> getNumCols (),
      use_RBS_Cbc ? bestSolution_ : problem_ -> getRecordBestSol () -> getSol (),
      use_RBS_Cbc ? bestObj_      : problem_ -> getRecordBestSol () -> getVal ());
+
+  CouenneTrace::dumpEvents ();
+  CouenneStatus::close ();
 }
 
 const double * CouenneBab::bestSolution() const {
@@ -697,3 +760,222 @@ double CouenneBab::bestObj() const {
     return bestObj_;
   return problem_ -> getRecordBestSol () -> getVal ();
 }
+
+
+/// Run a first search of at most nNodes nodes on a copy of model_.
+/// Bound tightening and cut generation at the root often find the
+/// best bounds late, when the tree built so far has been branching on
+/// the loose ones. Give model_ what the first search has learned (see
+/// WarmStart) and its incumbent, and restart from there.
+///
+/// Return true if model_ is to be searched, false if the first search
+/// has finished (optimality/infeasibility proven, time limit,
+/// interruption), in which case its result is moved to model_
+bool CouenneBab::restart (OsiBabSolver *babInfo,
+			  int nNodes,
+			  int nCuts,
+			  double &remaining_time) {
+
+  double now = CoinCpuTime ();
+
+  CbcModel probe (model_);
+
+  probe.passInSolverCharacteristics (babInfo);
+  probe.setMaximumNodes (CoinMin (nNodes, model_.getMaximumNodes ()));
+
+  // the copy of the convexification cut generator records the root
+  // node
+
+  CouenneCutGenerator *cg = couenneGenerator (probe);
+
+  if (cg)
+    cg -> setRecordRoot (true);
+
+#ifdef SIGNAL
+  currentBranchModel = &probe;
+#endif
+
+  CouenneStatus::setModel (&probe);
+
+  probe.branchAndBound ();
+
+  CouenneStatus::setModel (&model_);
+
+#ifdef SIGNAL
+  currentBranchModel = &model_;
+#endif
+
+  remaining_time -= CoinCpuTime () - now;
+
+  if (probe.bestSolution ())
+    model_.setBestSolution (probe.bestSolution (), model_.solver () -> getNumCols (), probe.getObjValue ());
+
+  if ((probe.status () != 1) ||
+      !(probe.isNodeLimitReached ()) ||
+      (remaining_time <= 0.)) {
+
+    model_.moveInfo (probe);
+    return false;
+  }
+
+  restartNodes_      = probe.getNodeCount ();
+  restartIterations_ = probe.getIterationCount ();
+
+  WarmStart ws;
+
+  collectWarmStart (probe, ws, nCuts);
+
+  int nTightened = applyWarmStart (ws);
+
+  // remaining limits
+
+  model_.setMaximumNodes (model_.getMaximumNodes () - restartNodes_);
+  model_.setDblParam (CbcModel::CbcMaximumSeconds, remaining_time);
+
+  problem_ -> Jnlst () -> Printf (Ipopt::J_ERROR, J_COUENNE, 
+				  "Couenne: restart after %d nodes, %d bounds tightened, %d cuts carried over\n",
+				  restartNodes_, nTightened, ws.cuts_.sizeRowCuts ());
+  return true;
+}
+
+
+/// Fill ws with what search has learned
+void CouenneBab::collectWarmStart (CbcModel &search, WarmStart &ws, int nCuts) const {
+
+  OsiSolverInterface *lp = search.solver ();
+
+  int nCols = lp -> getNumCols ();
+
+  ws.lower_.assign (nCols, -COIN_DBL_MAX);
+  ws.upper_.assign (nCols,  COIN_DBL_MAX);
+
+  // bounds at the root node
+
+  CouenneCutGenerator *cg = couenneGenerator (search);
+
+  if (cg && ((int) cg -> rootLb (). size () == nCols))
+
+    for (int i=0; i<nCols; i++) {
+
+      CouNumber
+	l = cg -> rootLb () [i],
+	u = cg -> rootUb () [i];
+
+      if (lp -> isInteger (i)) {
+	l = ceil  (l - COUENNE_EPS_INT);
+	u = floor (u + COUENNE_EPS_INT);
+      }
+
+      ws.lower_ [i] = l;
+      ws.upper_ [i] = u;
+    }
+
+  // lower bound on the objective proved by the search
+
+  int objInd = problem_ ? problem_ -> Obj (0) -> Body () -> Index () : -1;
+
+  double objBound = search.getBestPossibleObjValue ();
+
+  if ((objInd >= 0) &&
+      (objInd < nCols) &&
+      (fabs (objBound) < COUENNE_INFINITY))
+    ws.lower_ [objInd] = CoinMax (ws.lower_ [objInd], objBound - COUENNE_EPS * (1. + fabs (objBound)));
+
+  // best cuts of the root node, generated with globally valid bounds
+
+  ws.cuts_ = OsiCuts ();
+
+  if (cg && nCuts)
+    cg -> bestRootCuts (nCuts, ws.cuts_);
+
+  // pseudocosts
+
+  OsiPseudoCosts *pc = pseudoCosts (search);
+
+  if ((ws.hasPseudoCosts_ = (pc != NULL)))
+    ws.pseudoCosts_ = *pc;
+}
+
+
+/// Tighten bounds of model_, add cuts to it, and set its pseudocosts
+/// from ws. Return the number of tightened bounds
+int CouenneBab::applyWarmStart (const WarmStart &ws) {
+
+  OsiSolverInterface *lp = model_.solver ();
+
+  int
+    nCols      = lp -> getNumCols (),
+    nTightened = 0;
+
+  if ((int) ws.lower_.size () == nCols) {
+
+    std::vector <double>
+      lower (lp -> getColLower (), lp -> getColLower () + nCols),
+      upper (lp -> getColUpper (), lp -> getColUpper () + nCols);
+
+    for (int i=0; i<nCols; i++) {
+
+      double
+	l = CoinMax (lower [i], ws.lower_ [i]),
+	u = CoinMin (upper [i], ws.upper_ [i]);
+
+      if (l > u) // should not happen, keep the safe bounds
+	continue;
+
+      if (l > lower [i] + COUENNE_EPS) {lower [i] = l; ++nTightened;}
+      if (u < upper [i] - COUENNE_EPS) {upper [i] = u; ++nTightened;}
+    }
+
+    lp -> setColLower (&(lower [0]));
+    lp -> setColUpper (&(upper [0]));
+
+    // the problem's bounds too, for the components that read them from there
+
+    if (problem_)
+      for (int i = CoinMin (nCols, problem_ -> nVars ()); i--;) {
+	problem_ -> Lb (i) = lower [i];
+	problem_ -> Ub (i) = upper [i];
+      }
+  }
+
+  if (ws.cuts_.sizeRowCuts ()) {
+
+    std::vector <const OsiRowCut *> rowCuts (ws.cuts_.sizeRowCuts ());
+
+    for (int i = 0; i < ws.cuts_.sizeRowCuts (); i++)
+      rowCuts [i] = ws.cuts_.rowCutPtr (i);
+
+    lp -> applyRowCuts ((int) rowCuts.size (), &(rowCuts [0]));
+  }
+
+  OsiPseudoCosts *pc = pseudoCosts (model_);
+
+  if (pc && ws.hasPseudoCosts_ && 
+      (pc -> numberObjects () == ws.pseudoCosts_.numberObjects ()))
+    *pc = ws.pseudoCosts_;
+
+  return nTightened;
+}
+
+
+/// Add list of options to be read from file
+void CouenneBab::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("restart_nodes",
+     "Number of nodes after which the branch-and-bound is restarted",
+     0, 0,
+     "If positive, a first branch-and-bound is stopped after this many nodes and the search restarts from scratch, "
+     "with the bounds obtained at the root node of the first search (by FBBT, OBBT, ABT, and the cut loop), "
+     "the lower bound it has proved on the objective, its best root cuts, its pseudocosts, and its best solution. "
+     "No restart takes place if the first search finishes before this limit. "
+     "If zero (default), no restart.");
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("restart_cuts",
+     "Number of cuts of the root node carried over at a restart",
+     0, 200,
+     "The cuts generated by the convexification at the root node of the first search "
+     "with largest efficacy (violation divided by norm) are added to the problem of the restart. "
+     "Only used if restart_nodes is positive.");
+}
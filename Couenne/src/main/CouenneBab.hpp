@@ -11,8 +11,13 @@
 #ifndef COUENNEBAB_H
 #define COUENNEBAB_H
 
+#include <vector>
+
 #include "BonCbc.hpp"
 #include "BonBabSetupBase.hpp"
+#include "BonRegisteredOptions.hpp"
+#include "OsiChooseVariable.hpp"
+#include "OsiCuts.hpp"
 
 namespace Couenne {
 
@@ -41,10 +46,68 @@ namespace Couenne {
     /** return the best known lower bound on the objective value*/
     double bestBound() { return CoinMin(Bonmin::Bab::bestBound(), bestObj()); }
 
+    /// Add list of options to be read from file
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+    /// What a search has learned that another search on the same
+    /// problem, or on a part of it, can start from: globally valid
+    /// bounds (root bounds and lower bound on the objective), the
+    /// best cuts of the root node, and the pseudocosts
+    struct WarmStart {
+
+      std::vector <double> lower_;          ///< lower bounds (empty if unknown)
+      std::vector <double> upper_;          ///< upper bounds (empty if unknown)
+      OsiCuts              cuts_;           ///< root cuts, valid for the whole problem
+      OsiPseudoCosts       pseudoCosts_;    ///< pseudocosts of the branching chooser
+      bool                 hasPseudoCosts_; ///< true if pseudoCosts_ is set
+
+      WarmStart (): hasPseudoCosts_ (false) {}
+    };
+
+    /// Start the next search from ws (not owned, NULL for none)
+    void setWarmStart (const WarmStart *ws)
+    {warmStart_ = ws;}
+
+    /// Record what the next search learns, in learned ()
+    void setRecordWarmStart (bool value)
+    {recordWarmStart_ = value;}
+
+    /// What the last search has learned, if recorded
+    const WarmStart &learned () const
+    {return learned_;}
+
   protected:
 
+    /// Fill ws with what search has learned. Root bounds and cuts are
+    /// only there if the convexification recorded the root node
+    void collectWarmStart (CbcModel &search, WarmStart &ws, int nCuts) const;
+
+    /// Tighten bounds of model_, add cuts to it, and set its
+    /// pseudocosts from ws. Return the number of tightened bounds
+    int applyWarmStart (const WarmStart &ws);
+
+    /// Run a first search of at most nNodes nodes on a copy of the
+    /// model, then carry its root bounds, best root cuts,
+    /// pseudocosts, and incumbent over to model_. Return true if
+    /// model_ is to be searched (restart), false if the first search
+    /// has finished (its result is then in model_)
+    bool restart (OsiBabSolver *babInfo, int nNodes, int nCuts, double &remaining_time);
+
     CouenneProblem *problem_;
 
+    /// nodes and LP iterations of the search before the restart
+    int restartNodes_;
+    int restartIterations_;
+
+    /// start point of the search (not owned)
+    const WarmStart *warmStart_;
+
+    /// should the search record what it learns?
+    bool recordWarmStart_;
+
+    /// what the last search has learned
+    WarmStart learned_;
+
   };
 }
 
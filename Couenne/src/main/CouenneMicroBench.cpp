@@ -0,0 +1,504 @@
+/* $Id$
+ *
+ * Name:    CouenneMicroBench.cpp
+ * Author:  Pietro Belotti
+ * Purpose: measure the throughput of the main kernels of Couenne in isolation
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <vector>
+#include <string>
+
+#include "CoinTime.hpp"
+#include "CoinError.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "OsiCuts.hpp"
+
+#include "BonCouenneSetup.hpp"
+
+#include "CouenneTypes.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneProblemElem.hpp"
+#include "CouenneCutGenerator.hpp"
+#include "CouenneTNLP.hpp"
+
+#include "CouenneExprAux.hpp"
+#include "CouenneExprVar.hpp"
+#include "CouenneExprConst.hpp"
+#include "CouenneExprClone.hpp"
+#include "CouenneExprSum.hpp"
+#include "CouenneExprMul.hpp"
+#include "CouenneExprPow.hpp"
+#include "CouenneExprExp.hpp"
+
+using namespace Ipopt;
+using namespace Couenne;
+
+/// Microbenchmarks of the kernels that are called most often in a
+/// run of Couenne:
+///
+/// - evaluation of all auxiliary variables (expression::operator ()
+///   over the DAG, in evaluation order)
+/// - FBBT (CouenneProblem::btCore) from the initial bounds
+/// - convexification cuts (exprAux::generateCuts), per operator
+/// - implied bounds of sums and quadratic forms (impliedBound), per operator
+/// - Hessian of the Lagrangian (CouenneTNLP::eval_h)
+///
+/// The problem is read from a .nl file (if Couenne is compiled with
+/// ASL) or synthesized with a given number of variables, constraints,
+/// and terms per constraint. Options in couenne.opt, if present, are
+/// used as in couenne. Each kernel is repeated until it has run for
+/// at least the given CPU time; only the kernel itself is timed, not
+/// the restoring of the initial point and bounds between repetitions.
+///
+/// usage: microbench [-n vars] [-m cons] [-k terms] [-t sec] [-s seed] [file.nl]
+
+/// result of one kernel
+struct Throughput {
+
+  std::string name_;   ///< kernel
+  const char *unit_;   ///< what is counted in items_
+  double      time_;   ///< CPU time spent in the kernel
+  long int    calls_;  ///< number of calls
+  long int    items_;  ///< number of evaluations, cuts, or bound updates
+};
+
+
+/// name of an operator as printed in the table
+static const char *opName (enum expr_type code) {
+
+  switch (code) {
+
+  case COU_EXPRSUM:       return "exprSum";
+  case COU_EXPRSUB:       return "exprSub";
+  case COU_EXPRGROUP:     return "exprGroup";
+  case COU_EXPRQUAD:      return "exprQuad";
+  case COU_EXPRMUL:       return "exprMul";
+  case COU_EXPRTRILINEAR: return "exprTrilinear";
+  case COU_EXPRMULTILIN:  return "exprMultiLin";
+  case COU_EXPRPOW:       return "exprPow";
+  case COU_EXPRSIGNPOW:   return "exprSignPow";
+  case COU_EXPRDIV:       return "exprDiv";
+  case COU_EXPRMIN:       return "exprMin";
+  case COU_EXPRMAX:       return "exprMax";
+  case COU_EXPRNORM:      return "exprNorm";
+  case COU_EXPRPWLINEAR:  return "exprPWLinear";
+  case COU_EXPRCOS:       return "exprCos";
+  case COU_EXPRSIN:       return "exprSin";
+  case COU_EXPRABS:       return "exprAbs";
+  case COU_EXPREXP:       return "exprExp";
+  case COU_EXPRLOG:       return "exprLog";
+  case COU_EXPRINV:       return "exprInv";
+  case COU_EXPROPP:       return "exprOpp";
+  case COU_EXPRFLOOR:     return "exprFloor";
+  case COU_EXPRCEIL:      return "exprCeil";
+  default:                return "other";
+  }
+}
+
+
+/// Synthesize a problem with n variables in random boxes around the
+/// origin and m constraints, each a sum of k terms chosen at random
+/// among c x_i x_j, c x_i^2, c x_i^3, and c exp (x_i)
+static CouenneProblem *synthesize (CouenneSetup &couenne, int n, int m, int k) {
+
+  CouenneProblem *p = new CouenneProblem (NULL, &couenne, couenne.journalist ());
+
+  CouNumber
+    *x  = new CouNumber [n],
+    *lb = new CouNumber [n],
+    *ub = new CouNumber [n];
+
+  for (int i=0; i<n; i++) {
+
+    lb [i] = -1. - 4. * CoinDrand48 ();
+    ub [i] =  1. + 4. * CoinDrand48 ();
+    x  [i] = lb [i] + (ub [i] - lb [i]) * CoinDrand48 ();
+  }
+
+  p -> domain () -> push (n, x, lb, ub);
+
+  delete [] x;
+  delete [] lb;
+  delete [] ub;
+
+  for (int i=0; i<n; i++)
+    p -> addVariable (false, p -> domain ());
+
+  // objective: sum of all variables
+
+  expression **al = new expression * [n];
+
+  for (int i=0; i<n; i++)
+    al [i] = new exprClone (p -> Var (i));
+
+  p -> addObjective (new exprSum (al, n), "min");
+
+  // constraints
+
+  for (int i=0; i<m; i++) {
+
+    expression **terms = new expression * [k];
+
+    for (int j=0; j<k; j++) {
+
+      expression
+	*c  = new exprConst (2. * CoinDrand48 () - 1.),
+	*xa = new exprClone (p -> Var ((int) (n * CoinDrand48 ()) % n));
+
+      switch ((int) (4 * CoinDrand48 ())) {
+
+      case 0:  terms [j] = new exprMul (xa, new exprClone (p -> Var ((int) (n * CoinDrand48 ()) % n))); break;
+      case 1:  terms [j] = new exprPow (xa, new exprConst (2.)); break;
+      case 2:  terms [j] = new exprPow (xa, new exprConst (3.)); break;
+      default: terms [j] = new exprExp (xa);
+      }
+
+      terms [j] = new exprMul (c, terms [j]);
+    }
+
+    p -> addLEConstraint (new exprSum (terms, k), new exprConst (1. + k * CoinDrand48 ()));
+  }
+
+  return p;
+}
+
+
+/// print one line of the table
+static void printThroughput (const Throughput &t) {
+
+  printf ("%-32s %10ld %9.3fs %12.0f %14.0f %s/s\n",
+	  t.name_.c_str (), t.calls_, t.time_,
+	  t.time_ > 0. ? t.calls_ / t.time_ : 0.,
+	  t.time_ > 0. ? t.items_ / t.time_ : 0.,
+	  t.unit_);
+}
+
+
+/// number of bounds in [lb,ub] that differ from [lb0,ub0]
+static int changedBounds (int n,
+			  const CouNumber *lb,  const CouNumber *ub,
+			  const CouNumber *lb0, const CouNumber *ub0) {
+  int nChg = 0;
+
+  for (int i=0; i<n; i++) {
+    if (lb [i] != lb0 [i]) ++nChg;
+    if (ub [i] != ub0 [i]) ++nChg;
+  }
+
+  return nChg;
+}
+
+
+int main (int argc, char *argv []) {
+
+  WindowsErrorPopupBlocker ();
+
+  int
+    nVars   = 1000,
+    nCons   = 500,
+    nTerms  = 4,
+    seed    = 1;
+
+  double minTime = 0.5;
+
+  char *nlfile = NULL;
+
+  for (int i=1; i<argc; i++) {
+
+    if ((argv [i] [0] == '-') && (i < argc - 1)) {
+
+      switch (argv [i] [1]) {
+
+      case 'n': nVars   = atoi (argv [++i]); continue;
+      case 'm': nCons   = atoi (argv [++i]); continue;
+      case 'k': nTerms  = atoi (argv [++i]); continue;
+      case 's': seed    = atoi (argv [++i]); continue;
+      case 't': minTime = atof (argv [++i]); continue;
+      }
+    }
+
+    if (argv [i] [0] == '-') {
+      printf ("usage: %s [-n vars] [-m cons] [-k terms] [-t sec] [-s seed] [file.nl]\n", argv [0]);
+      return 1;
+    }
+
+    nlfile = argv [i];
+  }
+
+  if ((nVars < 1) || (nCons < 0) || (nTerms < 1)) {
+    printf ("microbench: need at least one variable and one term per constraint\n");
+    return 1;
+  }
+
+  CoinSeedRandom (seed);
+
+  CouenneSetup couenne;
+
+  CouenneProblem      *p  = NULL;
+  CouenneCutGenerator *cg = NULL;
+
+  if (nlfile) {
+
+#ifdef COIN_HAS_ASL
+    char *nlargv [] = {argv [0], nlfile, NULL};
+
+    if (!(couenne.InitializeCouenne (nlargv))) {
+      printf ("microbench: problem %s is infeasible\n", nlfile);
+      return 1;
+    }
+
+    cg = couenne.couennePtr ();
+    p  = cg -> Problem ();
+#else
+    printf ("microbench: Couenne was compiled without ASL, cannot read %s\n", nlfile);
+    return 1;
+#endif
+
+  } else {
+
+    couenne.readOptionsFile ();
+
+    // set output levels as in CouenneSetup::InitializeCouenne
+
+    const char *levelOpt [] = {"output_level", "boundtightening_print_level", "branching_print_level",
+			       "convexifying_print_level", "problem_print_level", "nlpheur_print_level",
+			       "disjcuts_print_level", "reformulate_print_level"};
+
+    const EJournalCategory levelCat [] = {J_COUENNE, J_BOUNDTIGHTENING, J_BRANCHING,
+					  J_CONVEXIFYING, J_PROBLEM, J_NLPHEURISTIC,
+					  J_DISJCUTS, J_REFORMULATE};
+
+    for (int i=0; i < (int) (sizeof (levelCat) / sizeof (EJournalCategory)); i++) {
+
+      int level;
+      couenne.options () -> GetIntegerValue (levelOpt [i], level, "couenne.");
+      couenne.journalist () -> GetJournal ("console") -> SetPrintLevel (levelCat [i], (EJournalLevel) level);
+    }
+
+    // reformulate sums of quadratic terms as exprQuad, unless
+    // specified otherwise in couenne.opt
+
+    std::string s;
+
+    if (!(couenne.options () -> GetStringValue ("use_quadratic", s, "couenne.")))
+      couenne.options () -> SetStringValue ("couenne.use_quadratic", "yes");
+
+    p  = synthesize (couenne, nVars, nCons, nTerms);
+    cg = new CouenneCutGenerator (NULL, &couenne, p, NULL);
+
+    p -> reformulate (cg);
+  }
+
+  int n = p -> nVars ();
+
+  printf ("Problem: %d variables (%d original), %d constraints\n\n",
+	  n, p -> nOrigVars (), p -> nCons ());
+
+  // save initial point and bounds, restored before each repetition
+
+  CouNumber
+    *x0  = CoinCopyOfArray (p -> X  (), n),
+    *lb0 = CoinCopyOfArray (p -> Lb (), n),
+    *ub0 = CoinCopyOfArray (p -> Ub (), n);
+
+  // auxiliary variables, grouped by operator
+
+  std::vector <exprVar *> auxs;
+  std::map <int, std::vector <exprVar *> > auxByOp;
+
+  for (int i=0; i<n; i++) {
+
+    exprVar *v = p -> Var (p -> evalOrder (i));
+
+    if ((v -> Type () == AUX) && (v -> Multiplicity () > 0)) {
+      auxs.push_back (v);
+      auxByOp [v -> Image () -> code ()].push_back (v);
+    }
+  }
+
+  std::vector <Throughput> results;
+
+  // 1) evaluation of the auxiliary variables //////////////////////////
+
+  {
+    Throughput t = {"eval auxiliaries", "evaluations", 0., 0, 0};
+
+    while (t.time_ < minTime) {
+
+      double start = CoinCpuTime ();
+
+      for (std::vector <exprVar *>::iterator i = auxs.begin (); i != auxs.end (); ++i)
+	p -> X ((*i) -> Index ()) = (*((*i) -> Image ())) ();
+
+      t.time_  += CoinCpuTime () - start;
+      t.calls_ ++;
+      t.items_ += auxs.size ();
+    }
+
+    CoinCopyN (x0, n, p -> X ());
+    results.push_back (t);
+  }
+
+  // 2) FBBT from the initial bounds ///////////////////////////////////
+
+  {
+    Throughput t = {"btCore", "bound updates", 0., 0, 0};
+
+    t_chg_bounds *chg = new t_chg_bounds [n];
+
+    while (t.time_ < minTime) {
+
+      for (int i=0; i<n; i++) {
+
+	chg [i].setLower (t_chg_bounds::CHANGED);
+	chg [i].setUpper (t_chg_bounds::CHANGED);
+      }
+
+      double start = CoinCpuTime ();
+
+      p -> btCore (chg);
+
+      t.time_  += CoinCpuTime () - start;
+      t.calls_ ++;
+      t.items_ += changedBounds (n, p -> Lb (), p -> Ub (), lb0, ub0);
+
+      CoinCopyN (lb0, n, p -> Lb ());
+      CoinCopyN (ub0, n, p -> Ub ());
+    }
+
+    delete [] chg;
+    results.push_back (t);
+  }
+
+  // 3) convexification cuts, per operator /////////////////////////////
+
+  for (std::map <int, std::vector <exprVar *> >::iterator i = auxByOp.begin (); i != auxByOp.end (); ++i) {
+
+    if (i -> second.front () -> Image () -> Linearity () <= LINEAR)
+      continue;
+
+    Throughput t = {std::string ("generateCuts ") + opName ((enum expr_type) i -> first), "cuts", 0., 0, 0};
+
+    while (t.time_ < minTime) {
+
+      OsiCuts cs;
+
+      double start = CoinCpuTime ();
+
+      for (std::vector <exprVar *>::iterator j = i -> second.begin (); j != i -> second.end (); ++j)
+	(*j) -> generateCuts (cs, cg);
+
+      t.time_  += CoinCpuTime () - start;
+      t.calls_ += i -> second.size ();
+      t.items_ += cs.sizeRowCuts () + cs.sizeColCuts ();
+    }
+
+    results.push_back (t);
+  }
+
+  // 4) implied bounds of sums and quadratic forms /////////////////////
+
+  {
+    const enum expr_type sums [] = {COU_EXPRSUM, COU_EXPRGROUP, COU_EXPRQUAD};
+
+    t_chg_bounds *chg = new t_chg_bounds [n];
+
+    for (int k=0; k < (int) (sizeof (sums) / sizeof (enum expr_type)); k++) {
+
+      std::map <int, std::vector <exprVar *> >::iterator i = auxByOp.find (sums [k]);
+
+      if (i == auxByOp.end ())
+	continue;
+
+      Throughput t = {std::string ("impliedBound ") + opName (sums [k]), "bound updates", 0., 0, 0};
+
+      while (t.time_ < minTime) {
+
+	double start = CoinCpuTime ();
+
+	for (std::vector <exprVar *>::iterator j = i -> second.begin (); j != i -> second.end (); ++j)
+	  (*j) -> Image () -> impliedBound ((*j) -> Index (), p -> Lb (), p -> Ub (), chg, (*j) -> sign ());
+
+	t.time_  += CoinCpuTime () - start;
+	t.calls_ += i -> second.size ();
+	t.items_ += changedBounds (n, p -> Lb (), p -> Ub (), lb0, ub0);
+
+	CoinCopyN (lb0, n, p -> Lb ());
+	CoinCopyN (ub0, n, p -> Ub ());
+      }
+
+      results.push_back (t);
+    }
+
+    delete [] chg;
+  }
+
+  // 5) Hessian of the Lagrangian //////////////////////////////////////
+
+  {
+    CouenneTNLP tnlp (p);
+
+    Index nn, m, nnzj, nnzh;
+    TNLP::IndexStyleEnum style;
+
+    tnlp.get_nlp_info (nn, m, nnzj, nnzh, style);
+
+    Index  *iRow   = new Index  [nnzh + 1],
+           *jCol   = new Index  [nnzh + 1];
+    Number *values = new Number [nnzh + 1],
+           *lambda = new Number [m + 1];
+
+    for (int i=0; i<m; i++)
+      lambda [i] = 2. * CoinDrand48 () - 1.;
+
+    tnlp.eval_h (nn, x0, true, 1., m, lambda, true, nnzh, iRow, jCol, NULL);
+
+    char name [40];
+    sprintf (name, "eval_h (%d nonzeros)", nnzh);
+
+    Throughput t = {name, "evaluations", 0., 0, 0};
+
+    while (t.time_ < minTime) {
+
+      double start = CoinCpuTime ();
+
+      tnlp.eval_h (nn, x0, true, 1., m, lambda, true, nnzh, NULL, NULL, values);
+
+      t.time_  += CoinCpuTime () - start;
+      t.calls_ ++;
+      t.items_ ++;
+    }
+
+    delete [] iRow;
+    delete [] jCol;
+    delete [] values;
+    delete [] lambda;
+
+    CoinCopyN (x0, n, p -> X ());
+    results.push_back (t);
+  }
+
+  printf ("%-32s %10s %10s %12s %14s\n", "Kernel", "Calls", "CPU time", "Calls/s", "Throughput");
+
+  for (std::vector <Throughput>::iterator i = results.begin (); i != results.end (); ++i)
+    printThroughput (*i);
+
+  delete [] x0;
+  delete [] lb0;
+  delete [] ub0;
+
+  if (!nlfile) {
+    delete cg;
+    delete p;
+  }
+
+  return 0;
+}
@@ -0,0 +1,218 @@
+/* $Id$
+ *
+ * Name:    CouenneNlpMemo.cpp
+ * Author:  Pietro Belotti
+ * Purpose: memo table of NLPs solved with fixed integer variables
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "CoinHelperFunctions.hpp"
+
+#include "CouennePrecisions.hpp"
+#include "CouenneProblem.hpp"
+#include "CouenneExprVar.hpp"
+#include "CouenneNlpMemo.hpp"
+
+using namespace Couenne;
+
+/// Constructor
+CouenneNlpMemo::CouenneNlpMemo (CouenneProblem *p, int maxSize):
+  problem_  (p),
+  maxSize_  (maxSize),
+  nLookups_ (0),
+  nHits_    (0) {}
+
+
+/// Copy constructor
+CouenneNlpMemo::CouenneNlpMemo (const CouenneNlpMemo &rhs):
+  problem_  (rhs.problem_),
+  maxSize_  (rhs.maxSize_),
+  table_    (rhs.table_),
+  order_    (rhs.order_),
+  nLookups_ (rhs.nLookups_),
+  nHits_    (rhs.nHits_) {
+
+  int n = problem_ -> nOrigVars ();
+
+  for (std::map <unsigned long, Entry>::iterator i = table_.begin (); i != table_.end (); ++i)
+    if (i -> second.sol_)
+      i -> second.sol_ = CoinCopyOfArray (i -> second.sol_, n);
+}
+
+
+/// Destructor
+CouenneNlpMemo::~CouenneNlpMemo () {
+
+  for (std::map <unsigned long, Entry>::iterator i = table_.begin (); i != table_.end (); ++i)
+    if (i -> second.sol_)
+      delete [] i -> second.sol_;
+}
+
+
+/// fill vector with (rounded) integer components of x followed by
+/// the bounds of the continuous variables
+void CouenneNlpMemo::signature (const CouNumber *x, const CouNumber *lb, const CouNumber *ub,
+				std::vector <CouNumber> &v) const {
+  v.clear ();
+
+  for (int i = 0, n = problem_ -> nOrigVars (); i < n; i++) {
+
+    if (problem_ -> Var (i) -> Multiplicity () <= 0)
+      continue;
+
+    if (problem_ -> Var (i) -> isInteger ())
+      v.push_back (floor (x [i] + .5));
+    else {
+      v.push_back (lb [i]);
+      v.push_back (ub [i]);
+    }
+  }
+}
+
+
+/// mix the bits of a double into a hash value
+static inline unsigned long hashValue (unsigned long k, CouNumber value) {
+
+  unsigned char bytes [sizeof (CouNumber)];
+
+  if (value == 0.) // -0. and 0. have different bits
+    value = 0.;
+
+  memcpy (bytes, &value, sizeof (CouNumber));
+
+  for (unsigned int j=0; j < sizeof (CouNumber); j++)
+    k = k * 33 + bytes [j];
+
+  return k;
+}
+
+
+/// Key of the NLP with the integer assignment of x and continuous
+/// bounds lb, ub
+unsigned long CouenneNlpMemo::key (const CouNumber *x, const CouNumber *lb, const CouNumber *ub) const {
+
+  unsigned long k = 5381;
+
+  for (int i = 0, n = problem_ -> nOrigVars (); i < n; i++) {
+
+    if (problem_ -> Var (i) -> Multiplicity () <= 0)
+      continue;
+
+    if (problem_ -> Var (i) -> isInteger ())
+      k = k * 33 + (unsigned long) (long) floor (x [i] + .5);
+    else
+      k = hashValue (hashValue (k, lb [i]), ub [i]);
+
+    k ^= (unsigned long) i;
+  }
+
+  return k ? k : 1;
+}
+
+
+/// Key of the integer assignment defined by a bounding box, 0 if at
+/// least one integer variable is not fixed
+unsigned long CouenneNlpMemo::key (const CouNumber *lb, const CouNumber *ub) const {
+
+  for (int i = 0, n = problem_ -> nOrigVars (); i < n; i++)
+    if (problem_ -> Var (i) -> isInteger () &&
+	problem_ -> Var (i) -> Multiplicity () > 0 &&
+	(lb [i] < ub [i] - COUENNE_EPS))
+      return 0;
+
+  return key (lb, lb, ub);
+}
+
+
+/// Return outcome of NLP with the integer assignment of x and
+/// continuous bounds lb, ub, NULL if none
+const CouenneNlpMemo::Entry *CouenneNlpMemo::find (unsigned long k, const CouNumber *x,
+						   const CouNumber *lb, const CouNumber *ub) {
+  if (maxSize_ <= 0)
+    return NULL;
+
+  ++nLookups_;
+
+  std::map <unsigned long, Entry>::iterator i = table_.find (k);
+
+  if (i == table_.end ())
+    return NULL;
+
+  // check against hash collisions
+
+  std::vector <CouNumber> v;
+  signature (x, lb, ub, v);
+
+  if (v != i -> second.signature_)
+    return NULL;
+
+  ++nHits_;
+
+  return &(i -> second);
+}
+
+
+/// Store outcome of the NLP with the integer assignment of x and
+/// continuous bounds lb, ub
+void CouenneNlpMemo::insert (unsigned long k, const CouNumber *x,
+			     const CouNumber *lb, const CouNumber *ub,
+			     CouNumber obj, bool feasible, const CouNumber *sol) {
+  if (maxSize_ <= 0)
+    return;
+
+  std::map <unsigned long, Entry>::iterator i = table_.find (k);
+
+  if (i != table_.end ()) {
+
+    // replace (collision or newer outcome) in place: the key keeps
+    // its position in the eviction queue
+
+    Entry &e = i -> second;
+
+    if (e.sol_)
+      delete [] e.sol_;
+
+    signature (x, lb, ub, e.signature_);
+
+    e.obj_      = obj;
+    e.feasible_ = feasible;
+    e.sol_      = (feasible && sol) ? CoinCopyOfArray (sol, problem_ -> nOrigVars ()) : NULL;
+
+    return;
+  }
+
+  // evict oldest entries
+
+  while ((int) table_.size () >= maxSize_ && !order_.empty ()) {
+
+    std::map <unsigned long, Entry>::iterator j = table_.find (order_.front ());
+    order_.pop_front ();
+
+    if (j != table_.end ())
+      erase (j);
+  }
+
+  Entry &e = table_ [k];
+
+  signature (x, lb, ub, e.signature_);
+
+  e.obj_      = obj;
+  e.feasible_ = feasible;
+  e.sol_      = (feasible && sol) ? CoinCopyOfArray (sol, problem_ -> nOrigVars ()) : NULL;
+
+  order_.push_back (k);
+}
+
+
+/// remove entry and free its solution
+void CouenneNlpMemo::erase (std::map <unsigned long, Entry>::iterator i) {
+
+  if (i -> second.sol_)
+    delete [] i -> second.sol_;
+
+  table_.erase (i);
+}
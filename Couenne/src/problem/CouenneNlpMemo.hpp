@@ -0,0 +1,116 @@
+/* $Id$
+ *
+ * Name:    CouenneNlpMemo.hpp
+ * Author:  Pietro Belotti
+ * Purpose: memo table of NLPs solved with fixed integer variables
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#ifndef COUENNENLPMEMO_HPP
+#define COUENNENLPMEMO_HPP
+
+#include <map>
+#include <deque>
+#include <vector>
+
+#include "CouenneTypes.hpp"
+
+namespace Couenne {
+
+  class CouenneProblem;
+
+  /// Bounded table of outcomes of NLPs solved with all integer
+  /// variables fixed. It is shared (through the CouenneProblem) by
+  /// all heuristics that fix integer variables and solve an NLP, so
+  /// that the same NLP is not solved twice in the tree. An NLP is
+  /// identified by the integer assignment and by the bounds on the
+  /// continuous variables, as the same assignment may be infeasible
+  /// at one node and feasible at another.
+
+  class CouenneNlpMemo {
+
+  public:
+
+    /// Outcome of one NLP
+    struct Entry {
+
+      std::vector <CouNumber> signature_; ///< integer assignment and continuous bounds
+      CouNumber               obj_;       ///< objective value (if feasible)
+      bool                    feasible_;  ///< true if NLP returned MINLP feasible solution
+      CouNumber              *sol_;       ///< original variables of solution (NULL if infeasible)
+    };
+
+    /// Constructor
+    CouenneNlpMemo (CouenneProblem *p, int maxSize = 1000);
+
+    /// Copy constructor
+    CouenneNlpMemo (const CouenneNlpMemo &rhs);
+
+    /// Destructor
+    ~CouenneNlpMemo ();
+
+    /// true if outcomes are stored (nlp_memo_size > 0). If not,
+    /// callers should skip key computation and lookup altogether
+    bool enabled () const {return maxSize_ > 0;}
+
+    /// Key of the NLP with the integer assignment of x (integer
+    /// components are rounded) and continuous bounds lb, ub
+    unsigned long key (const CouNumber *x, const CouNumber *lb, const CouNumber *ub) const;
+
+    /// Key of the NLP defined by a bounding box, 0 if at least one
+    /// integer variable is not fixed
+    unsigned long key (const CouNumber *lb, const CouNumber *ub) const;
+
+    /// Return outcome of NLP with the integer assignment of x and
+    /// continuous bounds lb, ub (keyed with k), NULL if none. Counts
+    /// a saved NLP solve if found
+    const Entry *find (unsigned long k, const CouNumber *x, const CouNumber *lb, const CouNumber *ub);
+
+    /// Store outcome of the NLP with the integer assignment of x and
+    /// continuous bounds lb, ub. Only the original variables of sol
+    /// are stored
+    void insert (unsigned long k, const CouNumber *x, const CouNumber *lb, const CouNumber *ub,
+		 CouNumber obj, bool feasible, const CouNumber *sol);
+
+    /// number of lookups
+    int nLookups () const {return nLookups_;}
+
+    /// number of lookups that avoided an NLP solve
+    int nHits () const {return nHits_;}
+
+    /// number of entries in the table
+    int size () const {return (int) table_.size ();}
+
+    /// maximum number of entries in the table
+    int maxSize () const {return maxSize_;}
+
+  protected:
+
+    /// fill vector with (rounded) integer components of x followed by
+    /// the bounds of the continuous variables
+    void signature (const CouNumber *x, const CouNumber *lb, const CouNumber *ub,
+		    std::vector <CouNumber> &v) const;
+
+    /// remove entry and free its solution
+    void erase (std::map <unsigned long, Entry>::iterator i);
+
+    /// Problem the integer variables refer to
+    CouenneProblem *problem_;
+
+    /// Maximum number of entries
+    int maxSize_;
+
+    /// Table of outcomes
+    std::map <unsigned long, Entry> table_;
+
+    /// Keys by insertion order, for eviction of oldest entries
+    std::deque <unsigned long> order_;
+
+    /// Statistics
+    int nLookups_;
+    int nHits_;
+  };
+}
+
+#endif
@@ -133,7 +133,7 @@ struct less_than_str {
 
 namespace Couenne {
 
-  enum TrilinDecompType {rAI, treeDecomp, bi_tri, tri_bi};
+  enum TrilinDecompType {rAI, treeDecomp, bi_tri, tri_bi, multilin};
 
   class exprVar;
   class exprAux;
@@ -148,6 +148,7 @@ namespace Couenne {
   class GlobalCutOff;
   class CouenneBTPerfIndicator;
   class CouenneRecordBestSol;
+  class CouenneNlpMemo;
   class CouenneSdpCuts;
 
   typedef Ipopt::SmartPtr<Ipopt::Journalist> JnlstPtr;
@@ -266,6 +267,9 @@ class CouenneProblem {
   /// Use quadratic expressions?
   bool useQuadratic_;
 
+  /// Replace \sqrt {\sum_i f_i(x)^2} with an exprNorm?
+  bool useNorm_;
+
   /// feasibility tolerance (to be used in checkNLP)
   CouNumber feas_tolerance_;
 
@@ -309,6 +313,16 @@ class CouenneProblem {
   // to record best solution found
   CouenneRecordBestSol *recBSol;
 
+  /// outcomes of NLPs solved with fixed integer variables, shared by
+  /// heuristics
+  CouenneNlpMemo *nlpMemo_;
+
+  /// Workspaces of checkNLP, checkNLP2 and checkNLPBatch, with
+  /// nVars () elements, allocated at the first call and reused
+  mutable std::vector <CouNumber> checkSol_;
+  mutable std::vector <CouNumber> checkRecSol_;
+  mutable std::vector <CouNumber> checkBest_;
+
   /// Type of Multilinear separation
   enum multiSep multilinSep_;
 
@@ -322,6 +336,15 @@ class CouenneProblem {
   /// use orbital branching?
   bool orbitalBranching_;
 
+  /// use the symmetry group of the root node to tighten bounds at
+  /// all nodes (and to compute orbits for orbital branching)?
+  bool orbitalFixing_;
+
+  /// generators of the symmetry group computed at the root node, each
+  /// as the list of pairs (i, j) of variables such that i is mapped
+  /// into j != i
+  std::vector <std::vector <std::pair <int, int> > > symGenerators_;
+
   /// check bounds on auxiliary variables when verifying MINLP
   /// feasibility of a solution. Usually this is not needed, unless
   /// some manipulation on auxiliary variables is done before
@@ -338,6 +361,10 @@ class CouenneProblem {
   /// CouenneProblem when we do it with FBBT
   CouenneBTPerfIndicator *perfIndicator_;
 
+  /// Performance indicators (and adaptive schedule) for OBBT and ABT
+  CouenneBTPerfIndicator *obbtPerfIndicator_;
+  CouenneBTPerfIndicator *abtPerfIndicator_;
+
   /// Return particular constraint class. Classes:
   /// 
   /// 1) "convex": convex constraints;
@@ -398,6 +425,35 @@ class CouenneProblem {
 
   /// empty if no NTY, symmetry data structure setup otherwise
   void setupSymmetry ();
+
+  /// store the generators found by the last symmetry computation as
+  /// generators of the symmetry group of the root node (empty if no NTY)
+  void setupSymGenerators ();
+
+  /// Add a generator of the symmetry group of the root node, as a
+  /// permutation of the nVars () variables. It is discarded if it
+  /// maps an integer into a continuous variable or moves the
+  /// objective variable
+  void addSymGenerator (const int *perm);
+
+  /// number of generators of the symmetry group of the root node
+  int nSymGenerators () const
+  {return (int) symGenerators_.size ();}
+
+  /// Orbits of the group generated by the generators of the root
+  /// group that map the box [lb,ub] onto itself: orbit [i] is the
+  /// smallest index of the orbit of variable i
+  void symOrbits (const CouNumber *lb, const CouNumber *ub, std::vector <int> &orbit) const;
+
+  /// Orbits as above, as a list of orbits (including trivial ones) in
+  /// the same format as Nauty::getOrbits (). To be deleted by caller
+  std::vector <std::vector <int> > *nodeOrbits (const CouNumber *lb, const CouNumber *ub) const;
+
+  /// Apply to all variables of an orbit (as computed by symOrbits ()
+  /// on the bounds at the beginning of the node) the tightest bounds
+  /// of the orbit. Returns the number of bounds tightened, or -1 if
+  /// the node is infeasible
+  int orbitalFixing (const std::vector <int> &orbit, t_chg_bounds *chg_bds) const;
   
   /// get evaluation order index 
   inline int evalOrder (int i) const
@@ -500,9 +556,14 @@ class CouenneProblem {
   bool doOBBT () const {return doOBBT_;} ///< shall we do Optimality  Based Bound Tightening?
   bool doABT  () const {return doABT_;}  ///< shall we do Aggressive        Bound Tightening?
 
+  bool useNorm () const {return useNorm_;} ///< replace square roots of sums of squares with norms?
+
   int  logObbtLev () const {return logObbtLev_;} ///< How often shall we do OBBT?
   int  logAbtLev  () const {return logAbtLev_;}  ///< How often shall we do ABT?
 
+  /// Performance indicator of ABT, which decides whether to run it at a node
+  CouenneBTPerfIndicator *abtPerfIndicator () const {return abtPerfIndicator_;}
+
   /// Write nonlinear problem to a .mod file (with lots of defined
   /// variables)
   /// 
@@ -708,10 +769,18 @@ class CouenneProblem {
   bool fbbtReachedIterLimit () const
   {return fbbtReachedIterLimit_;}
 
+  /// set the above (used to align copies of the problem)
+  void setFbbtReachedIterLimit (bool yes)
+  {fbbtReachedIterLimit_ = yes;}
+
   /// return true if orbital branching activated
   bool orbitalBranching () const
   {return orbitalBranching_;}
 
+  /// return true if orbital fixing activated
+  bool orbitalFixing () const
+  {return orbitalFixing_;}
+
   /// set the value for checkAuxBounds. When true, all MINLP feasible
   /// solutions will additionally be tested for feasibility with
   /// respect to auxiliary variable bounds. This is normally not needed.
@@ -817,6 +886,10 @@ public:
   inline CouenneRecordBestSol *getRecordBestSol() const 
   {return recBSol;}
 
+  /// returns table of NLPs solved with fixed integer variables
+  inline CouenneNlpMemo *nlpMemo () const
+  {return nlpMemo_;}
+
   /// returns feasibility tolerance
   double getFeasTol() {return feas_tolerance_;}
 
@@ -828,7 +901,7 @@ public:
   /// return true if all integer vars are within precision of an integer value
   bool checkInt(const CouNumber *sol,
 		const int from, const int upto, 
-		const std::vector<int> listInt,
+		const std::vector<int> &listInt,
 		const bool origVarOnly, 
 		const bool stopAtFirstViol,
 		const double precision, double &maxViol) const;
@@ -888,6 +961,21 @@ public:
 		 const bool checkAll        = false,
 	         const double precision     = -1) const; // if -1 then use feas_tolerance_
 
+  /// Check nSols candidate solutions with checkNLP0 (stopping at the
+  /// first violation, not caring about the objective). If feasible
+  /// is not NULL, feasible [i] tells whether solutions [i] is
+  /// feasible; obj [i] is the value of solutions [i] and, if it is
+  /// feasible, is replaced by the recomputed objective. Returns the
+  /// index of the feasible solution with minimum objective, or -1 if
+  /// there is none; in the first case, the modified solution stored
+  /// in the CouenneRecordBestSol object is that of this solution.
+  int checkNLPBatch (int nSols,
+		     const double * const *solutions,
+		     double *obj,
+		     bool *feasible         = NULL,
+		     const bool checkAll    = false,
+		     const double precision = -1) const;
+
   /// return particular constraint class. Classes:
   /// 
   /// 1) "convex": convex constraints;
@@ -34,6 +34,7 @@
 #include "CouenneObject.hpp"
 
 #include "CouenneRecordBestSol.hpp"
+#include "CouenneNlpMemo.hpp"
 #include "CouenneBTPerfIndicator.hpp"
 #include "CouenneSdpCuts.hpp"
 
@@ -72,6 +73,7 @@ CouenneProblem::CouenneProblem (struct ASL *asl,
   jnlst_     (jnlst),
   opt_window_ (COIN_DBL_MAX),
   useQuadratic_ (false),
+  useNorm_      (false),
   feas_tolerance_ (feas_tolerance_default),
   integerRank_ (NULL),
   maxCpuTime_  (COIN_DBL_MAX),
@@ -81,11 +83,15 @@ CouenneProblem::CouenneProblem (struct ASL *asl,
 #endif
   unusedOriginalsIndices_ (NULL),
   nUnusedOriginals_ (-1),
+  nlpMemo_ (NULL),
   multilinSep_ (CouenneProblem::MulSepNone),
   max_fbbt_iter_ (MAX_FBBT_ITER),
   orbitalBranching_ (false),
+  orbitalFixing_ (false),
   constObjVal_ (0.),
   perfIndicator_ (new CouenneBTPerfIndicator (this, "FBBT")),
+  obbtPerfIndicator_ (new CouenneBTPerfIndicator (this, "OBBT",            true)),
+  abtPerfIndicator_  (new CouenneBTPerfIndicator (this, "Aggressive FBBT", true)),
 
   nauty_info (NULL),
   sdpCutGen_ (NULL) {
@@ -115,6 +121,9 @@ CouenneProblem::CouenneProblem (struct ASL *asl,
   recBSol = new CouenneRecordBestSol();
   lastPrioSort_ = 1000000;
 
+  if (!nlpMemo_) // not created in initOptions
+    nlpMemo_ = new CouenneNlpMemo (this);
+
   minDepthPrint_ = -1;
   minNodePrint_ = -1;
   doPrint_ = false;
@@ -126,6 +135,7 @@ CouenneProblem::CouenneProblem (struct ASL *asl,
 CouenneProblem::CouenneProblem (const CouenneProblem &p):
   problemName_  (p.problemName_),
   domain_       (p.domain_),
+  auxSet_       (NULL),
   curnvars_     (-1),
   nIntVars_     (p.nIntVars_),
   optimum_      (NULL),
@@ -148,6 +158,7 @@ CouenneProblem::CouenneProblem (const CouenneProblem &p):
   jnlst_        (p.jnlst_),
   opt_window_   (p.opt_window_),    // needed only in standardize (), unnecessary to update it
   useQuadratic_ (p.useQuadratic_),  // ditto
+  useNorm_      (p.useNorm_),       // ditto
   feas_tolerance_ (p.feas_tolerance_),
   dependence_   (p.dependence_),
   objects_      (p.objects_), // NO! have to copy all of them 
@@ -162,18 +173,30 @@ CouenneProblem::CouenneProblem (const CouenneProblem &p):
   nUnusedOriginals_ (p.nUnusedOriginals_),
   multilinSep_  (p.multilinSep_),
   max_fbbt_iter_  (p.max_fbbt_iter_),
+  fbbtReachedIterLimit_ (p.fbbtReachedIterLimit_),
   orbitalBranching_  (p.orbitalBranching_),
+  orbitalFixing_     (p.orbitalFixing_),
+  symGenerators_     (p.symGenerators_),
+  checkAuxBounds_    (p.checkAuxBounds_),
+  trilinDecompType_  (p.trilinDecompType_),
   constObjVal_       (p.constObjVal_),
   perfIndicator_     (new CouenneBTPerfIndicator (*(p.perfIndicator_))),
-  nauty_info         (p.nauty_info) {
+  obbtPerfIndicator_ (new CouenneBTPerfIndicator (*(p.obbtPerfIndicator_))),
+  abtPerfIndicator_  (new CouenneBTPerfIndicator (*(p.abtPerfIndicator_))),
+  sdpCutGen_         (p.sdpCutGen_ ? new CouenneSdpCuts (*(p.sdpCutGen_)) : NULL),
+  nauty_info         (NULL) { // symmetry data is not shared, or it would be deleted twice
+
+  // statistics of bound tighteners are printed by the original only
 
-  sdpCutGen_  = new CouenneSdpCuts (*(p.sdpCutGen_));
+  perfIndicator_     -> setStats (false);
+  obbtPerfIndicator_ -> setStats (false);
+  abtPerfIndicator_  -> setStats (false);
 
   for (int i=0; i < p.nVars (); i++)
     variables_ . push_back (NULL);
 
   for (int i=0; i < p.nVars (); i++) {
-    int ind = p.numbering_ [i];
+    int ind = p.numbering_ ? p.numbering_ [i] : i;
     variables_ [ind] = p.Var (ind) -> clone (&domain_);
   }
 
@@ -209,6 +232,9 @@ CouenneProblem::CouenneProblem (const CouenneProblem &p):
   if (p.recBSol) recBSol = new CouenneRecordBestSol (*(p.recBSol));
   else           recBSol = new CouenneRecordBestSol ();
 
+  // start with an empty table, as solutions refer to p's variables
+  nlpMemo_ = new CouenneNlpMemo (this, p.nlpMemo_ ? p.nlpMemo_ -> maxSize () : 0);
+
   lastPrioSort_ = p.lastPrioSort_;
 
   minDepthPrint_ = p.minDepthPrint_;
@@ -229,6 +255,9 @@ CouenneProblem::~CouenneProblem () {
   if (perfIndicator_)
     delete perfIndicator_;
 
+  delete obbtPerfIndicator_;
+  delete abtPerfIndicator_;
+
   // delete optimal solution (if any)
   if (optimum_)
     free (optimum_);
@@ -270,6 +299,7 @@ CouenneProblem::~CouenneProblem () {
 #endif
 
   delete recBSol;
+  delete nlpMemo_;
 }
 
 
@@ -281,6 +311,7 @@ void CouenneProblem::initOptions (Ipopt::SmartPtr<Ipopt::OptionsList> options) {
   std::string s;
 
   options -> GetStringValue ("use_quadratic",   s, "couenne."); useQuadratic_ = (s == "yes");
+  options -> GetStringValue ("use_norm",        s, "couenne."); useNorm_      = (s == "yes");
   options -> GetStringValue ("feasibility_bt",  s, "couenne."); doFBBT_ = (s == "yes");
   options -> GetStringValue ("redcost_bt",      s, "couenne."); doRCBT_ = (s == "yes");
   options -> GetStringValue ("optimality_bt",   s, "couenne."); doOBBT_ = (s == "yes");
@@ -291,6 +322,18 @@ void CouenneProblem::initOptions (Ipopt::SmartPtr<Ipopt::OptionsList> options) {
 
   options -> GetIntegerValue ("max_fbbt_iter",  max_fbbt_iter_,  "couenne.");
 
+  double minRate;
+  options -> GetStringValue  ("adaptive_bt",          s,       "couenne.");
+  options -> GetNumericValue ("adaptive_bt_min_rate", minRate, "couenne.");
+
+  obbtPerfIndicator_ -> setAdaptive (s == "yes", minRate);
+  abtPerfIndicator_  -> setAdaptive (s == "yes", minRate);
+
+  int memoSize;
+  options -> GetIntegerValue ("nlp_memo_size",  memoSize,  "couenne.");
+  delete nlpMemo_;
+  nlpMemo_ = new CouenneNlpMemo (this, memoSize);
+
   options -> GetNumericValue ("feas_tolerance",  feas_tolerance_, "couenne.");
   options -> GetNumericValue ("opt_window",      opt_window_,     "couenne.");
 
@@ -300,10 +343,12 @@ void CouenneProblem::initOptions (Ipopt::SmartPtr<Ipopt::OptionsList> options) {
                  		  CouenneProblem::MulSepTight);
 
   options -> GetStringValue ("orbital_branching",   s, "couenne."); orbitalBranching_ = (s == "yes");
+  options -> GetStringValue ("orbital_fixing",      s, "couenne."); orbitalFixing_    = (s == "yes");
 
   options -> GetStringValue ("quadrilinear_decomp", s, "couenne."); 
   if      (s == "rAI")     trilinDecompType_ = rAI;
   else if (s == "tri+bi")  trilinDecompType_ = tri_bi;
   else if (s == "bi+tri")  trilinDecompType_ = bi_tri;
   else if (s == "hier-bi") trilinDecompType_ = treeDecomp;
+  else if (s == "multilin") trilinDecompType_ = multilin;
 }
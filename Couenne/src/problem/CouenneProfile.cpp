@@ -0,0 +1,204 @@
+/* $Id$
+ *
+ * Name:    CouenneProfile.cpp
+ * Author:  Pietro Belotti
+ * Purpose: time and counters of each component of Couenne
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "CouenneConfig.h"
+#include "CoinTime.hpp"
+#include "CoinFinite.hpp"
+#include "CouenneProfile.hpp"
+
+#ifdef COUENNE_HAS_PTHREAD
+#include <pthread.h>
+
+/// serializes updates of the counters, as components may be called
+/// by separators running in parallel threads
+static pthread_mutex_t profileMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+using namespace Ipopt;
+using namespace Couenne;
+
+bool                     CouenneProfile::enabled_ = false;
+CouenneProfile::Counters CouenneProfile::counters_ [PROF_NCOMPONENTS];
+
+std::vector <std::pair <std::string, double> > CouenneProfile::summary_;
+
+/// names of the components, in the order of enum Component
+static const char *componentNames [] = {
+  "Convexification",
+  "FBBT",
+  "OBBT",
+  "Aggressive BT",
+  "Fixed point BT",
+  "Two-implied BT",
+  "Disjunctive cuts",
+  "SDP cuts",
+  "Ellipsoidal cuts",
+  "NLP heuristic",
+  "Feasibility pump",
+  "Iterative rounding",
+  "Strong branching",
+  "Symmetry"
+};
+
+
+/// CPU time of the calling thread if available, of the process
+/// otherwise. With parallel separators, the CPU time of the process
+/// also counts that of the other threads
+static double threadCpuTime () {
+
+#if defined (COUENNE_HAS_PTHREAD) && defined (CLOCK_THREAD_CPUTIME_ID)
+
+  struct timespec ts;
+
+  if (!clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts))
+    return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+#endif
+
+  return CoinCpuTime ();
+}
+
+
+/// start timer
+CouenneProfile::Timer::Timer (enum Component c):
+
+  comp_      (c),
+  cpuStart_  (enabled_ ? threadCpuTime     () : -1.),
+  wallStart_ (enabled_ ? CoinWallclockTime () : -1.),
+  nBounds_   (0),
+  nCuts_     (0),
+  nPruned_   (0),
+  nSols_     (0) {}
+
+
+/// stop timer and add counters to profile
+CouenneProfile::Timer::~Timer () {
+
+  if (cpuStart_ < 0.)
+    return;
+
+  double
+    cpuTime  = threadCpuTime     () - cpuStart_,
+    wallTime = CoinWallclockTime () - wallStart_;
+
+#ifdef COUENNE_HAS_PTHREAD
+  pthread_mutex_lock (&profileMutex);
+#endif
+
+  Counters &c = counters_ [comp_];
+
+  c.cpuTime_  += cpuTime;
+  c.wallTime_ += wallTime;
+
+  ++c.nCalls_;
+
+  c.nBounds_ += nBounds_;
+  c.nCuts_   += nCuts_;
+  c.nPruned_ += nPruned_;
+  c.nSols_   += nSols_;
+
+#ifdef COUENNE_HAS_PTHREAD
+  pthread_mutex_unlock (&profileMutex);
+#endif
+}
+
+
+/// Name of a component
+const char *CouenneProfile::name (enum Component c)
+{return componentNames [c];}
+
+
+/// Print table of all components that have been called at least
+/// once. Times are inclusive: a component called by another (e.g.
+/// FBBT within the convexification) is counted in both
+void CouenneProfile::print (ConstJnlstPtr jnlst) {
+
+  if (!enabled_)
+    return;
+
+  jnlst -> Printf (J_ERROR, J_COUENNE, "\n\
+Component               Calls   CPU time  Wall time    Bounds      Cuts    Pruned Solutions\n");
+
+  for (int i=0; i < PROF_NCOMPONENTS; i++) {
+
+    const Counters &c = counters_ [i];
+
+    if (c.nCalls_)
+      jnlst -> Printf (J_ERROR, J_COUENNE, "%-20s %8d %9.3fs %9.3fs %9d %9d %9d %9d\n",
+		       componentNames [i], c.nCalls_, c.cpuTime_, c.wallTime_,
+		       c.nBounds_, c.nCuts_, c.nPruned_, c.nSols_);
+  }
+}
+
+
+/// Write summary and profile in JSON format. One item per line, so
+/// that the file can also be read by line-oriented tools (see
+/// test/benchmark.sh)
+bool CouenneProfile::writeJSON (const std::string &file) {
+
+  FILE *f = fopen (file.c_str (), "w");
+
+  if (!f)
+    return false;
+
+  fprintf (f, "{\n  \"summary\": {");
+
+  for (std::vector <std::pair <std::string, double> >::iterator i = summary_.begin (); i != summary_.end (); ++i) {
+
+    fprintf (f, "%s\n    \"%s\": ", (i == summary_.begin ()) ? "" : ",", i -> first.c_str ());
+
+    if (CoinFinite (i -> second)) fprintf (f, "%.12g", i -> second);
+    else                          fprintf (f, "null");
+  }
+
+  fprintf (f, "\n  },\n  \"components\": [");
+
+  bool first = true;
+
+  for (int i=0; i < PROF_NCOMPONENTS; i++) {
+
+    const Counters &c = counters_ [i];
+
+    fprintf (f, "%s\n    {\"name\": \"%s\", \"calls\": %d, \"cpu\": %g, \"wall\": %g, "
+	     "\"bounds\": %d, \"cuts\": %d, \"pruned\": %d, \"solutions\": %d}",
+	     first ? "" : ",", componentNames [i],
+	     c.nCalls_, c.cpuTime_, c.wallTime_, c.nBounds_, c.nCuts_, c.nPruned_, c.nSols_);
+
+    first = false;
+  }
+
+  fprintf (f, "\n  ]\n}\n");
+  fclose (f);
+
+  return true;
+}
+
+
+/// Add list of options to be read from file
+void CouenneProfile::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddStringOption2
+    ("profile",
+     "Collect time and counters for each component of Couenne",
+     "no",
+     "no",  "",
+     "yes", "",
+     "If enabled, a table with calls, CPU and wallclock time, bounds tightened, cuts added, nodes pruned, and solutions found "
+     "by each cut generator, bound tightening method, heuristic, and branching routine "
+     "is printed at the end of the run.");
+
+  roptions -> AddStringOption1
+    ("profile_file",
+     "File where the profile is written in JSON format",
+     "",
+     "*", "any file name",
+     "Only used if profile is enabled. If empty (default), the profile is only printed.");
+}
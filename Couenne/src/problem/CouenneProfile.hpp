@@ -0,0 +1,133 @@
+/* $Id$
+ *
+ * Name:    CouenneProfile.hpp
+ * Author:  Pietro Belotti
+ * Purpose: time and counters of each component of Couenne
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#ifndef COUENNEPROFILE_HPP
+#define COUENNEPROFILE_HPP
+
+#include <string>
+#include <vector>
+
+#include "BonRegisteredOptions.hpp"
+#include "CouenneJournalist.hpp"
+
+namespace Couenne {
+
+  /// Profile of a run: for each component (cut generator, bound
+  /// tightening method, heuristic, branching routine), CPU and
+  /// wallclock time, number of calls, bounds tightened, cuts added,
+  /// nodes pruned, and solutions found. Components report through a Timer object
+  /// declared at the beginning of their main method. Collection is
+  /// enabled with option profile, and the table is printed at the
+  /// end of couenne (and optionally written as JSON).
+
+  class CouenneProfile {
+
+  public:
+
+    /// Components
+    enum Component {PROF_CONVEXIFICATION, PROF_FBBT, PROF_OBBT, PROF_ABT, PROF_FIXPOINT,
+		    PROF_TWOIMPLIED, PROF_DISJCUTS, PROF_SDPCUTS, PROF_ELLIPCUTS,
+		    PROF_NLPHEUR, PROF_FEASPUMP, PROF_ITERROUND, PROF_STRONGBRANCH, PROF_SYMMETRY,
+		    PROF_NCOMPONENTS};
+
+    /// Counters of one component
+    struct Counters {
+
+      double cpuTime_;   ///< CPU time of the thread running the component
+      double wallTime_;  ///< wallclock time
+      int    nCalls_;    ///< number of calls
+      int    nBounds_;   ///< number of bounds tightened
+      int    nCuts_;     ///< number of cuts added
+      int    nPruned_;   ///< number of nodes proven infeasible (or fathomed)
+      int    nSols_;     ///< number of (improving) solutions found
+    };
+
+    /// Measures time from construction to destruction, and collects
+    /// the counters of one call to a component
+    class Timer {
+
+    public:
+
+      /// start timer
+      Timer (enum Component c);
+
+      /// stop timer and add counters to profile
+      ~Timer ();
+
+      /// add n tightened bounds
+      void bounds (int n)
+      {nBounds_ += n;}
+
+      /// add n cuts
+      void cuts (int n)
+      {nCuts_ += n;}
+
+      /// node was pruned
+      void pruned ()
+      {nPruned_ = 1;}
+
+      /// solution was found
+      void solution ()
+      {nSols_ = 1;}
+
+    protected:
+
+      enum Component comp_;
+      double cpuStart_;
+      double wallStart_;
+      int    nBounds_;
+      int    nCuts_;
+      int    nPruned_;
+      int    nSols_;
+    };
+
+    /// Enable collection
+    static void enable (bool yes = true)
+    {enabled_ = yes;}
+
+    /// True if profiling is enabled
+    static bool enabled ()
+    {return enabled_;}
+
+    /// Counters of a component
+    static const Counters &counters (enum Component c)
+    {return counters_ [c];}
+
+    /// Name of a component
+    static const char *name (enum Component c);
+
+    /// Print table of all components that have been called at least once
+    static void print (ConstJnlstPtr jnlst);
+
+    /// Add a value to the summary of the run (time, bounds, nodes...),
+    /// which is written in the JSON file together with the profile
+    static void addSummary (const std::string &key, double value)
+    {summary_.push_back (std::pair <std::string, double> (key, value));}
+
+    /// Write summary and profile in JSON format. Return false if file
+    /// could not be opened
+    static bool writeJSON (const std::string &file);
+
+    /// Add list of options to be read from file
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+  protected:
+
+    /// true if counters are updated
+    static bool enabled_;
+
+    /// counters for all components
+    static Counters counters_ [PROF_NCOMPONENTS];
+
+    /// summary of the run
+    static std::vector <std::pair <std::string, double> > summary_;
+  };
+}
+
+#endif
@@ -62,7 +62,7 @@ public:
 
   inline int getCardInitDom() const {return cardInitDom;};
   inline bool *getInitIsInt() const {return initIsInt;};
-  inline std::vector<int> getListInt() const {return listInt;};
+  inline const std::vector<int> &getListInt() const {return listInt;};
   // set both initIsInt and listInt from the given vector givenIsInt
   void setInitIsInt(const bool *givenIsInt, const int givenCard);
   inline CouNumber *getInitDomLb() const {return initDomLb;};
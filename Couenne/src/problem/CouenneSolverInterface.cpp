@@ -14,6 +14,7 @@
 #include "CouenneProblem.hpp"
 #include "CouenneProblemElem.hpp"
 #include "CouenneCutGenerator.hpp"
+#include "CouenneTrace.hpp"
 
 #include "CouenneRecordBestSol.hpp"                         
 
@@ -70,6 +71,8 @@ void CouenneSolverInterface<T>::initialSolve () {
 
   T::initialSolve ();
 
+  CouenneTrace::event (CouenneTrace::TRACE_LPSOLVE, T::isProvenOptimal () ? 1 : 0, T::getObjValue ());
+
   // if (beforeFirstRootLP_ && T::isProvenOptimal ()) {
   //   printf ("\n\nGot first LP: %g\n\n", getObjValue ());
   //   beforeFirstRootLP_ = false;
@@ -145,6 +148,8 @@ void CouenneSolverInterface<T>::resolve () {
   // re-solve problem
   T::resolve ();
 
+  CouenneTrace::event (CouenneTrace::TRACE_LPSOLVE, T::isProvenOptimal () ? 1 : 0, T::getObjValue ());
+
   // printf ("solution: (");
   // for (int i=0; i< T::getNumCols (); i++)
   //   printf ("%g ", T::getColSolution () [i]);
@@ -0,0 +1,252 @@
+/* $Id$
+ *
+ * Name:    CouenneStatus.cpp
+ * Author:  Pietro Belotti
+ * Purpose: periodic machine-readable status of the branch-and-bound
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "CoinFinite.hpp"
+#include "CbcModel.hpp"
+#include "CbcTree.hpp"
+
+#include "CouenneStatus.hpp"
+#include "CouenneProfile.hpp"
+
+#if !defined(_MSC_VER) && !defined(__MSVCRT__)
+#define COUENNE_STATUS_POSIX
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+using namespace Couenne;
+
+std::string  CouenneStatus::target_;
+bool         CouenneStatus::socket_    = false;
+int          CouenneStatus::sockFd_    = -1;
+double       CouenneStatus::interval_  = 0.;
+double       CouenneStatus::startTime_ = 0.;
+double       CouenneStatus::startCpu_  = 0.;
+double       CouenneStatus::nextTime_  = 0.;
+double       CouenneStatus::lastTime_  = 0.;
+int          CouenneStatus::lastNodes_ = 0;
+CbcModel    *CouenneStatus::model_     = NULL;
+int          CouenneStatus::nNlpSols_  = 0;
+
+
+/// Open the status output and start the clock
+void CouenneStatus::open (const std::string &target, double interval) {
+
+  if ((interval <= 0.) || (target.length () == 0))
+    return;
+
+  socket_ = (target.compare (0, 5, "unix:") == 0);
+  target_ = socket_ ? target.substr (5) : target;
+
+  if (socket_) {
+
+#ifdef COUENNE_STATUS_POSIX
+    sockFd_ = socket (AF_UNIX, SOCK_DGRAM, 0);
+#endif
+
+    if (sockFd_ < 0) {
+      fprintf (stderr, "Couenne: could not open socket %s, no status will be sent\n", target_.c_str ());
+      return;
+    }
+  }
+
+  interval_  = interval;
+  startTime_ = lastTime_ = CoinWallclockTime ();
+  startCpu_  = CoinCpuTime ();
+  nextTime_  = startTime_ + interval_;
+  lastNodes_ = 0;
+  nNlpSols_  = 0;
+}
+
+
+/// Write the status record. Nodes per second are computed since the
+/// last record; shares of the components are relative to the CPU time
+/// since open() and may sum up to more than one, as the time of a
+/// component called by another is also counted in the caller
+void CouenneStatus::write (bool finished) {
+
+  double
+    now   = CoinWallclockTime (),
+    cpu   = CoinCpuTime () - startCpu_,
+    lb    = -COIN_DBL_MAX,
+    ub    =  COIN_DBL_MAX;
+
+  int
+    nodes = 0,
+    open  = 0;
+
+  if (model_) {
+
+    nodes = model_ -> getNodeCount ();
+    open  = model_ -> tree () ? model_ -> tree () -> size () : 0;
+    lb    = model_ -> getBestPossibleObjValue ();
+
+    if (model_ -> bestSolution ())
+      ub = model_ -> getObjValue ();
+  }
+
+  char buf [256];
+
+  std::string rec;
+
+#define addField(fmt,value) {sprintf (buf, (fmt), (value)); rec += buf;}
+#define addBound(name,value) {						\
+    if (CoinFinite (value) && (fabs (value) < COIN_DBL_MAX / 10.)) {	\
+      sprintf (buf, ", \"%s\": %.12g", (name), (value)); rec += buf;}	\
+    else {sprintf (buf, ", \"%s\": null", (name));     rec += buf;}}
+
+  addField ("{\"state\": \"%s\"",      finished ? "finished" : "running");
+  addField (", \"time\": %.3f",        now - startTime_);
+  addField (", \"cpu\": %.3f",         cpu);
+  addField (", \"nodes\": %d",         nodes);
+  addField (", \"nodes_per_sec\": %g", (now > lastTime_) ? (nodes - lastNodes_) / (now - lastTime_) : 0.);
+  addField (", \"avg_nodes_per_sec\": %g", (now > startTime_) ? nodes / (now - startTime_) : 0.);
+  addField (", \"open_nodes\": %d",    open);
+
+  addBound ("lower_bound", lb);
+  addBound ("upper_bound", ub);
+  addBound ("gap",         ((ub < COIN_DBL_MAX) && (lb > -COIN_DBL_MAX)) ? fabs (100. * (ub - lb) / (1. + fabs (lb))) : COIN_DBL_MAX);
+
+  addField (", \"nlp_solutions\": %d", nNlpSols_);
+  addField (", \"cuts\": %d",          CouenneProfile::counters (CouenneProfile::PROF_CONVEXIFICATION). nCuts_);
+
+#ifdef COUENNE_STATUS_POSIX
+
+  struct rusage usage;
+
+  if (!getrusage (RUSAGE_SELF, &usage))
+    addField (", \"peak_rss_kb\": %ld", (long int) usage.ru_maxrss);
+
+  // current resident memory, where available
+
+  FILE *statm = fopen ("/proc/self/statm", "r");
+
+  if (statm) {
+
+    long int size, resident;
+
+    if (fscanf (statm, "%ld %ld", &size, &resident) == 2)
+      addField (", \"rss_kb\": %ld", resident * (sysconf (_SC_PAGESIZE) / 1024));
+
+    fclose (statm);
+  }
+#endif
+
+  rec += ", \"components\": {";
+
+  bool first = true;
+
+  for (int i=0; i < CouenneProfile::PROF_NCOMPONENTS; i++) {
+
+    const CouenneProfile::Counters &c = CouenneProfile::counters ((enum CouenneProfile::Component) i);
+
+    if (!(c.nCalls_))
+      continue;
+
+    sprintf (buf, "%s\"%s\": %.4f", first ? "" : ", ",
+	     CouenneProfile::name ((enum CouenneProfile::Component) i),
+	     (cpu > 0.) ? c.cpuTime_ / cpu : 0.);
+
+    rec += buf;
+    first = false;
+  }
+
+  rec += "}}\n";
+
+#undef addField
+#undef addBound
+
+  if (socket_) {
+
+#ifdef COUENNE_STATUS_POSIX
+
+    // never block: if nobody is listening, the record is lost
+
+    struct sockaddr_un addr;
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sun_family = AF_UNIX;
+    strncpy (addr.sun_path, target_.c_str (), sizeof (addr.sun_path) - 1);
+
+    sendto (sockFd_, rec.c_str (), rec.length (), MSG_DONTWAIT,
+	    (struct sockaddr *) &addr, sizeof (addr));
+#endif
+
+  } else {
+
+    // write on a temporary file and rename it, so that a reader
+    // never sees a partial record
+
+    std::string tmp = target_ + ".tmp";
+
+    FILE *f = fopen (tmp.c_str (), "w");
+
+    if (f) {
+
+      fputs (rec.c_str (), f);
+      fclose (f);
+
+      if (rename (tmp.c_str (), target_.c_str ())) {
+	remove (target_.c_str ());
+	rename (tmp.c_str (), target_.c_str ());
+      }
+    }
+  }
+
+  lastTime_  = now;
+  lastNodes_ = nodes;
+  nextTime_  = now + interval_;
+}
+
+
+/// Write the last status and close the output
+void CouenneStatus::close () {
+
+  if (interval_ <= 0.)
+    return;
+
+  write (true);
+
+#ifdef COUENNE_STATUS_POSIX
+  if (sockFd_ >= 0)
+    ::close (sockFd_);
+#endif
+
+  sockFd_   = -1;
+  interval_ = 0.;
+  model_    = NULL;
+}
+
+
+/// Add list of options to be read from file
+void CouenneStatus::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddStringOption1
+    ("status_file",
+     "File where the status of the branch-and-bound is written periodically",
+     "",
+     "*", "any file name, or unix:<path> for a local socket",
+     "The status is written as one line in JSON format, with nodes, nodes per second, open nodes, bounds, gap, "
+     "NLP solutions, cuts, memory, and share of CPU time of each component. "
+     "A file is overwritten at each update; with unix:<path>, the status is sent as a datagram to that socket. "
+     "If empty (default), no status is written.");
+
+  roptions -> AddLowerBoundedNumberOption
+    ("status_interval",
+     "Seconds (wallclock) between two updates of the status",
+     0., true, 10.,
+     "Only used if status_file is set.");
+}
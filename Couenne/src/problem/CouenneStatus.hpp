@@ -0,0 +1,105 @@
+/* $Id$
+ *
+ * Name:    CouenneStatus.hpp
+ * Author:  Pietro Belotti
+ * Purpose: periodic machine-readable status of the branch-and-bound
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#ifndef COUENNESTATUS_HPP
+#define COUENNESTATUS_HPP
+
+#include <string>
+
+#include "CoinTime.hpp"
+#include "BonRegisteredOptions.hpp"
+
+class CbcModel;
+
+namespace Couenne {
+
+  /// Status of a run, written every status_interval seconds (wall
+  /// clock) as one line in JSON format to a file (overwritten each
+  /// time, so that it always contains the last status) or, if the
+  /// name starts with "unix:", sent as a datagram to a local UNIX
+  /// socket. The record contains nodes and nodes per second, open
+  /// nodes, bounds and gap, number of NLP solutions, number of cuts,
+  /// memory, and the share of CPU time spent in each component (see
+  /// CouenneProfile).
+  ///
+  /// Data is fed by CouenneBab (the Cbc model, set at the beginning
+  /// and reset at the end of the B&B), CouenneInfo (NLP solutions
+  /// stored), and the cut generators (through the profile). The
+  /// convexification cut generator calls tick() at every round,
+  /// which writes the record when the interval has expired.
+
+  class CouenneStatus {
+
+  public:
+
+    /// Open the status output (file or "unix:<socket path>") and
+    /// start the clock. An interval <= 0 disables it
+    static void open (const std::string &target, double interval);
+
+    /// True if the status is written
+    static bool enabled ()
+    {return interval_ > 0.;}
+
+    /// Set the B&B model the status is read from (NULL at the end)
+    static void setModel (CbcModel *model)
+    {model_ = model;}
+
+    /// Count one NLP solution stored in CouenneInfo
+    static void nlpSolution ()
+    {++nNlpSols_;}
+
+    /// Write status if the interval has expired
+    static inline void tick () {
+      if ((interval_ > 0.) && (CoinWallclockTime () >= nextTime_))
+	write (false);
+    }
+
+    /// Write the last status (with "finished" state) and close the output
+    static void close ();
+
+    /// Add list of options to be read from file
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+  protected:
+
+    /// Write the status record
+    static void write (bool finished);
+
+    /// file or socket name
+    static std::string target_;
+
+    /// true if target_ is a UNIX socket
+    static bool socket_;
+
+    /// socket descriptor (-1 if not open)
+    static int sockFd_;
+
+    /// seconds between two records (0 if disabled)
+    static double interval_;
+
+    /// wallclock and CPU time at open()
+    static double startTime_;
+    static double startCpu_;
+
+    /// wallclock time of the next record
+    static double nextTime_;
+
+    /// wallclock time and node count at the last record, for nodes/s
+    static double lastTime_;
+    static int    lastNodes_;
+
+    /// B&B model
+    static CbcModel *model_;
+
+    /// number of NLP solutions
+    static int nNlpSols_;
+  };
+}
+
+#endif
@@ -11,6 +11,8 @@
 #include <stdio.h>
 
 #include "CouenneProblem.hpp"
+#include "CouenneProblemElem.hpp"
+#include "CouenneExprVar.hpp"
 
 using namespace Couenne;
 
@@ -27,6 +29,7 @@ using namespace Couenne;
 
 #include "Nauty.h"
 #include "CouenneBranchingObject.hpp"
+#include "CouenneProfile.hpp"
 
 void Node::node(int i, double c , double l, double u, int cod, int s){
   index = i;
@@ -305,6 +308,8 @@ void CouenneProblem::sym_setup (){
 
 void CouenneProblem::Compute_Symmetry() const{
 
+  CouenneProfile::Timer timer (CouenneProfile::PROF_SYMMETRY);
+
   //  ChangeBounds (Lb (), Ub (), nVars ());
 
   // jnlst_ -> Printf(Ipopt::J_VECTOR, J_BRANCHING,"== Computing Symmetry\n");
@@ -448,20 +453,193 @@ void CouenneProblem::ChangeBounds (const double * new_lb, const double * new_ub,
 }
 #endif
 
+
+/// store the generators found by the last symmetry computation
+void CouenneProblem::setupSymGenerators () {
+
+#ifdef COIN_HAS_NTY
+
+  symGenerators_.clear ();
+
+  const std::vector <std::vector <int> > &gens = nauty_info -> getGenerators ();
+
+  // vertices 0..nVars()-1 are the variables, the others are
+  // coefficients and have a different color
+
+  for (std::vector <std::vector <int> >::const_iterator i = gens.begin (); i != gens.end (); ++i)
+    addSymGenerator (&((*i) [0]));
+
+  jnlst_ -> Printf (Ipopt::J_ITERSUMMARY, J_COUENNE,
+		    "Couenne: %d of %d generators used for orbital fixing\n",
+		    nSymGenerators (), (int) gens.size ());
+#endif
+}
+
+
+/// Add a generator of the symmetry group of the root node
+void CouenneProblem::addSymGenerator (const int *perm) {
+
+  int objInd = objectives_.size () ? Obj (0) -> Body () -> Index () : -1;
+
+  std::vector <std::pair <int, int> > moves;
+
+  for (int i=0; i < nVars (); i++) {
+
+    int j = perm [i];
+
+    if (j == i)
+      continue;
+
+    if ((j < 0) || (j >= nVars ()) ||                          // not a variable
+	(i == objInd) ||                                       // objective must stay
+	(Var (i) -> isInteger () != Var (j) -> isInteger ()))  // integrality is not a color
+      return;
+
+    moves.push_back (std::pair <int, int> (i, j));
+  }
+
+  if (moves.size ())
+    symGenerators_.push_back (moves);
+}
+
+
+/// Orbits of the group generated by the generators of the root group
+/// that map the box [lb,ub] onto itself. These are a subgroup of the
+/// symmetry group of the subproblem defined by [lb,ub], so that no
+/// symmetry computation is needed at the nodes
+void CouenneProblem::symOrbits (const CouNumber *lb, const CouNumber *ub, std::vector <int> &orbit) const {
+
+  int n = nVars ();
+
+  orbit.resize (n);
+
+  for (int i=0; i<n; i++)
+    orbit [i] = i;
+
+  for (std::vector <std::vector <std::pair <int, int> > >::const_iterator g = symGenerators_.begin ();
+       g != symGenerators_.end (); ++g) {
+
+    std::vector <std::pair <int, int> >::const_iterator m = g -> begin ();
+
+    for (; m != g -> end (); ++m)
+      if ((fabs (lb [m -> first] - lb [m -> second]) > COUENNE_EPS) ||
+	  (fabs (ub [m -> first] - ub [m -> second]) > COUENNE_EPS))
+	break;
+
+    if (m != g -> end ())
+      continue; // does not map the box onto itself
+
+    // merge orbits (union-find, root is the smallest index)
+
+    for (m = g -> begin (); m != g -> end (); ++m) {
+
+      int a = m -> first,
+	  b = m -> second;
+
+      while (orbit [a] != a) a = orbit [a] = orbit [orbit [a]];
+      while (orbit [b] != b) b = orbit [b] = orbit [orbit [b]];
+
+      if      (a < b) orbit [b] = a;
+      else if (b < a) orbit [a] = b;
+    }
+  }
+
+  for (int i=0; i<n; i++)
+    orbit [i] = orbit [orbit [i]]; // roots have smaller index, one pass suffices
+}
+
+
+/// Orbits as a list
+std::vector <std::vector <int> > *CouenneProblem::nodeOrbits (const CouNumber *lb, const CouNumber *ub) const {
+
+  std::vector <int> orbit;
+
+  symOrbits (lb, ub, orbit);
+
+  std::vector <std::vector <int> > *orbits = new std::vector <std::vector <int> >;
+
+  std::vector <int> position (orbit.size (), -1);
+
+  for (int i=0; i < (int) orbit.size (); i++) {
+
+    int &pos = position [orbit [i]];
+
+    if (pos < 0) {
+      pos = orbits -> size ();
+      orbits -> push_back (std::vector <int> ());
+    }
+
+    (*orbits) [pos].push_back (i);
+  }
+
+  return orbits;
+}
+
+
+/// Symmetry-aware propagation: let H be the group returned by
+/// symOrbits on the bounds at the beginning of the node. All
+/// tightenings since then (FBBT, OBBT, reduced cost, strong
+/// branching...) are valid for the subproblem, which is invariant
+/// under H, hence their images under H are also valid. Therefore all
+/// variables of an orbit of H can take the tightest bounds of the
+/// orbit. This includes orbital fixing: if one binary variable of an
+/// orbit is fixed, all of them are
+int CouenneProblem::orbitalFixing (const std::vector <int> &orbit, t_chg_bounds *chg_bds) const {
+
+  int
+    n        = nVars (),
+    nTighter = 0;
+
+  if ((int) orbit.size () < n)
+    return 0;
+
+  // tightest bounds of each orbit, stored at its smallest index
+
+  std::vector <CouNumber>
+    orbLb (n, -COUENNE_INFINITY),
+    orbUb (n,  COUENNE_INFINITY);
+
+  for (int i=0; i<n; i++) {
+
+    int o = orbit [i];
+
+    if (Lb (i) > orbLb [o]) orbLb [o] = Lb (i);
+    if (Ub (i) < orbUb [o]) orbUb [o] = Ub (i);
+  }
+
+  for (int i=0; i<n; i++) {
+
+    int o = orbit [i];
+
+    if (orbLb [o] > orbUb [o] + COUENNE_EPS)
+      return -1;
+
+    if (orbLb [o] > Lb (i) + COUENNE_EPS) {Lb (i) = orbLb [o]; chg_bds [i].setLower (t_chg_bounds::CHANGED); ++nTighter;}
+    if (orbUb [o] < Ub (i) - COUENNE_EPS) {Ub (i) = orbUb [o]; chg_bds [i].setUpper (t_chg_bounds::CHANGED); ++nTighter;}
+  }
+
+  if (nTighter)
+    Jnlst () -> Printf (Ipopt::J_DETAILED, J_BOUNDTIGHTENING, "Orbital fixing: %d bounds tightened\n", nTighter);
+
+  return nTighter;
+}
+
+
 void CouenneProblem::setupSymmetry () {
 
 #ifdef COIN_HAS_NTY
   sym_setup ();
   Compute_Symmetry ();
+  setupSymGenerators ();
   if (jnlst_ -> ProduceOutput (Ipopt::J_ERROR, J_COUENNE)) {
     Print_Orbits ();
     //nauty_info -> setWriteAutoms ("couenne-generators.txt");
   }
 
 #else
-  if (orbitalBranching_) 
+  if (orbitalBranching_ || orbitalFixing_)
     jnlst_ -> Printf (Ipopt::J_ERROR, J_COUENNE, "\
-Couenne: Warning, you have set orbital_branching but Nauty is not available.\n\
+Couenne: Warning, you have set orbital_branching or orbital_fixing but Nauty is not available.\n\
 Reconfigure with appropriate options --with-nauty-lib=/path/to/libnauty.* and --with-nauty-incdir=/path/to/nauty/include/files/\n");
 #endif
 }
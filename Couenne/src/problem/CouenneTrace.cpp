@@ -0,0 +1,154 @@
+/* $Id$
+ *
+ * Name:    CouenneTrace.cpp
+ * Author:  Pietro Belotti
+ * Purpose: cheap tracing guards and a ring buffer of timed events
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#include <stdio.h>
+
+#include "CouenneConfig.h"
+#include "CoinTime.hpp"
+#include "CouenneTrace.hpp"
+
+#ifdef COUENNE_HAS_PTHREAD
+#include <pthread.h>
+
+/// serializes writes to the ring buffer, as events may be recorded
+/// by separators running in parallel threads
+static pthread_mutex_t traceMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+using namespace Ipopt;
+using namespace Couenne;
+
+/// version of the binary format of the events file
+#define COUENNE_TRACE_VERSION 1
+
+int                                CouenneTrace::maxLevel_ [J_LAST_CATEGORY];
+bool                               CouenneTrace::set_      = false;
+std::vector <CouenneTrace::Event>  CouenneTrace::events_;
+int                                CouenneTrace::capacity_ = 0;
+long int                           CouenneTrace::nEvents_  = 0;
+double                             CouenneTrace::startTime_ = 0.;
+std::string                        CouenneTrace::file_;
+
+
+/// Fill the table of enabled levels from the journalist: for each
+/// category, find the highest level at which some journal prints
+void CouenneTrace::setup (JnlstPtr jnlst) {
+
+  for (int cat = 0; cat < J_LAST_CATEGORY; cat++) {
+
+    int level = J_ALL;
+
+    while ((level > J_NONE) &&
+	   !(jnlst -> ProduceOutput ((EJournalLevel) level, (EJournalCategory) cat)))
+      --level;
+
+    maxLevel_ [cat] = level;
+  }
+
+  set_ = true;
+}
+
+
+/// Allocate a ring buffer of capacity events to be dumped on file
+void CouenneTrace::openEvents (const std::string &file, int capacity) {
+
+  if (capacity <= 0)
+    return;
+
+  events_.resize (capacity);
+
+  capacity_  = capacity;
+  nEvents_   = 0;
+  file_      = file;
+  startTime_ = CoinWallclockTime ();
+}
+
+
+/// Store event in the buffer, overwriting the oldest if full
+void CouenneTrace::record (enum EventType type, int idata, double ddata) {
+
+  double time = CoinWallclockTime () - startTime_;
+
+#ifdef COUENNE_HAS_PTHREAD
+  pthread_mutex_lock (&traceMutex);
+#endif
+
+  Event &ev = events_ [nEvents_++ % capacity_];
+
+  ev.time_  = time;
+  ev.type_  = type;
+  ev.idata_ = idata;
+  ev.ddata_ = ddata;
+
+#ifdef COUENNE_HAS_PTHREAD
+  pthread_mutex_unlock (&traceMutex);
+#endif
+}
+
+
+/// Write the last recorded events in chronological order. Format
+/// (native endianness): the 8 characters "COUTRACE", then three ints
+/// (format version, size of one record, number of records), then the
+/// records as {double time; int type; int idata; double ddata}, with
+/// padding as in struct Event. Meaning of the data fields:
+///
+/// TRACE_NODE:      depth of the node,        LP bound at the node
+/// TRACE_BTPASS:    number of tightened bounds (-1 if infeasible), pass number
+/// TRACE_CUTROUND:  number of cuts generated,  LP bound before the round
+/// TRACE_LPSOLVE:   1 if optimal, 0 otherwise, objective value
+/// TRACE_HEURISTIC: 1 if solution found,       objective value if found
+
+void CouenneTrace::dumpEvents () {
+
+  if (!capacity_)
+    return;
+
+  FILE *f = fopen (file_.c_str (), "wb");
+
+  if (f) {
+
+    int
+      n      = (nEvents_ < capacity_) ? (int) nEvents_ : capacity_,
+      header [3] = {COUENNE_TRACE_VERSION, (int) sizeof (Event), n},
+      first  = (nEvents_ < capacity_) ? 0 : (int) (nEvents_ % capacity_);
+
+    fwrite ("COUTRACE", 1, 8, f);
+    fwrite (header, sizeof (int), 3, f);
+
+    // oldest events first
+
+    fwrite (&(events_ [first]), sizeof (Event), n - first, f);
+    fwrite (&(events_ [0]),     sizeof (Event), first,     f);
+
+    fclose (f);
+
+  } else fprintf (stderr, "Couenne: could not open events file %s\n", file_.c_str ());
+
+  events_.clear ();
+  capacity_ = 0;
+}
+
+
+/// Add list of options to be read from file
+void CouenneTrace::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions) {
+
+  roptions -> AddStringOption1
+    ("trace_events_file",
+     "File where a binary trace of timed events is written at the end of the branch-and-bound",
+     "",
+     "*", "any file name",
+     "Events recorded are: node start, bound tightening pass, cut round, LP solve, and heuristic call. "
+     "If empty (default), no event is recorded.");
+
+  roptions -> AddLowerBoundedIntegerOption
+    ("trace_events_size",
+     "Number of events kept in the trace",
+     1, 1 << 20,
+     "When this number is exceeded, the oldest events are overwritten.");
+}
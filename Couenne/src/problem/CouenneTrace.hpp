@@ -0,0 +1,118 @@
+/* $Id$
+ *
+ * Name:    CouenneTrace.hpp
+ * Author:  Pietro Belotti
+ * Purpose: cheap tracing guards and a ring buffer of timed events
+ *
+ * This file is licensed under the Eclipse Public License (EPL)
+ */
+
+#ifndef COUENNETRACE_HPP
+#define COUENNETRACE_HPP
+
+#include <vector>
+#include <string>
+
+#include "BonRegisteredOptions.hpp"
+#include "IpJournalist.hpp"
+#include "CouenneJournalist.hpp"
+#include "CouenneTypes.hpp"
+
+/// Highest print level that is compiled in. Output requested at a
+/// higher level within a COUENNE_TRACE guard is removed by the
+/// compiler, e.g. with -DCOUENNE_TRACE_MAXLEVEL=Ipopt::J_ITERSUMMARY
+#ifndef COUENNE_TRACE_MAXLEVEL
+#define COUENNE_TRACE_MAXLEVEL Ipopt::J_ALL
+#endif
+
+/// Guard for (debug) output in hot loops: replaces
+/// jnlst->ProduceOutput (level, category). The first test is
+/// resolved at compile time, the second is a lookup in a table set
+/// once when the journalist is configured, so that the virtual call
+/// to the Journalist only happens when output is actually produced
+#define COUENNE_TRACE(jnlst, level, category)			\
+  (((level) <= COUENNE_TRACE_MAXLEVEL) &&			\
+   Couenne::CouenneTrace::on ((level), (category)) &&		\
+   (jnlst) -> ProduceOutput ((level), (category)))
+
+namespace Couenne {
+
+  /// Tracing facilities. Two independent parts:
+  ///
+  /// 1) a table with, for each journalist category, the highest level
+  /// at which output is produced. It is filled by setup() and read by
+  /// the COUENNE_TRACE macro. Before setup() is called, all levels are
+  /// enabled and the decision is left to the journalist.
+  ///
+  /// 2) a ring buffer of timed events (node, bound tightening pass,
+  /// cut round, LP solve, heuristic call), enabled with option
+  /// trace_events_file and dumped to that file at the end of the
+  /// B&B. When not enabled, recording an event is a single test.
+
+  class CouenneTrace {
+
+  public:
+
+    /// Event types
+    enum EventType {TRACE_NODE, TRACE_BTPASS, TRACE_CUTROUND, TRACE_LPSOLVE, TRACE_HEURISTIC, TRACE_NEVENTS};
+
+    /// One event: time since openEvents(), type, and two data fields
+    /// whose meaning depends on the type (see dumpEvents())
+    struct Event {
+
+      double time_;  ///< wallclock time since the buffer was opened
+      int    type_;  ///< one of EventType
+      int    idata_; ///< integer datum (node depth, #tightened bounds, #cuts, status...)
+      double ddata_; ///< real datum (LP bound, objective...)
+    };
+
+    /// Fill the table of enabled levels from the journalist
+    static void setup (JnlstPtr jnlst);
+
+    /// True if output at this level and category may be produced
+    static inline bool on (Ipopt::EJournalLevel level, Ipopt::EJournalCategory category)
+    {return !set_ || (level <= maxLevel_ [category]);}
+
+    /// Allocate a ring buffer of capacity events to be dumped on file
+    static void openEvents (const std::string &file, int capacity);
+
+    /// Record an event (no-op if the ring buffer is not open)
+    static inline void event (enum EventType type, int idata = 0, double ddata = 0.)
+    {if (capacity_) record (type, idata, ddata);}
+
+    /// Write the last recorded events (at most capacity) in
+    /// chronological order, then free the buffer
+    static void dumpEvents ();
+
+    /// Add list of options to be read from file
+    static void registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions> roptions);
+
+  protected:
+
+    /// Store event in the buffer, overwriting the oldest if full
+    static void record (enum EventType type, int idata, double ddata);
+
+    /// highest level of output for each category
+    static int maxLevel_ [Ipopt::J_LAST_CATEGORY];
+
+    /// true if maxLevel_ has been filled
+    static bool set_;
+
+    /// events buffer
+    static std::vector <Event> events_;
+
+    /// size of the buffer (0 if not open)
+    static int capacity_;
+
+    /// number of events recorded so far (the last capacity_ are kept)
+    static long int nEvents_;
+
+    /// time at which the buffer was opened
+    static double startTime_;
+
+    /// output file
+    static std::string file_;
+  };
+}
+
+#endif
@@ -64,7 +64,10 @@ bool CouenneProblem::checkNLP (const double *solution, double &obj, bool recompu
 
   // copy solution, evaluate the corresponding aux, and then replace
   // the original variables again for checking
-  CouNumber *sol = new CouNumber [nVars ()];
+  if ((int) checkSol_.size () < nVars ())
+    checkSol_.resize (nVars ());
+
+  CouNumber *sol = &(checkSol_ [0]);
   CoinZeroN (sol     + nOrigVars_ - ndefined_, nVars() - (nOrigVars_ - ndefined_));
   CoinCopyN (solution, nOrigVars_ - ndefined_, sol);
   getAuxs (sol);
@@ -154,6 +157,33 @@ bool CouenneProblem::checkNLP (const double *solution, double &obj, bool recompu
       }
     }
 
+    // check constraints first: cheaper than auxiliaries, and more
+    // often violated
+
+    for (int i=0; i < nCons (); i++) {
+
+      CouenneConstraint *c = Con (i);
+
+      CouNumber
+	body = (*(c -> Body ())) (),
+	lhs  = (*(c -> Lb   ())) (),
+	rhs  = (*(c -> Ub   ())) ();
+
+      if (((rhs <  COUENNE_INFINITY) && (body > rhs + feas_tolerance_ * (1. + CoinMax (fabs (body), fabs (rhs))))) || 
+	  ((lhs > -COUENNE_INFINITY) && (body < lhs - feas_tolerance_ * (1. + CoinMax (fabs (body), fabs (lhs)))))) {
+
+	if (Jnlst () -> ProduceOutput (Ipopt::J_MOREVECTOR, J_PROBLEM)) {
+
+	  printf ("  checkNLP: constraint %d violated (lhs=%+e body=%+e rhs=%+e, violation %g): ",
+		  i, lhs, body, rhs, CoinMax (lhs-body, body-rhs));
+
+	  c -> print ();
+	}
+
+	throw infeasible;
+      }
+    }
+
     // check ALL auxs
 
     for (int i=0; i < nVars (); i++) {
@@ -224,32 +254,6 @@ bool CouenneProblem::checkNLP (const double *solution, double &obj, bool recompu
 	throw infeasible;
       }
     }
-
-    // check constraints
-
-    for (int i=0; i < nCons (); i++) {
-
-      CouenneConstraint *c = Con (i);
-
-      CouNumber
-	body = (*(c -> Body ())) (),
-	lhs  = (*(c -> Lb   ())) (),
-	rhs  = (*(c -> Ub   ())) ();
-
-      if (((rhs <  COUENNE_INFINITY) && (body > rhs + feas_tolerance_ * (1. + CoinMax (fabs (body), fabs (rhs))))) || 
-	  ((lhs > -COUENNE_INFINITY) && (body < lhs - feas_tolerance_ * (1. + CoinMax (fabs (body), fabs (lhs)))))) {
-
-	if (Jnlst () -> ProduceOutput (Ipopt::J_MOREVECTOR, J_PROBLEM)) {
-
-	  printf ("  checkNLP: constraint %d violated (lhs=%+e body=%+e rhs=%+e, violation %g): ",
-		  i, lhs, body, rhs, CoinMax (lhs-body, body-rhs));
-
-	  c -> print ();
-	}
-
-	throw infeasible;
-      }
-    }
   }
 
   catch (int exception) {
@@ -267,7 +271,6 @@ bool CouenneProblem::checkNLP (const double *solution, double &obj, bool recompu
     }
   }
 
-  delete [] sol;
   domain_.pop ();
 
   Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "Done: %d\n", retval);
@@ -312,7 +315,7 @@ double CouenneProblem::checkObj(const CouNumber *sol, const double &precision)
 // original integer vars are within precision of an integer value
 bool CouenneProblem::checkInt(const CouNumber *sol,
 			      const int from, const int upto, 
-			      const std::vector<int> listInt,
+			      const std::vector<int> &listInt,
 			      const bool origVarOnly,  
 			      const bool stopAtFirstViol,  
 			      const double precision, double &maxViol) const {
@@ -579,7 +582,7 @@ bool CouenneProblem::checkNLP2(const double *solution,
     exit(1);
   }
 
-  const std::vector<int> listInt = getRecordBestSol()->getListInt();
+  const std::vector<int> &listInt = getRecordBestSol()->getListInt();
   bool isFeas = false;
   double maxViolCouSol = 0;
   double maxViolRecSol = 0;
@@ -670,7 +673,12 @@ bool CouenneProblem::checkNLP2(const double *solution,
   domain_.push(nVars(), solution, getRecordBestSol()->getInitDomLb(), 
 	       getRecordBestSol()->getInitDomUb(), false);
 
-  CouNumber *couRecSol = new CouNumber[nVars()];
+  if ((int) checkRecSol_.size () < nVars ()) {
+    checkRecSol_.resize (nVars ());
+    checkSol_   .resize (nVars ());
+  }
+
+  CouNumber *couRecSol = &(checkRecSol_ [0]);
   CoinCopyN (solution, nOrigVars_ - ndefined_, couRecSol);
   getAuxs(couRecSol);
   //CoinCopyN (solution, nOrigVars_, couRecSol);
@@ -735,20 +743,11 @@ bool CouenneProblem::checkNLP2(const double *solution,
 	isFeasRec = false;
       }
     }
-
-    if(!stopAtFirstViol || isFeasRec) {
-      bool isFeasAux = checkAux(couRecSol, stopAtFirstViol, 
-				precision, maxViolRecSol);
-
-      if(!isFeasAux) {
-	
-	Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): recomputed_solution is infeasible (violated Aux; violation: %12.10g)\n", maxViolRecSol);
-	
-	isFeasRec = false;
-      }
-    }
   }
 
+  // check constraints before auxiliaries: they are cheaper and more
+  // often violated, so that stopAtFirstViol exits earlier
+
   if(!stopAtFirstViol || isFeasRec) {
     bool isFeasCons = checkCons(couRecSol, stopAtFirstViol, 
 				precision, maxViolRecSol);
@@ -761,13 +760,27 @@ bool CouenneProblem::checkNLP2(const double *solution,
     }
   }
 
+  if(checkAll) {
+    if(!stopAtFirstViol || isFeasRec) {
+      bool isFeasAux = checkAux(couRecSol, stopAtFirstViol, 
+				precision, maxViolRecSol);
+
+      if(!isFeasAux) {
+	
+	Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): recomputed_solution is infeasible (violated Aux; violation: %12.10g)\n", maxViolRecSol);
+	
+	isFeasRec = false;
+      }
+    }
+  }
+
   Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): end check recomputed_solution (maxViol: %12.10g)\n", maxViolRecSol);
 
   double objErrorRecSol = objRecSol - obj;
   if(!careAboutObj)
     objErrorRecSol = 0;
 
-  CouNumber *couSol = new CouNumber[nVars()];
+  CouNumber *couSol = &(checkSol_ [0]);
   bool useRecSol = false;
   if(isFeasRec && (objErrorRecSol < precision)) {
     useRecSol = true;
@@ -822,22 +835,22 @@ bool CouenneProblem::checkNLP2(const double *solution,
       }
       
       if(!stopAtFirstViol || isFeasCou) {
-	bool isFeasCouAux = checkAux(couSol, stopAtFirstViol, 
-				     precision, maxViolCouSol);
-	if(!isFeasCouAux) {
+	bool isFeasCouCons = checkCons(couSol, stopAtFirstViol, 
+				       precision, maxViolCouSol);
+	if(!isFeasCouCons) {
 	  
-	  Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): solution is infeasible (violated Aux; violation: %12.10g)\n", maxViolCouSol);
+	  Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): solution is infeasible (violated constraint; violation: %12.10g)\n", maxViolCouSol);
 	  
 	  isFeasCou = false;
 	}
       }
       
       if(!stopAtFirstViol || isFeasCou) {
-	bool isFeasCouCons = checkCons(couSol, stopAtFirstViol, 
-				       precision, maxViolCouSol);
-	if(!isFeasCouCons) {
+	bool isFeasCouAux = checkAux(couSol, stopAtFirstViol, 
+				     precision, maxViolCouSol);
+	if(!isFeasCouAux) {
 	  
-	  Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): solution is infeasible (violated constraint; violation: %12.10g)\n", maxViolCouSol);
+	  Jnlst () -> Printf (Ipopt::J_ALL, J_PROBLEM, "CouenneProblem::checkNLP2(): solution is infeasible (violated Aux; violation: %12.10g)\n", maxViolCouSol);
 	  
 	  isFeasCou = false;
 	}
@@ -947,9 +960,6 @@ bool CouenneProblem::checkNLP2(const double *solution,
     }
   }
 
-  delete[] couSol;
-  delete[] couRecSol;
-
   domain_.pop (); // pop bounds
     
   return isFeas;
@@ -986,3 +996,48 @@ bool CouenneProblem::checkNLP0 (const double *solution,
 
   return retval;
 }
+
+
+/* *********************************************************************/
+// check a set of candidate solutions, reusing the same workspaces for
+// all of them, and return the index of the best feasible one
+int CouenneProblem::checkNLPBatch (int nSols,
+				   const double * const *solutions,
+				   double *obj,
+				   bool *feasible,
+				   const bool checkAll,
+				   const double precision) const {
+  int best = -1;
+
+  double
+    bestObj  = COIN_DBL_MAX,
+    bestViol = 0.;
+
+  for (int i=0; i<nSols; i++) {
+
+    bool isFeas = checkNLP0 (solutions [i], obj [i], true, false, true, checkAll, precision);
+
+    if (feasible)
+      feasible [i] = isFeas;
+
+    if (!isFeas || (obj [i] >= bestObj))
+      continue;
+
+    // the modified solution is overwritten by the next check, save it
+
+    best     = i;
+    bestObj  = obj [i];
+    bestViol = recBSol -> getModSolMaxViol ();
+
+    if ((int) checkBest_.size () < nVars ())
+      checkBest_.resize (nVars ());
+
+    CoinCopyN (recBSol -> getModSol (nVars ()), nVars (), &(checkBest_ [0]));
+  }
+
+  if ((best >= 0) &&
+      (best < nSols - 1)) // otherwise modSol is still that of best
+    recBSol -> setModSol (&(checkBest_ [0]), nVars (), bestObj, bestViol);
+
+  return best;
+}
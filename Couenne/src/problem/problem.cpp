@@ -456,6 +456,16 @@ void CouenneProblem::registerOptions (Ipopt::SmartPtr <Bonmin::RegisteredOptions
      "Envelopes for these expressions are generated through alpha-convexification."
     );
 
+  roptions -> AddStringOption2 
+    ("use_norm",
+     "Use Euclidean norm expressions and related exprNorm class",
+     "no",
+     "no","Reformulate square roots of sums of squares with an auxiliary for each square, one for the sum, and one for the root",
+     "yes","Create only one auxiliary for the square root of a sum of squares",
+     "If enabled, expressions of the form sqrt(f_1(x)^2 + ... + f_n(x)^2) are not decomposed but taken as a Euclidean norm, "
+     "whose convex side is approximated by tangents to the second-order cone."
+    );
+
   roptions -> AddStringOption2 
     ("optimality_bt",
      "Optimality-based (expensive) bound tightening (OBBT)",
@@ -481,6 +491,13 @@ If k>=0, apply with probability 2^(k - level), level being the current depth of
      -1, MAX_FBBT_ITER,
      "Set to -1 to impose no upper limit");
 
+  roptions -> AddLowerBoundedIntegerOption
+    ("nlp_memo_size",
+     "Maximum number of NLP outcomes (with fixed integer variables) stored for use by all heuristics.",
+     0, 1000,
+     "Heuristics that solve an NLP with all integer variables fixed look up this table first, "
+     "and skip the NLP if the same integer assignment has already been tried. Set to 0 to disable.");
+
   roptions -> AddStringOption2 
     ("aggressive_fbbt",
      "Aggressive feasibility-based bound tightening (to use with NLP points)",
@@ -501,6 +518,23 @@ If -1, apply at every node (expensive!). \
 If 0, apply at root node only. \
 If k>=0, apply with probability 2^(k - level), level being the current depth of the B&B tree.");
 
+  roptions -> AddStringOption2
+    ("adaptive_bt",
+     "Decide where to run expensive bound tightening by its measured performance",
+     "no",
+     "no","use the static rules (log_num_obbt_per_level, twoimpl_depth_level, etc.)",
+     "yes","run more or less often depending on the bounds tightened per second",
+     "Applies to OBBT, aggressive FBBT, fixed point, and two-implied bound tightening. "
+     "At the root node, each procedure runs as set by its own options, and the bound improvement per second is recorded. "
+     "In the tree, the static depth rules are ignored and each procedure runs at a rate given by "
+     "its recent improvement per second relative to that of the root node, between adaptive_bt_min_rate and 1.");
+
+  roptions -> AddBoundedNumberOption
+    ("adaptive_bt_min_rate",
+     "Minimum fraction of the nodes where a bound tightener is run with adaptive_bt",
+     0., false, 1., false, 0.05,
+     "Keeps measuring procedures that are not useful for a while, so that they can be run more often when they are.");
+
   roptions -> AddNumberOption
     ("art_lower",
      "Artificial lower bound",
@@ -522,12 +556,14 @@ If k>=0, apply with probability 2^(k - level), level being the current depth of
      "no","Keep redundant variables, making the problem a bit larger",
      "yes","Eliminate redundant variables (the problem will be equivalent, only smaller)");
 
-  roptions -> AddStringOption4
+  roptions -> AddStringOption5
     ("quadrilinear_decomp",
      "type of decomposition for quadrilinear terms (see work by Cafieri, Lee, Liberti)",
      "rAI",
      "rAI",     "Recursive decomposition in bilinear terms (as in Ryoo and Sahinidis): x5 = ((x1 x2) x3) x4)",
      "tri+bi",  "Trilinear and bilinear term: x5 = (x1 (x2 x3 x4))",
      "bi+tri",  "Bilinear, THEN trilinear term: x5 = ((x1 x2) x3 x4))",
-     "hier-bi", "Hierarchical decomposition: x5 = ((x1 x2) (x3 x4))");
+     "hier-bi", "Hierarchical decomposition: x5 = ((x1 x2) (x3 x4))",
+     "multilin", "Single multilinear term x5 = x1 x2 x3 x4, convexified through the facets of its envelopes "
+     "(products of more than 8 factors are split into multilinear terms of at most 8)");
 }
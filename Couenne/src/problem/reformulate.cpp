@@ -221,7 +221,7 @@ void CouenneProblem::reformulate (CouenneCutGenerator *cg) {
   else if (nVars () > 2*THRESHOLD_OUTPUT_REFORMULATE) 
     jnlst_ -> Printf (Ipopt::J_ERROR, J_COUENNE, "Reformulation: %.1f seconds\n", CoinCpuTime () - now); 
 
-  if (orbitalBranching_)
+  if (orbitalBranching_ || orbitalFixing_)
     setupSymmetry ();
 
   //writeAMPL ("extended-aw.mod", true);
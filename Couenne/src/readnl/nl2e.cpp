@@ -24,6 +24,7 @@
 #include "CouenneExprOpp.hpp"
 #include "CouenneExprCos.hpp"
 #include "CouenneExprExp.hpp"
+#include "CouenneExprPWLinear.hpp"
 
 #include "asl.h"
 #include "nlp.h"
@@ -117,7 +118,50 @@ expression *CouenneProblem::nl2e (expr *e, const ASL *asl) {
   case OPCPOW: return new exprPow (new exprConst (((expr_n *)e->L.e)->v),  nl2e (e -> R.e, asl));
   case OPFUNCALL: notimpl ("function call");
   case OPNUM:     return new exprConst (((expr_n *)e)->v);
-  case OPPLTERM:  notimpl ("plterm");
+  case OPPLTERM: { // <<b_1,...,b_{n-1}; s_1,...,s_n>> x, which is zero at x=0
+
+    plterm *p = e -> L.p;
+
+    int n = p -> n; // number of slopes
+
+    real *bs = p -> bs; // s_1, b_1, s_2, b_2, ..., s_n
+
+    if (n == 1)
+      return new exprMul (new exprConst (bs [0]), nl2e (e -> R.e, asl));
+
+    CouNumber
+      *x = new CouNumber [n-1],
+      *y = new CouNumber [n-1];
+
+    // ordinates with y_1 = 0, then shift them so that f(0) = 0
+
+    x [0] = bs [1];
+    y [0] = 0.;
+
+    for (int i=1; i<n-1; i++) {
+      x [i] = bs [2*i+1];
+      y [i] = y [i-1] + bs [2*i] * (x [i] - x [i-1]);
+    }
+
+    CouNumber f0;
+
+    if (x [0] >= 0.) f0 = - bs [0] * x [0];
+    else {
+      int i = 0;
+      while ((i < n-2) && (x [i+1] <= 0.)) i++;
+      f0 = y [i] - bs [2*i+2] * x [i];
+    }
+
+    for (int i=0; i<n-1; i++)
+      y [i] -= f0;
+
+    expression *ret = new exprPWLinear (nl2e (e -> R.e, asl), n-1, x, y, bs [0], bs [2*n-2]);
+
+    delete [] x;
+    delete [] y;
+
+    return ret;
+  }
   case OPIFSYM:   notimpl ("ifsym");
   case OPHOL:     notimpl ("hol");
   case OPVARVAL:  {